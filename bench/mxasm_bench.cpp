@@ -0,0 +1,302 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |           Benchmarks          |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+#include "../include/assembler.hpp"
+#include "../include/source_file.hpp"
+#include "../include/lexer.hpp"
+#include "../include/parser.hpp"
+#include "../include/serializer.hpp"
+#include "program_generator.hpp"
+
+#ifndef MXASM_SAMPLES_DIR
+#define MXASM_SAMPLES_DIR "cmake-build-debug"
+#endif
+
+// mxasm_bench [--samples_dir=DIR] [--max_lines=N] [--labels=%] [--defines=%] [--bytes=%]
+//             [--branches=%] [--seed=N] [--save_baseline=FILE] [--baseline=FILE]
+//             [--tolerance=%] [benchmark flags]...
+//
+// Every stage runs on the bundled samples and on generated programs of 10^3 lines
+// up to --max_lines (10^6 by default, memory grows to a few GiB at 10^7).
+// --save_baseline keeps the time of every benchmark, --baseline compares against
+// such a file and fails when one got slower by more than --tolerance percent
+
+using namespace mxasm;
+
+
+namespace
+{
+    struct bench_input
+    {
+        std::string name;
+        std::string text;
+        std::size_t lines;
+    };
+
+    struct bench_config
+    {
+        std::string        samples_dir   {MXASM_SAMPLES_DIR};
+        std::size_t        max_lines     {1'000'000};
+        bench::program_mix mix           {};
+        std::string        save_baseline {};
+        std::string        baseline      {};
+        double             tolerance     {5.0};
+    };
+
+
+    void set_throughput(benchmark::State &state, const bench_input &input)
+    {
+        const auto iterations = static_cast<double>(state.iterations());
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(input.text.size()));
+        state.counters["lines/s"] = benchmark::Counter(iterations * static_cast<double>(input.lines),
+                                                       benchmark::Counter::kIsRate);
+    }
+
+    void bm_source_file(benchmark::State &state, const bench_input *input)
+    {
+        for (auto _ : state) {
+            auto source = source_file::from_text(input->text);
+            benchmark::DoNotOptimize(source.lines().data());
+        }
+        set_throughput(state, *input);
+    }
+
+    void bm_lexer(benchmark::State &state, const bench_input *input)
+    {
+        const auto source = source_file::from_text(input->text);
+        for (auto _ : state) {
+            lexer tokenizer(source.lines());
+            benchmark::DoNotOptimize(tokenizer.tokens().data());
+        }
+        set_throughput(state, *input);
+    }
+
+    void bm_parser(benchmark::State &state, const bench_input *input)
+    {
+        const auto source = source_file::from_text(input->text);
+        lexer tokenizer(source.lines());
+        const auto &lexed_tokens = tokenizer.tokens();
+        for (auto _ : state) {
+            parser lex_parser(lexed_tokens);
+            benchmark::DoNotOptimize(lex_parser.tokens().data());
+        }
+        set_throughput(state, *input);
+    }
+
+    void bm_serializer(benchmark::State &state, const bench_input *input)
+    {
+        const auto source = source_file::from_text(input->text);
+        lexer tokenizer(source.lines());
+        parser lex_parser(tokenizer.tokens());
+        const auto &parsed_tokens = lex_parser.tokens();
+        for (auto _ : state) {
+            serializer encoder(parsed_tokens);
+            auto program = encoder.binary_program();
+            benchmark::DoNotOptimize(program);
+        }
+        set_throughput(state, *input);
+    }
+
+    void bm_pipeline(benchmark::State &state, const bench_input *input)
+    {
+        for (auto _ : state) {
+            auto result = assemble(input->text);
+            benchmark::DoNotOptimize(result);
+        }
+        set_throughput(state, *input);
+    }
+
+
+    // Console output as usual, and the time of every run for the baseline
+    class baseline_reporter : public benchmark::ConsoleReporter
+    {
+    public:
+        baseline_reporter()
+            : ConsoleReporter(isatty(STDOUT_FILENO) ? OO_Defaults : OO_Tabular) {}
+
+        void ReportRuns(const std::vector<Run> &runs) override
+        {
+            ConsoleReporter::ReportRuns(runs);
+            for (const auto &run : runs) {
+                if (run.run_type != Run::RT_Iteration or run.iterations == 0) continue;
+                m_times[run.benchmark_name()] = run.GetAdjustedRealTime();
+            }
+        }
+
+        const std::map<std::string, double> &times() const noexcept
+        { return m_times; }
+
+    private:
+        std::map<std::string, double> m_times;     // Microseconds per iteration
+    };
+
+    // Baseline files hold a "<name>\t<microseconds>" line per benchmark
+    std::map<std::string, double> read_baseline(const std::string &path)
+    {
+        std::ifstream file(path);
+        if (not file.is_open()) {
+            throw std::runtime_error("Can't open baseline file '" + path + "'");
+        }
+        std::map<std::string, double> times;
+        std::string line;
+        while (std::getline(file, line)) {
+            const auto tab = line.rfind('\t');
+            if (tab == std::string::npos) continue;
+            times[line.substr(0, tab)] = std::stod(line.substr(tab + 1));
+        }
+        return times;
+    }
+
+    void save_baseline(const std::string &path, const std::map<std::string, double> &times)
+    {
+        std::ofstream file(path, std::ios_base::trunc);
+        file << std::setprecision(17);
+        for (const auto &[name, time] : times) {
+            file << name << '\t' << time << '\n';
+        }
+        if (not file) {
+            throw std::runtime_error("Can't write baseline file '" + path + "'");
+        }
+    }
+
+    // True when nothing got slower than the tolerance allows
+    bool compare_with_baseline(const std::map<std::string, double> &baseline,
+                               const std::map<std::string, double> &times, const double tolerance)
+    {
+        bool passed = true;
+        std::cout << '\n' << std::left << std::setw(48) << "benchmark" << std::right
+                  << std::setw(14) << "baseline us" << std::setw(14) << "current us" << std::setw(10) << "change" << '\n';
+        for (const auto &[name, time] : times) {
+            const auto found = baseline.find(name);
+            if (found == baseline.end() or found->second <= 0) continue;
+
+            const double change = (time - found->second) / found->second * 100.0;
+            const bool regressed = change > tolerance;
+            passed = passed and not regressed;
+            std::cout << std::left << std::setw(48) << name << std::right << std::fixed << std::setprecision(2)
+                      << std::setw(14) << found->second << std::setw(14) << time
+                      << std::setw(9) << std::showpos << change << std::noshowpos << '%'
+                      << (regressed ? "  REGRESSION" : "") << '\n';
+        }
+        return passed;
+    }
+
+
+    // Takes the flags of this program out of argv, the rest go to the benchmark library
+    bench_config parse_config(int &argc, char **argv)
+    {
+        bench_config config;
+        int kept = 1;
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg(argv[i]);
+            const auto value = [&](const std::string_view flag) { return arg.substr(flag.length()); };
+
+            if      (arg.starts_with("--samples_dir="))   config.samples_dir   = value("--samples_dir=");
+            else if (arg.starts_with("--max_lines="))     config.max_lines     = std::stoull(value("--max_lines="));
+            else if (arg.starts_with("--labels="))        config.mix.labels    = std::stoul(value("--labels="));
+            else if (arg.starts_with("--defines="))       config.mix.defines   = std::stoul(value("--defines="));
+            else if (arg.starts_with("--bytes="))         config.mix.bytes     = std::stoul(value("--bytes="));
+            else if (arg.starts_with("--branches="))      config.mix.branches  = std::stoul(value("--branches="));
+            else if (arg.starts_with("--seed="))          config.mix.seed      = std::stoul(value("--seed="));
+            else if (arg.starts_with("--save_baseline=")) config.save_baseline = value("--save_baseline=");
+            else if (arg.starts_with("--baseline="))      config.baseline      = value("--baseline=");
+            else if (arg.starts_with("--tolerance="))     config.tolerance     = std::stod(value("--tolerance="));
+            else argv[kept++] = argv[i];
+        }
+        argc = kept;
+        return config;
+    }
+
+    std::deque<bench_input> load_inputs(const bench_config &config)
+    {
+        std::deque<bench_input> inputs;
+        for (const char *sample : {"s_snake", "s_adventure", "s_sft"}) {
+            const std::string path = config.samples_dir + "/" + sample + ".asm";
+            std::ifstream file(path, std::ios_base::binary);
+            if (not file.is_open()) {
+                std::cerr << "Skipping missing sample '" << path << "'\n";
+                continue;
+            }
+            std::ostringstream text;
+            text << file.rdbuf();
+            inputs.push_back({sample, text.str(), 0});
+        }
+        for (std::size_t lines = 1000; lines <= config.max_lines; lines *= 10) {
+            inputs.push_back({"lines:" + std::to_string(lines), bench::generate_program(lines, config.mix), 0});
+        }
+
+        for (auto &input : inputs) {
+            input.lines = std::count(input.text.begin(), input.text.end(), '\n');
+        }
+        return inputs;
+    }
+}
+
+
+int main(int argc, char **argv)
+{
+    bench_config config;
+    try {
+        config = parse_config(argc, argv);
+    } catch (const std::exception &ex) {
+        std::cerr << "Wrong benchmark option: " << ex.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return EXIT_FAILURE;
+
+    const auto inputs = load_inputs(config);
+    for (const auto &input : inputs) {
+        // Inputs that don't assemble would only measure the error path
+        const auto check = assemble(input.text);
+        if (check.exit_code != EXIT_SUCCESS) {
+            std::cerr << "Skipping '" << input.name << "':\n" << check.report();
+            continue;
+        }
+
+        // Every time in microseconds, which is also the unit of baseline files
+        benchmark::RegisterBenchmark(("source_file/" + input.name).c_str(), bm_source_file, &input)->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark(("lexer/"       + input.name).c_str(), bm_lexer,       &input)->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark(("parser/"      + input.name).c_str(), bm_parser,      &input)->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark(("serializer/"  + input.name).c_str(), bm_serializer,  &input)->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark(("pipeline/"    + input.name).c_str(), bm_pipeline,    &input)->Unit(benchmark::kMicrosecond);
+    }
+
+    baseline_reporter reporter;
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+    benchmark::Shutdown();
+
+    try {
+        if (not config.save_baseline.empty()) {
+            save_baseline(config.save_baseline, reporter.times());
+        }
+        if (not config.baseline.empty()
+            and not compare_with_baseline(read_baseline(config.baseline), reporter.times(), config.tolerance)) {
+            return EXIT_FAILURE;
+        }
+    } catch (const std::exception &ex) {
+        std::cerr << ex.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,86 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |       Program Generator       |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <array>
+#include <random>
+#include <string_view>
+
+#include "program_generator.hpp"
+
+using namespace mxasm::bench;
+
+
+namespace
+{
+    constexpr std::size_t MAX_LABELS       = 50000;
+    constexpr std::size_t MAX_DEFINES      = 10000;
+    constexpr std::size_t LINES_PER_ORIGIN = 4096;     // Keeps the code of every block inside 64 KiB
+
+    constexpr std::array<std::string_view, 8> INSTRUCTIONS {
+        "  LDA #$12", "  LDX $1234,Y", "  ASL A", "  NOP", "  INC", "  STA $0200,X", "  TAX", "  CMP #$71"
+    };
+    constexpr std::array<std::string_view, 4> BRANCHES {"BNE", "BEQ", "BCC", "BPL"};
+
+    std::string hex_byte(const unsigned value)
+    {
+        static constexpr char digits[] = "0123456789abcdef";
+        return {'$', digits[(value >> 4) & 0xF], digits[value & 0xF]};
+    }
+}
+
+
+std::string             mxasm::bench::
+generate_program(const std::size_t line_count, const program_mix &mix)
+{
+    std::mt19937 random(mix.seed);
+    std::uniform_int_distribution<unsigned> percent(0, 99);
+    std::uniform_int_distribution<unsigned> byte(0, 255);
+
+    std::string program;
+    program.reserve(line_count * 14);
+
+    std::size_t labels  = 0;
+    std::size_t defines = 0;
+    for (std::size_t line = 0; line < line_count; ++line) {
+        if (line % LINES_PER_ORIGIN == 0) {
+            program += "*= $0600\n";
+            continue;
+        }
+
+        unsigned roll = percent(random);
+        if (roll < mix.labels and labels < MAX_LABELS) {
+            program += 'l' + std::to_string(labels++) + ":\n";
+            continue;
+        }
+        roll -= std::min(roll, mix.labels);
+        if (roll < mix.defines and defines < MAX_DEFINES) {
+            program += ".define c" + std::to_string(defines++) + ' ' + hex_byte(byte(random)) + '\n';
+            continue;
+        }
+        roll -= std::min(roll, mix.defines);
+        if (roll < mix.bytes) {
+            program += ".byte \"text\", " + hex_byte(byte(random)) + ", " + std::to_string(byte(random)) + '\n';
+            continue;
+        }
+        roll -= std::min(roll, mix.bytes);
+        if (roll < mix.branches and labels > 0) {
+            // Back to the latest label, which is usually in range
+            program += "  ";
+            program += BRANCHES[byte(random) % BRANCHES.size()];
+            program += " l" + std::to_string(labels - 1) + '\n';
+            continue;
+        }
+
+        if (defines > 0 and byte(random) < 64) {
+            program += "  LDA (c" + std::to_string(byte(random) % defines) + "),Y\n";
+        } else {
+            program += INSTRUCTIONS[byte(random) % INSTRUCTIONS.size()];
+            program += '\n';
+        }
+    }
+    return program;
+}
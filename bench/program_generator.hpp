@@ -0,0 +1,29 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |       Program Generator       |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+
+namespace mxasm::bench
+{
+    // Share of lines of every kind, in percent. The rest are plain instructions
+    struct program_mix
+    {
+        unsigned      labels   {10};
+        unsigned      defines  {2};
+        unsigned      bytes    {8};
+        unsigned      branches {15};
+        std::uint32_t seed     {1};
+    };
+
+    // Valid program of exactly line_count lines. Symbol ids are 16-bit, so label and
+    // .define declarations stop at a fixed count and longer programs reuse them
+    std::string generate_program(std::size_t line_count, const program_mix &mix);
+}
@@ -0,0 +1,81 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |           Assembler           |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "memory_image.hpp"
+#include "program_writer.hpp"
+#include "source_file.hpp"
+#include "stats.hpp"
+#include "diagnostic.hpp"
+#include "serializer.hpp"
+#include "source_map.hpp"
+
+
+namespace mxasm
+{
+    class assembly_cache;
+
+    // What the pipeline makes of a source: bumped with every change of the encoder, the relaxer
+    // or the instruction table, so that no cache serves bytes of an older build of the same version
+    constexpr std::uint32_t PIPELINE_REVISION = 6;
+
+    // Settings that change the result of the pipeline itself
+    struct pipeline_options
+    {
+        std::size_t      max_errors      {0};    // No limit when 0
+        std::string      asset_directory {};     // Base of relative .incbin paths, no .incbin at all when empty
+        encoding_options encoding        {};
+    };
+
+    // Outcome of one source file
+    struct assembly_result
+    {
+        int                      exit_code   {EXIT_SUCCESS};
+        diagnostic_list          diagnostics {};
+        memory_image             image       {};
+        std::vector<std::string> assets      {};    // Files included with .incbin, not part of the encoding
+
+        // Everything meant for stderr, empty on success
+        std::string report() const;
+        // The source text and the options alone decide the result: no assets, and no failure
+        // from outside the assembler, like a read error or bad_alloc. Only such results are cached
+        bool        is_reproducible() const noexcept;
+    };
+
+    // Entry point of libmxasm: the source text is assembled in memory. The filesystem is only
+    // touched for .incbin, which is an error unless the pipeline has an asset directory.
+    // The text is only read during the call
+    assembly_result assemble(std::string_view source, const pipeline_options &pipeline = {},
+                             assembly_stats *stats = nullptr);
+
+    // All of these run the whole pipeline on their own lexer, parser and serializer, and never throw
+    // Phases are timed into the stats, when there are any
+    assembly_result assemble_source(const source_file &source, const pipeline_options &pipeline,
+                                    assembly_stats *stats = nullptr, source_map *map = nullptr);
+    assembly_result assemble_file(const std::string &source_path, const pipeline_options &pipeline,
+                                  const write_options &output, assembly_cache *cache = nullptr,
+                                  assembly_stats *stats = nullptr);
+
+    // Leaves the binary in the result instead of writing it next to the source.
+    // The map, when there is one, tells where every byte comes from
+    assembly_result assemble_file(const std::string &source_path, const pipeline_options &pipeline,
+                                  assembly_stats *stats = nullptr, source_map *map = nullptr);
+
+    // Byte form shared by the server protocol and the disk cache:
+    // u8 exit code, u32 segment count, then u16 address + u32 size + bytes
+    // for every segment, u32 diagnostic count, then u8 code, u32 row,
+    // u32 column and u32 size + argument for every diagnostic
+    std::string                    encode_result(const assembly_result &result);
+    std::optional<assembly_result> decode_result(std::string_view encoded);
+}
@@ -0,0 +1,66 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |         Assembly Cache        |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "assembler.hpp"
+
+
+namespace mxasm
+{
+    // Results on disk, one <key>.mxc file each. The key is the XXH64 of the source,
+    // seeded with the hash of everything else that changes the binary. An entry keeps the
+    // length and a second hash of its source, so that a colliding key is a miss.
+    // Entries are safe to share between processes, as every write lands by a rename
+    class assembly_cache
+    {
+    public:
+        struct statistics
+        {
+            std::size_t   hits      {0};
+            std::size_t   misses    {0};
+            std::size_t   evictions {0};
+            std::size_t   entries   {0};    // Both counted by the last trim()
+            std::uint64_t bytes     {0};
+        };
+
+        // Throws if the directory can't be created
+        assembly_cache(std::filesystem::path directory, std::uint64_t max_size, std::string_view fingerprint);
+
+        std::uint64_t                  key(std::string_view source) const noexcept;
+        std::optional<assembly_result> find(std::uint64_t key, std::string_view source);
+        // Results that aren't reproducible from the source are not stored
+        void                           store(std::uint64_t key, std::string_view source, const assembly_result &result);
+
+        // Removes the least recently used entries until the cache fits in its size
+        void       trim();
+        statistics stats() const noexcept;
+
+    private:
+        std::filesystem::path      m_directory;
+        std::uint64_t              m_max_size;
+        std::uint64_t              m_seed;
+        std::atomic<std::size_t>   m_hits      {0};
+        std::atomic<std::size_t>   m_misses    {0};
+        std::size_t                m_evictions {0};
+        std::size_t                m_entries   {0};
+        std::uint64_t              m_bytes     {0};
+
+        std::filesystem::path entry_path(std::uint64_t key) const;
+        std::uint64_t         check_hash(std::string_view source) const noexcept;
+    };
+
+    // $XDG_CACHE_HOME/mxasm, or $HOME/.cache/mxasm
+    std::string default_cache_directory();
+}
@@ -0,0 +1,75 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |           Diagnostic          |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace mxasm
+{
+    enum class diagnostic_code : uint8_t
+    {
+        // From outside the assembler, the argument is the whole message
+        ARGUMENTS_ERROR, SYSTEM_ERROR, TOO_MANY_ERRORS,
+
+        LEXER_UNEXPECTED_TOKEN,
+
+        UNEXPECTED_TOKEN, UNKNOWN_DIRECTIVE, UNKNOWN_COMMAND_START, LINE_START_EXPECTED,
+        COMMAND_END_EXPECTED, LINE_END_EXPECTED, REGISTER_AFTER_COMMAND,
+        IDENTIFIER_MISSING, IDENTIFIER_EXPECTED, NUMBER_MISSING, NUMBER_EXPECTED,
+        EQUALS_MISSING, EQUALS_EXPECTED, DATA_MISSING, DATA_EXPECTED, COMMA_EXPECTED,
+        NEW_LINE_EXPECTED, CONSTANT_TOO_BIG, NUMBER_TOO_BIG, BYTE_TOO_BIG, WORD_TOO_BIG,
+        REPEATED_MACRO, REPEATED_LABEL, UNDECLARED_LABEL, UNAVAILABLE_ADDRESSING_MODE,
+        FILE_NAME_MISSING, FILE_NAME_EXPECTED, FILE_UNREADABLE, FILE_RANGE_INVALID, FILE_TOO_BIG,
+        FILE_NOT_ALLOWED,
+
+        ZERO_PAGE_EXPECTED, BRANCH_OUT_OF_REACH
+    };
+
+    // Compact error record, the text is only built when it is printed. The argument is
+    // a lexeme, a token kind or a message, depending on the code, kept in the text of its list
+    struct diagnostic
+    {
+        diagnostic_code code            {diagnostic_code::SYSTEM_ERROR};
+        uint32_t        row             {0};
+        uint32_t        column          {0};
+        uint32_t        argument_offset {0};
+        uint32_t        argument_size   {0};
+
+        std::string type() const;       // Empty for errors from outside the assembler
+    };
+
+    // Records with the arguments of all of them in one string, so that an error costs no allocation of its own
+    class diagnostic_list
+    {
+    public:
+        typedef std::vector<diagnostic>::const_iterator const_iterator;
+
+        diagnostic_list() = default;
+        // A single error from outside the assembler
+        diagnostic_list(diagnostic_code code, std::string_view message);
+
+        void add(diagnostic_code code, uint32_t row, uint32_t column, std::string_view argument = {});
+        void clear() noexcept;
+
+        std::string_view argument(const diagnostic &error) const noexcept;
+        std::string      message(const diagnostic &error) const;
+
+        std::size_t      size() const noexcept;
+        bool             empty() const noexcept;
+        const_iterator   begin() const noexcept;
+        const_iterator   end() const noexcept;
+
+    private:
+        std::vector<diagnostic> m_records;
+        std::string             m_arguments;
+    };
+}
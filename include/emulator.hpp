@@ -0,0 +1,105 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |            Emulator           |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include "memory_image.hpp"
+#include "instruction_set.hpp"
+
+
+namespace mxasm
+{
+    // W65C02S core with the memory map of the 6502 tutorial simulators: programs load at $0600,
+    // $FE reads a new random byte every time, $FF holds the code of the last key pressed
+    // and $0200-$05FF is a 32x32 screen of one colour byte per pixel
+    class emulator
+    {
+    public:
+        static constexpr word_t      LOAD_ADDRESS   = 0x0600;
+        static constexpr word_t      RANDOM_ADDRESS = 0x00FE;
+        static constexpr word_t      KEY_ADDRESS    = 0x00FF;
+        static constexpr word_t      SCREEN_ADDRESS = 0x0200;
+        static constexpr std::size_t SCREEN_WIDTH   = 32;
+        static constexpr std::size_t SCREEN_HEIGHT  = 32;
+
+        enum class stop_reason : byte_t
+        {
+            RUNNING,
+            BREAK,          // BRK, the usual end of a program without interrupt handlers
+            STOP,           // STP
+            WAIT,           // WAI, no interrupt will ever come
+            CYCLE_LIMIT
+        };
+
+        struct registers
+        {
+            byte_t a  {0};
+            byte_t x  {0};
+            byte_t y  {0};
+            byte_t sp {0xFF};
+            byte_t p  {0x30};
+            word_t pc {LOAD_ADDRESS};
+        };
+
+        explicit emulator(const memory_image &image, std::uint64_t seed);
+
+        // Executes one command and returns its cycles with the penalties, nothing once the program stopped
+        std::size_t step();
+        // Runs until the program stops or the total cycle count reaches cycle_limit
+        stop_reason run(std::uint64_t cycle_limit);
+
+        void press_key(byte_t key) noexcept;
+        // True once after every write to the screen
+        bool take_screen_change() noexcept;
+
+        const registers         &state() const noexcept;
+        std::uint64_t            cycles() const noexcept;
+        stop_reason              stopped() const noexcept;
+        byte_t                   peek(word_t address) const noexcept;
+        std::span<const byte_t>  screen() const noexcept;
+
+    private:
+        enum flag : byte_t
+        {
+            CARRY = 0x01, ZERO = 0x02, INTERRUPT = 0x04, DECIMAL = 0x08,
+            BREAK_FLAG = 0x10, UNUSED = 0x20, OVERFLOW = 0x40, NEGATIVE = 0x80
+        };
+
+        std::array<byte_t, 0x1'00'00> m_memory {};
+        registers                     m_registers {};
+        std::uint64_t                 m_cycles {0};
+        std::uint64_t                 m_random;
+        stop_reason                   m_stopped {stop_reason::RUNNING};
+        bool                          m_screen_changed {true};
+        bool                          m_page_crossed   {false};     // By the last command, see command_penalties
+        bool                          m_branch_taken   {false};
+
+        byte_t read(word_t address) noexcept;
+        void   write(word_t address, byte_t value) noexcept;
+        byte_t fetch() noexcept;
+        word_t fetch_word() noexcept;
+        word_t read_zero_page_word(byte_t address) noexcept;
+        void   push(byte_t value) noexcept;
+        byte_t pull() noexcept;
+
+        word_t indexed(word_t base, byte_t index) noexcept;
+        word_t operand_address(serializable_token::st_mode mode) noexcept;
+        void   execute(const instruction &in, word_t address);
+
+        void set_flag(flag f, bool value) noexcept;
+        bool get_flag(flag f) const noexcept;
+        byte_t set_nz(byte_t value) noexcept;
+        void   compare(byte_t reg, byte_t value) noexcept;
+        void   add(byte_t value) noexcept;
+        void   subtract(byte_t value) noexcept;
+        void   branch(bool condition, word_t target) noexcept;
+    };
+}
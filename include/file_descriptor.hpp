@@ -0,0 +1,34 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |        File Descriptor        |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#pragma once
+
+#if defined(__unix__) or defined(__APPLE__)
+#include <unistd.h>
+
+
+namespace mxasm
+{
+    // Owns a POSIX descriptor, closed on destruction
+    class file_descriptor
+    {
+    public:
+        explicit file_descriptor(int fd) noexcept : m_fd {fd} {}
+        file_descriptor(const file_descriptor &) = delete;
+        file_descriptor &operator=(const file_descriptor &) = delete;
+        ~file_descriptor() { if (m_fd >= 0) ::close(m_fd); }
+
+        void reset(int fd) noexcept { if (m_fd >= 0) ::close(m_fd); m_fd = fd; }
+        int  get() const noexcept { return m_fd; }
+        bool is_open() const noexcept { return m_fd >= 0; }
+        int  close() noexcept { const int res = ::close(m_fd); m_fd = -1; return res; }
+
+    private:
+        int m_fd;
+    };
+}
+#endif
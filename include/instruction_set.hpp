@@ -0,0 +1,307 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |        Instruction Set        |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "../include/parser_token.hpp"
+#include "../include/serializable_token.hpp"
+
+
+namespace mxasm
+{
+    struct instruction
+    {
+        parser_token::pt_opcode         mnemonic;
+        serializable_token::st_mode     mode;
+        serializable_token::st_command  command;
+    };
+
+    namespace instruction_data
+    {
+        using pt_opcode  = parser_token::pt_opcode;
+        using st_mode    = serializable_token::st_mode;
+        using st_command = serializable_token::st_command;
+
+        // Every 65C02 command. The parser and serializer tables below are built from it,
+        // so another CPU variant is a matter of editing these rows
+        inline constexpr instruction instructions[] {
+            {pt_opcode::ADC, st_mode::IMM, st_command::ADC_imm}, {pt_opcode::ADC, st_mode::ZPG, st_command::ADC_zpg}, {pt_opcode::ADC, st_mode::ZPX, st_command::ADC_zpx},
+            {pt_opcode::ADC, st_mode::IZP, st_command::ADC_izp}, {pt_opcode::ADC, st_mode::IZX, st_command::ADC_izx}, {pt_opcode::ADC, st_mode::IZY, st_command::ADC_izy},
+            {pt_opcode::ADC, st_mode::ABS, st_command::ADC_abs}, {pt_opcode::ADC, st_mode::ABX, st_command::ADC_abx}, {pt_opcode::ADC, st_mode::ABY, st_command::ADC_aby},
+            {pt_opcode::AND, st_mode::IMM, st_command::AND_imm}, {pt_opcode::AND, st_mode::ZPG, st_command::AND_zpg}, {pt_opcode::AND, st_mode::ZPX, st_command::AND_zpx},
+            {pt_opcode::AND, st_mode::IZP, st_command::AND_izp}, {pt_opcode::AND, st_mode::IZX, st_command::AND_izx}, {pt_opcode::AND, st_mode::IZY, st_command::AND_izy},
+            {pt_opcode::AND, st_mode::ABS, st_command::AND_abs}, {pt_opcode::AND, st_mode::ABX, st_command::AND_abx}, {pt_opcode::AND, st_mode::ABY, st_command::AND_aby},
+            {pt_opcode::ASL, st_mode::ACC, st_command::ASL_a}, {pt_opcode::ASL, st_mode::ZPG, st_command::ASL_zpg}, {pt_opcode::ASL, st_mode::ZPX, st_command::ASL_zpx},
+            {pt_opcode::ASL, st_mode::ABS, st_command::ASL_abs}, {pt_opcode::ASL, st_mode::ABX, st_command::ASL_abx},
+            {pt_opcode::BBR0, st_mode::ZPR, st_command::BBR0_zpr},
+            {pt_opcode::BBR1, st_mode::ZPR, st_command::BBR1_zpr},
+            {pt_opcode::BBR2, st_mode::ZPR, st_command::BBR2_zpr},
+            {pt_opcode::BBR3, st_mode::ZPR, st_command::BBR3_zpr},
+            {pt_opcode::BBR4, st_mode::ZPR, st_command::BBR4_zpr},
+            {pt_opcode::BBR5, st_mode::ZPR, st_command::BBR5_zpr},
+            {pt_opcode::BBR6, st_mode::ZPR, st_command::BBR6_zpr},
+            {pt_opcode::BBR7, st_mode::ZPR, st_command::BBR7_zpr},
+            {pt_opcode::BBS0, st_mode::ZPR, st_command::BBS0_zpr},
+            {pt_opcode::BBS1, st_mode::ZPR, st_command::BBS1_zpr},
+            {pt_opcode::BBS2, st_mode::ZPR, st_command::BBS2_zpr},
+            {pt_opcode::BBS3, st_mode::ZPR, st_command::BBS3_zpr},
+            {pt_opcode::BBS4, st_mode::ZPR, st_command::BBS4_zpr},
+            {pt_opcode::BBS5, st_mode::ZPR, st_command::BBS5_zpr},
+            {pt_opcode::BBS6, st_mode::ZPR, st_command::BBS6_zpr},
+            {pt_opcode::BBS7, st_mode::ZPR, st_command::BBS7_zpr},
+            {pt_opcode::BCC, st_mode::REL, st_command::BCC_rel},
+            {pt_opcode::BCS, st_mode::REL, st_command::BCS_rel},
+            {pt_opcode::BEQ, st_mode::REL, st_command::BEQ_rel},
+            {pt_opcode::BIT, st_mode::IMM, st_command::BIT_imm}, {pt_opcode::BIT, st_mode::ZPG, st_command::BIT_zpg}, {pt_opcode::BIT, st_mode::ZPX, st_command::BIT_zpx},
+            {pt_opcode::BIT, st_mode::ABS, st_command::BIT_abs}, {pt_opcode::BIT, st_mode::ABX, st_command::BIT_abx},
+            {pt_opcode::BMI, st_mode::REL, st_command::BMI_rel},
+            {pt_opcode::BNE, st_mode::REL, st_command::BNE_rel},
+            {pt_opcode::BPL, st_mode::REL, st_command::BPL_rel},
+            {pt_opcode::BRA, st_mode::REL, st_command::BRA_rel},
+            {pt_opcode::BRK, st_mode::STK, st_command::BRK_stk},
+            {pt_opcode::BVC, st_mode::REL, st_command::BVC_rel},
+            {pt_opcode::BVS, st_mode::REL, st_command::BVS_rel},
+            {pt_opcode::CLC, st_mode::IMP, st_command::CLC_imp},
+            {pt_opcode::CLD, st_mode::IMP, st_command::CLD_imp},
+            {pt_opcode::CLI, st_mode::IMP, st_command::CLI_imp},
+            {pt_opcode::CLV, st_mode::IMP, st_command::CLV_imp},
+            {pt_opcode::CMP, st_mode::IMM, st_command::CMP_imm}, {pt_opcode::CMP, st_mode::ZPG, st_command::CMP_zpg}, {pt_opcode::CMP, st_mode::ZPX, st_command::CMP_zpx},
+            {pt_opcode::CMP, st_mode::IZP, st_command::CMP_izp}, {pt_opcode::CMP, st_mode::IZX, st_command::CMP_izx}, {pt_opcode::CMP, st_mode::IZY, st_command::CMP_izy},
+            {pt_opcode::CMP, st_mode::ABS, st_command::CMP_abs}, {pt_opcode::CMP, st_mode::ABX, st_command::CMP_abx}, {pt_opcode::CMP, st_mode::ABY, st_command::CMP_aby},
+            {pt_opcode::CPY, st_mode::IMM, st_command::CPY_imm}, {pt_opcode::CPY, st_mode::ZPG, st_command::CPY_zpg}, {pt_opcode::CPY, st_mode::ABS, st_command::CPY_abs},
+            {pt_opcode::CPX, st_mode::IMM, st_command::CPX_imm}, {pt_opcode::CPX, st_mode::ZPG, st_command::CPX_zpg}, {pt_opcode::CPX, st_mode::ABS, st_command::CPX_abs},
+            {pt_opcode::DEC, st_mode::ACC, st_command::DEC_a}, {pt_opcode::DEC, st_mode::ZPG, st_command::DEC_zpg}, {pt_opcode::DEC, st_mode::ZPX, st_command::DEC_zpx},
+            {pt_opcode::DEC, st_mode::ABS, st_command::DEC_abs}, {pt_opcode::DEC, st_mode::ABX, st_command::DEC_abx},
+            {pt_opcode::DEX, st_mode::IMP, st_command::DEX_imp},
+            {pt_opcode::DEY, st_mode::IMP, st_command::DEY_imp},
+            {pt_opcode::EOR, st_mode::IMM, st_command::EOR_imm}, {pt_opcode::EOR, st_mode::ZPG, st_command::EOR_zpg}, {pt_opcode::EOR, st_mode::ZPX, st_command::EOR_zpx},
+            {pt_opcode::EOR, st_mode::IZP, st_command::EOR_izp}, {pt_opcode::EOR, st_mode::IZX, st_command::EOR_izx}, {pt_opcode::EOR, st_mode::IZY, st_command::EOR_izy},
+            {pt_opcode::EOR, st_mode::ABS, st_command::EOR_abs}, {pt_opcode::EOR, st_mode::ABX, st_command::EOR_abx}, {pt_opcode::EOR, st_mode::ABY, st_command::EOR_aby},
+            {pt_opcode::INC, st_mode::ACC, st_command::INC_a}, {pt_opcode::INC, st_mode::ZPG, st_command::INC_zpg}, {pt_opcode::INC, st_mode::ZPX, st_command::INC_zpx},
+            {pt_opcode::INC, st_mode::ABS, st_command::INC_abs}, {pt_opcode::INC, st_mode::ABX, st_command::INC_abx},
+            {pt_opcode::INX, st_mode::IMP, st_command::INX_imp},
+            {pt_opcode::INY, st_mode::IMP, st_command::INY_imp},
+            {pt_opcode::JMP, st_mode::ABS, st_command::JMP_abs}, {pt_opcode::JMP, st_mode::IND, st_command::JMP_ind}, {pt_opcode::JMP, st_mode::IAX, st_command::JMP_iax},
+            {pt_opcode::JSR, st_mode::ABS, st_command::JSR_abs},
+            {pt_opcode::LDA, st_mode::IMM, st_command::LDA_imm}, {pt_opcode::LDA, st_mode::ZPG, st_command::LDA_zpg}, {pt_opcode::LDA, st_mode::ZPX, st_command::LDA_zpx},
+            {pt_opcode::LDA, st_mode::IZP, st_command::LDA_izp}, {pt_opcode::LDA, st_mode::IZX, st_command::LDA_izx}, {pt_opcode::LDA, st_mode::IZY, st_command::LDA_izy},
+            {pt_opcode::LDA, st_mode::ABS, st_command::LDA_abs}, {pt_opcode::LDA, st_mode::ABX, st_command::LDA_abx}, {pt_opcode::LDA, st_mode::ABY, st_command::LDA_aby},
+            {pt_opcode::LDX, st_mode::IMM, st_command::LDX_imm}, {pt_opcode::LDX, st_mode::ZPG, st_command::LDX_zpg}, {pt_opcode::LDX, st_mode::ZPY, st_command::LDX_zpy},
+            {pt_opcode::LDX, st_mode::ABS, st_command::LDX_abs}, {pt_opcode::LDX, st_mode::ABY, st_command::LDX_aby},
+            {pt_opcode::LDY, st_mode::IMM, st_command::LDY_imm}, {pt_opcode::LDY, st_mode::ZPG, st_command::LDY_zpg}, {pt_opcode::LDY, st_mode::ZPX, st_command::LDY_zpx},
+            {pt_opcode::LDY, st_mode::ABS, st_command::LDY_abs}, {pt_opcode::LDY, st_mode::ABX, st_command::LDY_abx},
+            {pt_opcode::LSR, st_mode::ACC, st_command::LSR_a}, {pt_opcode::LSR, st_mode::ZPG, st_command::LSR_zpg}, {pt_opcode::LSR, st_mode::ZPX, st_command::LSR_zpx},
+            {pt_opcode::LSR, st_mode::ABS, st_command::LSR_abs}, {pt_opcode::LSR, st_mode::ABX, st_command::LSR_abx},
+            {pt_opcode::NOP, st_mode::IMP, st_command::NOP_imp},
+            {pt_opcode::ORA, st_mode::IMM, st_command::ORA_imm}, {pt_opcode::ORA, st_mode::ZPG, st_command::ORA_zpg}, {pt_opcode::ORA, st_mode::ZPX, st_command::ORA_zpx},
+            {pt_opcode::ORA, st_mode::IZP, st_command::ORA_izp}, {pt_opcode::ORA, st_mode::IZX, st_command::ORA_izx}, {pt_opcode::ORA, st_mode::IZY, st_command::ORA_izy},
+            {pt_opcode::ORA, st_mode::ABS, st_command::ORA_abs}, {pt_opcode::ORA, st_mode::ABX, st_command::ORA_abx}, {pt_opcode::ORA, st_mode::ABY, st_command::ORA_aby},
+            {pt_opcode::PHA, st_mode::STK, st_command::PHA_stk},
+            {pt_opcode::PHP, st_mode::STK, st_command::PHP_stk},
+            {pt_opcode::PHX, st_mode::STK, st_command::PHX_stk},
+            {pt_opcode::PHY, st_mode::STK, st_command::PHY_stk},
+            {pt_opcode::PLA, st_mode::STK, st_command::PLA_stk},
+            {pt_opcode::PLP, st_mode::STK, st_command::PLP_stk},
+            {pt_opcode::PLX, st_mode::STK, st_command::PLX_stk},
+            {pt_opcode::PLY, st_mode::STK, st_command::PLY_stk},
+            {pt_opcode::RMB0, st_mode::ZPG, st_command::RMB0_zpg},
+            {pt_opcode::RMB1, st_mode::ZPG, st_command::RMB1_zpg},
+            {pt_opcode::RMB2, st_mode::ZPG, st_command::RMB2_zpg},
+            {pt_opcode::RMB3, st_mode::ZPG, st_command::RMB3_zpg},
+            {pt_opcode::RMB4, st_mode::ZPG, st_command::RMB4_zpg},
+            {pt_opcode::RMB5, st_mode::ZPG, st_command::RMB5_zpg},
+            {pt_opcode::RMB6, st_mode::ZPG, st_command::RMB6_zpg},
+            {pt_opcode::RMB7, st_mode::ZPG, st_command::RMB7_zpg},
+            {pt_opcode::ROL, st_mode::ACC, st_command::ROL_a}, {pt_opcode::ROL, st_mode::ZPG, st_command::ROL_zpg}, {pt_opcode::ROL, st_mode::ZPX, st_command::ROL_zpx},
+            {pt_opcode::ROL, st_mode::ABS, st_command::ROL_abs}, {pt_opcode::ROL, st_mode::ABX, st_command::ROL_abx},
+            {pt_opcode::ROR, st_mode::ACC, st_command::ROR_a}, {pt_opcode::ROR, st_mode::ZPG, st_command::ROR_zpg}, {pt_opcode::ROR, st_mode::ZPX, st_command::ROR_zpx},
+            {pt_opcode::ROR, st_mode::ABS, st_command::ROR_abs}, {pt_opcode::ROR, st_mode::ABX, st_command::ROR_abx},
+            {pt_opcode::RTI, st_mode::STK, st_command::RTI_stk},
+            {pt_opcode::RTS, st_mode::STK, st_command::RTS_stk},
+            {pt_opcode::SBC, st_mode::IMM, st_command::SBC_imm}, {pt_opcode::SBC, st_mode::ZPG, st_command::SBC_zpg}, {pt_opcode::SBC, st_mode::ZPX, st_command::SBC_zpx},
+            {pt_opcode::SBC, st_mode::IZP, st_command::SBC_izp}, {pt_opcode::SBC, st_mode::IZX, st_command::SBC_izx}, {pt_opcode::SBC, st_mode::IZY, st_command::SBC_izy},
+            {pt_opcode::SBC, st_mode::ABS, st_command::SBC_abs}, {pt_opcode::SBC, st_mode::ABX, st_command::SBC_abx}, {pt_opcode::SBC, st_mode::ABY, st_command::SBC_aby},
+            {pt_opcode::SEC, st_mode::IMP, st_command::SEC_imp},
+            {pt_opcode::SED, st_mode::IMP, st_command::SED_imp},
+            {pt_opcode::SEI, st_mode::IMP, st_command::SEI_imp},
+            {pt_opcode::SMB0, st_mode::ZPG, st_command::SMB0_zpg},
+            {pt_opcode::SMB1, st_mode::ZPG, st_command::SMB1_zpg},
+            {pt_opcode::SMB2, st_mode::ZPG, st_command::SMB2_zpg},
+            {pt_opcode::SMB3, st_mode::ZPG, st_command::SMB3_zpg},
+            {pt_opcode::SMB4, st_mode::ZPG, st_command::SMB4_zpg},
+            {pt_opcode::SMB5, st_mode::ZPG, st_command::SMB5_zpg},
+            {pt_opcode::SMB6, st_mode::ZPG, st_command::SMB6_zpg},
+            {pt_opcode::SMB7, st_mode::ZPG, st_command::SMB7_zpg},
+            {pt_opcode::STA, st_mode::ZPG, st_command::STA_zpg}, {pt_opcode::STA, st_mode::ZPX, st_command::STA_zpx}, {pt_opcode::STA, st_mode::IZP, st_command::STA_izp},
+            {pt_opcode::STA, st_mode::IZX, st_command::STA_izx}, {pt_opcode::STA, st_mode::IZY, st_command::STA_izy}, {pt_opcode::STA, st_mode::ABS, st_command::STA_abs},
+            {pt_opcode::STA, st_mode::ABX, st_command::STA_abx}, {pt_opcode::STA, st_mode::ABY, st_command::STA_aby},
+            {pt_opcode::STP, st_mode::IMP, st_command::STP_imp},
+            {pt_opcode::STX, st_mode::ZPG, st_command::STX_zpg}, {pt_opcode::STX, st_mode::ZPY, st_command::STX_zpy}, {pt_opcode::STX, st_mode::ABS, st_command::STX_abs},
+            {pt_opcode::STY, st_mode::ZPG, st_command::STY_zpg}, {pt_opcode::STY, st_mode::ZPX, st_command::STY_zpx}, {pt_opcode::STY, st_mode::ABS, st_command::STY_abs},
+            {pt_opcode::STZ, st_mode::ZPG, st_command::STZ_zpg}, {pt_opcode::STZ, st_mode::ZPX, st_command::STZ_zpx}, {pt_opcode::STZ, st_mode::ABS, st_command::STZ_abs},
+            {pt_opcode::STZ, st_mode::ABX, st_command::STZ_abx},
+            {pt_opcode::TAX, st_mode::IMP, st_command::TAX_imp},
+            {pt_opcode::TAY, st_mode::IMP, st_command::TAY_imp},
+            {pt_opcode::TRB, st_mode::ZPG, st_command::TRB_zpg}, {pt_opcode::TRB, st_mode::ABS, st_command::TRB_abs},
+            {pt_opcode::TSB, st_mode::ZPG, st_command::TSB_zpg}, {pt_opcode::TSB, st_mode::ABS, st_command::TSB_abs},
+            {pt_opcode::TSX, st_mode::IMP, st_command::TSX_imp},
+            {pt_opcode::TXA, st_mode::IMP, st_command::TXA_imp},
+            {pt_opcode::TXS, st_mode::IMP, st_command::TXS_imp},
+            {pt_opcode::TYA, st_mode::IMP, st_command::TYA_imp},
+            {pt_opcode::WAI, st_mode::IMP, st_command::WAI_imp},
+        };
+    }
+
+    inline constexpr auto &instruction_set = instruction_data::instructions;
+
+
+    // Parser addressing mode, written the way a command with this mode is
+    constexpr parser_token::adr_mode
+    command_adr_mode(const serializable_token::st_mode mode) noexcept
+    {
+        using adr_mode = parser_token::adr_mode;
+        using st_mode  = serializable_token::st_mode;
+        switch (mode) {
+            case st_mode::IMP:
+            case st_mode::STK: return adr_mode::STK_or_IMP;
+            case st_mode::ACC: return adr_mode::A;
+            case st_mode::IMM: return adr_mode::IMM;
+            case st_mode::ZPG: return adr_mode::ZP;
+            case st_mode::ZPX: return adr_mode::ZP_X;
+            case st_mode::ZPY: return adr_mode::ZP_Y;
+            case st_mode::ZPR: return adr_mode::ZP_REL;
+            case st_mode::IZP: return adr_mode::ZP_IND;
+            case st_mode::IZX: return adr_mode::ZP_X_IND;
+            case st_mode::IZY: return adr_mode::ZP_IND_Y;
+            case st_mode::ABS:
+            case st_mode::REL: return adr_mode::ABS_or_REL;
+            case st_mode::ABX: return adr_mode::ABS_X;
+            case st_mode::ABY: return adr_mode::ABS_Y;
+            case st_mode::IND: return adr_mode::ABS_IND;
+            case st_mode::IAX: return adr_mode::ABS_X_IND;
+        }
+        return adr_mode::UNEXPECTED;
+    }
+
+    // Bytes, following the opcode
+    constexpr std::size_t
+    operand_size(const serializable_token::st_mode mode) noexcept
+    {
+        using st_mode = serializable_token::st_mode;
+        switch (mode) {
+            case st_mode::IMP:
+            case st_mode::STK:
+            case st_mode::ACC: return 0;
+            case st_mode::ABS:
+            case st_mode::ABX:
+            case st_mode::ABY:
+            case st_mode::IND:
+            case st_mode::IAX:
+            case st_mode::ZPR: return 2;
+            default:           return 1;
+        }
+    }
+
+
+    // (mnemonic, addressing mode) -> command
+    class encoding_table
+    {
+    public:
+        static constexpr std::size_t MNEMONIC_COUNT = static_cast<std::size_t>(parser_token::pt_opcode::REGISTER_X);
+        static constexpr std::size_t MODE_COUNT     = static_cast<std::size_t>(parser_token::adr_mode::ZP_IND_Y) + 1;
+
+        constexpr encoding_table() noexcept
+        {
+            for (auto &row : m_index) row.fill(NONE);
+            for (std::size_t i = 0; i < std::size(instruction_set); ++i) {
+                const auto &in = instruction_set[i];
+                m_index[index(in.mnemonic)][index(command_adr_mode(in.mode))] = static_cast<int16_t>(i);
+                // Accumulator commands are written without an operand as well
+                if (in.mode == serializable_token::st_mode::ACC) {
+                    m_index[index(in.mnemonic)][index(parser_token::adr_mode::STK_or_IMP)] = static_cast<int16_t>(i);
+                }
+            }
+        }
+
+        constexpr const instruction *find(const parser_token::pt_opcode mnemonic,
+                                          const parser_token::adr_mode mode) const noexcept
+        {
+            if (index(mnemonic) >= MNEMONIC_COUNT) return nullptr;
+            const int16_t i = m_index[index(mnemonic)][index(mode)];
+            return i == NONE ? nullptr : &instruction_set[i];
+        }
+
+    private:
+        static constexpr int16_t NONE = -1;
+        std::array<std::array<int16_t, MODE_COUNT>, MNEMONIC_COUNT> m_index {};
+
+        template<typename Enum>
+        static constexpr std::size_t index(const Enum value) noexcept
+        { return static_cast<std::size_t>(value); }
+    };
+
+    inline constexpr encoding_table instruction_encodings {};
+
+
+    // Opcode byte -> addressing mode, for the serializer
+    inline constexpr std::array<serializable_token::st_mode, 0x100> command_modes = [] {
+        std::array<serializable_token::st_mode, 0x100> modes {};
+        modes.fill(serializable_token::st_mode::IMP);
+        for (const auto &in : instruction_set) {
+            modes[static_cast<byte_t>(in.command)] = in.mode;
+        }
+        return modes;
+    }();
+
+    constexpr serializable_token::st_mode
+    command_mode(const serializable_token::st_command command) noexcept
+    { return command_modes[static_cast<byte_t>(command)]; }
+
+    // The branch on the opposite condition, BEQ for BNE and BBS3 for BBR3: the opcodes of a pair
+    // differ in one bit. BRA has no opposite
+    constexpr serializable_token::st_command
+    inverted_branch(const serializable_token::st_command command) noexcept
+    {
+        const byte_t flip = command_mode(command) == serializable_token::st_mode::ZPR ? 0x80 : 0x20;
+        return static_cast<serializable_token::st_command>(static_cast<byte_t>(command) ^ flip);
+    }
+
+
+    // Opcode byte -> the same command on a zero page operand, for the serializer. Absolute
+    // commands without a zero page form, and every other byte, map to themselves
+    inline constexpr std::array<serializable_token::st_command, 0x100> zero_page_commands = [] {
+        using adr_mode = parser_token::adr_mode;
+        using st_mode  = serializable_token::st_mode;
+        std::array<serializable_token::st_command, 0x100> commands {};
+        for (std::size_t i = 0; i < commands.size(); ++i) {
+            commands[i] = static_cast<serializable_token::st_command>(i);
+        }
+        for (const auto &in : instruction_set) {
+            const adr_mode zero_page = in.mode == st_mode::ABS ? adr_mode::ZP
+                                     : in.mode == st_mode::ABX ? adr_mode::ZP_X
+                                     : in.mode == st_mode::ABY ? adr_mode::ZP_Y : adr_mode::UNEXPECTED;
+            if (zero_page == adr_mode::UNEXPECTED) continue;
+            if (const instruction *short_form = instruction_encodings.find(in.mnemonic, zero_page)) {
+                commands[static_cast<byte_t>(in.command)] = short_form->command;
+            }
+        }
+        return commands;
+    }();
+
+
+    // Opcode byte -> command, for the emulator. Bytes without a command map to nullptr
+    inline constexpr std::array<const instruction *, 0x100> command_instructions = [] {
+        std::array<const instruction *, 0x100> commands {};
+        for (const auto &in : instruction_set) {
+            commands[static_cast<byte_t>(in.command)] = &in;
+        }
+        return commands;
+    }();
+}
@@ -7,10 +7,10 @@
 
 #pragma once
 
-#include <list>
+#include <vector>
 
 #include "lexer_token.hpp"
-#include "exceptions/lexer_exception.hpp"
+#include "diagnostic.hpp"
 #include "util.hpp"
 
 
@@ -19,48 +19,48 @@ namespace mxasm
     class lexer
     {
     public:
-        explicit lexer(const source_listing &source) noexcept;
+        // Stops at the first error past max_errors, when it is not 0
+        explicit lexer(const source_listing &source, std::size_t max_errors = 0) noexcept;
 
-        std::list<lexer_token> tokens();
+        const std::vector<lexer_token> &tokens();
 
     private:
-        const source_listing   &m_source_listing;
-        std::list<lexer_token>  m_tokens;
-        exception_list          m_exceptions;
+        const source_listing     &m_source_listing;
+        std::vector<lexer_token>  m_tokens;
+        diagnostic_list           m_diagnostics;
+        std::size_t               m_max_errors;
 
-        std::string::const_iterator m_current_begin {};
-        std::string::const_iterator m_current_iter  {};
-        std::size_t                 m_current_row   {};
+        std::string_view::const_iterator m_current_begin {};
+        std::string_view::const_iterator m_current_iter  {};
+        std::string_view::const_iterator m_current_end   {};
+        std::size_t                      m_current_row   {};
 
         void tokenize();
-        lexer_token next(const std::pair<std::size_t, std::string> &line) noexcept;
+        lexer_token next(const source_line &line) noexcept;
         lexer_token atom(const lexer_token::lt_kind token_kind) noexcept;
-        lexer_token unexpected(const std::string::const_iterator begin) noexcept;
-        lexer_token unexpected(std::string lexeme, const std::size_t column) noexcept;
+        lexer_token unexpected(const std::string_view::const_iterator begin) noexcept;
+        lexer_token unexpected(const std::string_view lexeme, const std::size_t column) noexcept;
         lexer_token comment() noexcept;
         lexer_token directive() noexcept;
         lexer_token string() noexcept;
-        lexer_token hex_constant() noexcept;
-        lexer_token bin_constant() noexcept;
-        lexer_token octal_constant() noexcept;
-        lexer_token decimal_constant() noexcept;
+        lexer_token number(const lexer_token::lt_kind token_kind, const uint16_t body_class,
+                           const std::size_t min_length) noexcept;
         lexer_token identifier_or_label_decl() noexcept;
 
-        std::size_t get_column_number(const std::string::const_iterator current_position) const noexcept;
-        void        add_exception(const std::string &exception) noexcept;
+        std::size_t get_column_number(const std::string_view::const_iterator current_position) const noexcept;
+        bool        add_error(const lexer_token &token);
+        char        symbol_at(const std::string_view::const_iterator position) const noexcept;
         char        peek() const noexcept;
         char        get() noexcept;
+        void        skip_with(const char *(*scan)(const char *begin, const char *end) noexcept) noexcept;
+        void        skip_run(const uint16_t char_class,
+                             const char *(*scan)(const char *begin, const char *end) noexcept) noexcept;
 
         static bool is_space(const char c) noexcept;
         static bool is_end_of_line(const char c) noexcept;
-        static bool is_digit(const char c) noexcept;
-        static bool is_letter(const char c) noexcept;
         static bool is_identifier_char(const char c) noexcept;
         static bool is_string_symbol(const char c) noexcept;
-        static bool is_hex_digit(const char c) noexcept;
-        static bool is_bin_digit(const char c) noexcept;
-        static bool is_octal_digit(const char c) noexcept;
-        static bool validate_identifier_name(const std::string &id) noexcept;
+        static bool validate_identifier_name(const std::string_view id) noexcept;
         static bool is_allowed_back_symbol(const char c) noexcept;
     };
 }
\ No newline at end of file
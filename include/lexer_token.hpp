@@ -8,6 +8,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <map>
 
 
@@ -45,16 +46,16 @@ namespace mxasm
         };
 
         lexer_token(const lt_kind kind);
-        lexer_token(const lt_kind kind, const std::string lexeme, const std::size_t row, const std::size_t column);
+        lexer_token(const lt_kind kind, const std::string_view lexeme, const std::size_t row, const std::size_t column);
 
-        std::size_t row() const noexcept;
-        std::size_t column() const noexcept;
-        std::string lexeme() const noexcept;
-        lt_kind     kind() const noexcept;
+        std::size_t      row() const noexcept;
+        std::size_t      column() const noexcept;
+        std::string_view lexeme() const noexcept;
+        lt_kind          kind() const noexcept;
 
         void row(const std::size_t row) noexcept;
         void column(const std::size_t column) noexcept;
-        void lexeme(std::string lexeme) noexcept;
+        void lexeme(const std::string_view lexeme) noexcept;
         void kind(const lt_kind kind) noexcept;
 
         bool is(const lt_kind kind) const noexcept;
@@ -63,10 +64,10 @@ namespace mxasm
         static std::string lt_kind_to_string(const lt_kind kind) noexcept;
 
     private:
-        std::size_t m_row;
-        std::size_t m_column;
-        std::string m_lexeme;
-        lt_kind     m_kind;
+        std::size_t      m_row;
+        std::size_t      m_column;
+        std::string_view m_lexeme;      // Points into the source buffer, which outlives every token
+        lt_kind          m_kind;
 
         const static std::map<lt_kind, std::string> lt_kind_string;
 
@@ -0,0 +1,22 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |            Listing            |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#pragma once
+
+#include <string>
+
+#include "memory_image.hpp"
+#include "source_map.hpp"
+
+
+namespace mxasm
+{
+    // Every source row with its address, bytes and the cycles of its command, then the cost of one
+    // pass through every loop. Nothing runs: the cycles come from the tables of serializable_token
+    std::string listing_text(const memory_image &program, const source_map &map);
+    void        write_listing(const memory_image &program, const source_map &map, const std::string &out_name);
+}
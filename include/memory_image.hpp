@@ -0,0 +1,65 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |          Memory Image         |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "util.hpp"
+
+
+namespace mxasm
+{
+    // Sparse 64 KiB address space. Pages are allocated on the first write
+    // and remember which of their bytes were written
+    class memory_image
+    {
+    public:
+        static constexpr std::size_t PAGE_SIZE  = 0x100;
+        static constexpr std::size_t PAGE_COUNT = 0x100;
+
+        // Run of written bytes, may cross page borders
+        struct segment
+        {
+            word_t      address;
+            std::size_t size;
+        };
+
+        memory_image() = default;
+        memory_image(memory_image &&other) noexcept = default;
+        memory_image(const memory_image &other);
+
+        memory_image &operator=(memory_image &&other) noexcept = default;
+        memory_image &operator=(const memory_image &other);
+
+        void   write(const word_t address, const byte_t value);
+        // Copies a whole run page by page, wrapping around at the end of the address space
+        void   write(word_t address, std::span<const byte_t> values);
+        byte_t read(const word_t address) const noexcept;
+        bool   is_written(const word_t address) const noexcept;
+        bool   empty() const noexcept;
+
+        std::vector<segment>                 segments() const;
+        std::vector<std::span<const byte_t>> chunks(const segment &range) const;
+        void                                 copy(const segment &range, std::span<byte_t> destination) const;
+        std::vector<byte_t>                  bytes(const segment &range) const;
+
+    private:
+        struct page
+        {
+            std::array<byte_t, PAGE_SIZE> bytes   {};
+            std::bitset<PAGE_SIZE>        written {};
+        };
+
+        std::array<std::unique_ptr<page>, PAGE_COUNT> m_pages {};
+        std::size_t                                   m_page_count {0};
+    };
+}
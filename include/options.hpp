@@ -0,0 +1,64 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |            Options            |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "program_writer.hpp"
+#include "assembler.hpp"
+#include "runner.hpp"
+
+
+namespace mxasm
+{
+    enum class run_mode : uint8_t
+    {
+        ASSEMBLE,   // Every source in this process
+        SERVE,      // Stay resident and assemble requests from the socket
+        CONNECT,    // Send every source to a running server
+        RUN         // Assemble one source and run it on the emulator
+    };
+
+    enum class stats_format : uint8_t
+    {
+        NONE, TEXT, JSON
+    };
+
+    struct assembler_options
+    {
+        std::vector<std::string> source_paths;
+        write_options            output;
+        pipeline_options         pipeline;
+        run_options              run;
+        std::size_t              jobs        {1};
+        run_mode                 mode        {run_mode::ASSEMBLE};
+        std::string              socket_path {};
+        std::string              cache_directory {};            // No disk cache when empty
+        std::uint64_t            cache_size      {64u << 20};
+        bool                     cache_stats     {false};
+        stats_format             stats           {stats_format::NONE};
+    };
+
+    // mxasm [--atomic] [--sync=none|fsync|direct] [--listing] [--jobs=N] [--connect[=socket]]
+    //       [--cache[=dir]] [--cache-size=N[K|M|G]] [--cache-stats] [--stats[=text|json]]
+    //       [--max-errors=N] [--no-zero-page] [--relax|--no-relax] [--shrink-jumps]
+    //       <name>.asm... [@response_file]...
+    // mxasm --server[=socket] [--max-errors=N] [--no-zero-page] [--relax|--no-relax] [--shrink-jumps]
+    // --max-errors and the encoding options are the server's: a client started with --connect can't take them.
+    // --listing, --cache* and --stats are only for assembling in this process
+    // mxasm run [--clock=HZ] [--max-cycles=N] [--seed=N] [--profile] [--stacks=file] [--max-errors=N]
+    //           [--no-zero-page] [--relax|--no-relax] [--shrink-jumps] <name>.asm
+    // A response file lists more arguments, one per line
+    assembler_options get_options_from_cmd(const std::vector<std::string> &arguments);
+    std::string       get_output_path(const std::string &source_path);
+    std::string       get_listing_path(const std::string &source_path);
+
+    // Assembler version and every option that changes the binary, for the cache key
+    std::string       assembly_fingerprint(const assembler_options &options);
+}
@@ -7,14 +7,21 @@
 
 #pragma once
 
-#include <list>
 #include <map>
+#include <memory>
+#include <vector>
+#include <span>
+#include <string>
+#include <unordered_map>
 
 #include "../include/lexer_token.hpp"
 #include "../include/parser_token.hpp"
 #include "../include/serializable_token.hpp"
-#include "../include/exceptions/parser_excpetion.hpp"
+#include "../include/instruction_set.hpp"
+#include "../include/diagnostic.hpp"
 #include "../include/util.hpp"
+#include "../include/stats.hpp"
+#include "../include/source_file.hpp"
 
 
 namespace mxasm
@@ -22,80 +29,104 @@ namespace mxasm
     class parser
     {
     public:
-        explicit parser(std::list<lexer_token> &lexed_tokens);
+        // Reports at most max_errors, when it is not 0. Relative .incbin paths start from asset_directory,
+        // without one .incbin is an error and no file is opened
+        explicit parser(const std::vector<lexer_token> &lexed_tokens, std::size_t max_errors = 0,
+                        assembly_stats *stats = nullptr, std::string asset_directory = {});
 
-        std::list<serializable_token> tokens();
+        const std::vector<serializable_token> &tokens();
+        // Paths of the files included with .incbin
+        std::vector<std::string>               assets() const;
+        // Names by label id, empty for the ids of macros
+        std::vector<std::string>               label_names() const;
 
     private:
-        std::list<std::list<lexer_token>>  m_lexer_tokens;
-        std::list<std::list<parser_token>> m_parser_tokens;
-        std::list<serializable_token>      m_tokens;
-        exception_list                     m_exceptions;
+        typedef std::span<parser_token> token_line;
+
+        // Errors are reported stage by stage, as the first stage with errors hides the later ones
+        enum class parse_stage : uint8_t
+        {
+            TOKENS, LINE_START, LABELS, COMMANDS
+        };
+
+        struct staged_diagnostic
+        {
+            parse_stage stage;
+            std::size_t line;
+            bool        converting;     // Found while converting lexer tokens, which is never redone
+            diagnostic  error;          // The argument is in m_error_arguments
+        };
+
+        struct symbol
+        {
+            bool                is_macro    {false};
+            word_t              value       {0};
+            const parser_token *declaration {nullptr};  // Label declaration token, if any
+        };
+
+        // Line with label calls, parsed again if one of them turns out to be a later .define
+        struct pending_line
+        {
+            token_line  tokens;
+            std::size_t line;
+            std::size_t first_output;
+            std::size_t last_output;
+        };
+
+        std::vector<lexer_token>        m_lexer_tokens;
+        std::vector<parser_token>       m_token_arena;      // Every parser token, row after row
+        std::vector<serializable_token> m_tokens;
+        std::vector<symbol>             m_symbols;
+        std::unordered_map<std::string_view, std::size_t,
+                           case_insensitive_hash, case_insensitive_equal> m_symbol_indexes;
+        std::vector<pending_line>       m_pending_lines;
+        std::string                     m_asset_directory;
+        std::map<std::string, std::shared_ptr<const source_file>> m_assets;     // Mapped once per path
+        std::vector<staged_diagnostic>  m_diagnostics;
+        std::string                     m_error_arguments;
+        std::size_t                     m_max_errors;
+        std::size_t                     m_token_errors {0};
+        assembly_stats                 *m_stats;
+        parse_stage                     m_stage {parse_stage::TOKENS};
+        bool                            m_converting {false};
+        std::size_t                     m_line  {0};
 
         void tokenize();
-        void validate_numbers_size();
-        void validate_code_pos_directives();
-        void find_byte_lines();
-        void index_and_replace_constants();
-        void validate_and_replace_labels();
-        void parser_tokens_to_serializable();
-
-        void organize_lexer_tokens(std::list<lexer_token> &lexed_tokens);
-        void add_exception(const std::string &exception) noexcept;
-
-        void l_decl(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-
-
-        void validate_end_of_command(const std::list<parser_token>::const_iterator &iter,
-                                     const std::list<parser_token>::const_iterator &end);
-        void d_code_pos(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void d_byteline(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end,
+        bool convert_token(const lexer_token &token, parser_token &tk);
+        void parse_line(token_line line, bool fixup);
+        bool translate_line(token_line line);
+        void resolve_forward_references();
+        void throw_errors();
+
+        void        define_macro(token_line line);
+        bool        replace_symbols(token_line line);
+        void        validate_numbers_size(token_line line);
+        void        validate_code_pos_directive(token_line &line);
+        void        find_byte_line(token_line &line);
+        void        find_incbin(token_line &line);
+        void        validate_line_start(token_line line);
+        bool        declare_label(parser_token &token);
+        std::size_t symbol_index(std::string_view name);
+        void        line_to_serializable(token_line line);
+
+        void organize_lexer_tokens(const std::vector<lexer_token> &lexed_tokens);
+        void add_error(diagnostic_code code, std::size_t row, std::size_t column, std::string_view argument = {});
+
+        void l_decl(token_line::iterator beg, token_line::iterator end);
+
+
+        void validate_end_of_command(const token_line::iterator &iter,
+                                     const token_line::iterator &end);
+        void d_code_pos(token_line::iterator beg, token_line::iterator end);
+        void d_byteline(token_line::iterator beg, token_line::iterator end,
                         serializable_token::st_kind dir_type);
-        void o_opc_imp(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end,
-                       serializable_token::st_command opc);
-        void o_opc_rel(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end,
-                       serializable_token::st_command opc);
-        void o_rmb_or_smb(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end,
-                          serializable_token::st_command opc);
-        void o_bbr_or_bbs(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end,
-                          serializable_token::st_command opc);
-
-        void o_jmp(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_jsr(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_asl(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_inc(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_rol(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_dec(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_lsr(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_ror(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_stx(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_ldx(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_tsb(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_ora(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_trb(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_bit(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_and(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_eor(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_adc(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_cpx(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_sbc(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_sty(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_sta(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_stz(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_ldy(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_lda(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_cpy(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-        void o_cmp(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end);
-
-
-
-
-
-
-
-
-        parser_token::adr_mode define_addr_mode(std::list<parser_token>::iterator beg,
-                                                std::list<parser_token>::iterator end);
+        void d_incbin(token_line::iterator beg, token_line::iterator end);
+        std::shared_ptr<const source_file> asset(std::string_view name);
+        void        o_command(token_line::iterator beg, token_line::iterator end);
+        std::string addressing_error_subject(token_line::iterator beg) const;
+
+        parser_token::adr_mode define_addr_mode(token_line::iterator beg,
+                                                token_line::iterator end);
 
     };
 }
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <map>
 
 #include "../include/util.hpp"
@@ -39,7 +40,7 @@ namespace mxasm
         };
 
         enum class pt_directive
-        { CODE_POSITION, BYTE, WORD, MACRO };
+        { CODE_POSITION, BYTE, WORD, MACRO, INCBIN };
 
         enum class pt_opcode
         {
@@ -86,7 +87,7 @@ namespace mxasm
         lexer_token          base_token() const noexcept;
         pt_kind              kind() const noexcept;
         std::size_t          v_number() const noexcept;
-        std::string          v_lexeme() const noexcept;
+        std::string_view     v_lexeme() const noexcept;
         std::size_t          row() const noexcept;
         std::size_t          column() const noexcept;
         pt_opcode            v_opcode() const noexcept;
@@ -96,19 +97,20 @@ namespace mxasm
         void base_token(const lexer_token new_base_token);
         void kind(const pt_kind opcode);
         void v_number(const std::size_t number);
-        void v_lexeme(const std::string lexeme);
+        void v_lexeme(const std::string_view lexeme);
         void row(const std::size_t row_value);
         void column(const std::size_t column_value);
         void v_opcode(const pt_opcode opcode);
         void v_directive(const pt_directive directive);
         void v_byteline(std::vector<word_t> &vc) noexcept;
 
-        static std::string  pt_kind_to_string(const pt_kind kind) noexcept;
-        static std::string  pt_opcode_to_string(const pt_opcode opcode) noexcept;
-        static std::string  pt_directive_to_string(const pt_directive directive) noexcept;
-        static pt_opcode    get_opcode_by_name(const std::string lexeme) noexcept;
-        static pt_directive get_directive_by_name(const std::string lexeme) noexcept;
-        static bool         is_opcode_or_register(const std::string lexeme) noexcept;
+        static const std::string  &pt_kind_to_string(const pt_kind kind) noexcept;
+        static std::string         pt_opcode_to_string(const pt_opcode opcode) noexcept;
+        static const std::string  &pt_directive_to_string(const pt_directive directive) noexcept;
+        static pt_opcode           get_opcode_by_name(const std::string_view lexeme) noexcept;
+        static pt_directive        get_directive_by_name(const std::string_view lexeme) noexcept;
+        static bool                is_opcode_or_register(const std::string_view lexeme) noexcept;
+        static bool                is_directive(const std::string_view lexeme) noexcept;
 
     private:
         std::size_t m_row;
@@ -117,7 +119,7 @@ namespace mxasm
         pt_kind     m_kind;
 
         std::size_t         m_v_number;
-        std::string         m_v_lexeme;
+        std::string_view    m_v_lexeme;
         pt_opcode           m_v_opcode;
         pt_directive        m_v_directive;
         std::vector<word_t> m_v_byteline;
@@ -125,7 +127,6 @@ namespace mxasm
 
 
         const static std::map<pt_kind, std::string>      pt_kind_string;
-        const static std::map<pt_opcode, std::string>    pt_opcode_string;
         const static std::map<pt_directive, std::string> pt_directive_string;
 
     };
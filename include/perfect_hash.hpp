@@ -0,0 +1,104 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |         Perfect Hash          |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+
+namespace mxasm
+{
+    // Keywords of up to eight symbols packed into one integer, letters folded to upper case.
+    // Zero is never a valid key, so it doubles as "not a keyword".
+    constexpr uint64_t pack_keyword(const std::string_view name) noexcept
+    {
+        if (name.empty() or name.length() > 8) return 0;
+
+        uint64_t key {0};
+        for (std::size_t i = 0; i < name.length(); ++i) {
+            char c = name[i];
+            if (c >= 'a' and c <= 'z') c -= 'a' - 'A';
+            key |= static_cast<uint64_t>(static_cast<uint8_t>(c)) << (8 * i);
+        }
+        return key;
+    }
+
+
+    // Collision-free multiplicative hash over a fixed keyword set, searched for at compile time.
+    // Lookup is one multiply, one table load and one integer compare.
+    template <typename Value, std::size_t Count, unsigned Bits>
+    class perfect_hash
+    {
+    public:
+        struct entry
+        {
+            std::string_view name;
+            Value            value;
+        };
+
+        constexpr explicit perfect_hash(const std::array<entry, Count> &entries)
+            : m_entries {entries}
+        {
+            static_assert(Count < EMPTY_SLOT, "Too many keywords for one-byte slots");
+            for (std::size_t i = 0; i < Count; ++i) m_keys[i] = pack_keyword(entries[i].name);
+
+            uint64_t seed {0x9E37'79B9'7F4A'7C15};
+            for (int attempt = 0; attempt < 100'000; ++attempt) {
+                seed += 0x9E37'79B9'7F4A'7C15;
+                m_multiplier = mix(seed) | 1;
+                if (try_fill()) return;
+            }
+            throw "No perfect hash multiplier found, increase Bits";
+        }
+
+        constexpr const Value *find(const std::string_view name) const noexcept
+        {
+            const uint64_t key  = pack_keyword(name);
+            const uint8_t  slot = m_slots[slot_of(key)];
+            if (key == 0 or slot == EMPTY_SLOT or m_keys[slot] != key) return nullptr;
+            return &m_entries[slot].value;
+        }
+
+        constexpr bool contains(const std::string_view name) const noexcept
+        { return find(name) != nullptr; }
+
+        constexpr const entry &at(const std::size_t index) const noexcept
+        { return m_entries[index]; }
+
+    private:
+        static constexpr uint8_t     EMPTY_SLOT = 0xFF;
+        static constexpr std::size_t SIZE       = std::size_t {1} << Bits;
+
+        std::array<entry, Count>     m_entries;
+        std::array<uint64_t, Count>  m_keys       {};
+        std::array<uint8_t, SIZE>    m_slots      {};
+        uint64_t                     m_multiplier {0};
+
+        constexpr std::size_t slot_of(const uint64_t key) const noexcept
+        { return (key * m_multiplier) >> (64 - Bits); }
+
+        constexpr bool try_fill() noexcept
+        {
+            m_slots.fill(EMPTY_SLOT);
+            for (std::size_t i = 0; i < Count; ++i) {
+                auto &slot = m_slots[slot_of(m_keys[i])];
+                if (slot != EMPTY_SLOT) return false;
+                slot = static_cast<uint8_t>(i);
+            }
+            return true;
+        }
+
+        static constexpr uint64_t mix(uint64_t x) noexcept
+        {
+            x = (x ^ (x >> 30)) * 0xBF58'476D'1CE4'E5B9;
+            x = (x ^ (x >> 27)) * 0x94D0'49BB'1331'11EB;
+            return x ^ (x >> 31);
+        }
+    };
+}
@@ -0,0 +1,61 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |            Profiler           |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "util.hpp"
+#include "source_map.hpp"
+
+
+namespace mxasm
+{
+    // Cycles of a run by source row and by label. Every command counts for the closest label
+    // at or before it, JSR and RTS keep the stack of calling labels for the collapsed stacks
+    class profiler
+    {
+    public:
+        explicit profiler(const source_map &map);
+
+        // Called after every command with its address, opcode and cycles
+        void record(word_t address, byte_t opcode, std::size_t cycles);
+
+        // Labels, then rows, the most cycles first
+        void write_flat_profile(std::ostream &out) const;
+        // One "outer;inner;label cycles" line per stack, the input of flamegraph.pl
+        void write_collapsed_stacks(std::ostream &out) const;
+
+    private:
+        static constexpr uint32_t    NO_LABEL  = UINT32_MAX;
+        static constexpr std::size_t MAX_DEPTH = 128;       // Return addresses fitting the hardware stack
+
+        struct counter
+        {
+            std::uint64_t cycles   {0};
+            std::uint64_t commands {0};
+        };
+
+        const source_map                         &m_map;
+        std::vector<uint32_t>                     m_label_at;   // Label id of every address
+        std::vector<counter>                      m_addresses;
+        std::vector<uint32_t>                     m_calls;      // Labels of the JSRs still to return, the outermost first
+        uint32_t                                  m_current {NO_LABEL};
+        std::map<std::vector<uint32_t>, uint64_t> m_stacks;
+        std::uint64_t                             m_pending {0};    // Cycles of the current stack, not in m_stacks yet
+        std::uint64_t                             m_total   {0};
+        std::uint64_t                             m_commands {0};
+
+        std::vector<uint32_t> current_stack() const;
+        void                  flush_stack();
+        std::string           label_name(uint32_t id) const;
+    };
+}
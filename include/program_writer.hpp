@@ -0,0 +1,35 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |         Program Writer        |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#pragma once
+
+#include <string>
+
+#include "memory_image.hpp"
+
+
+namespace mxasm
+{
+    // How hard the writer tries to get the binary onto the disk
+    enum class sync_policy
+    {
+        NONE,       // Leave it to the page cache
+        FSYNC,      // fsync() the file, and its directory after a rename
+        DIRECT      // O_DIRECT write past the page cache, then fsync()
+    };
+
+    struct write_options
+    {
+        bool        atomic  {false};    // Write to a temporary file and rename it over the target
+        sync_policy sync    {sync_policy::NONE};
+        bool        listing {false};    // Also write <name>.lst, from a fresh assembly rather than a cached one
+    };
+
+    // The file starts at the lowest written address, gaps between segments are left as holes
+    void write_program_to_file(const memory_image &program, const std::string &out_name,
+                               const write_options &options = {});
+}
@@ -0,0 +1,40 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |             Runner            |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "memory_image.hpp"
+#include "source_map.hpp"
+
+
+namespace mxasm
+{
+    // Speed of the browser simulators the 32x32 screen programs are written for
+    constexpr std::uint64_t INTERACTIVE_CLOCK_HZ = 50'000;
+
+    struct run_options
+    {
+        std::optional<std::uint64_t> clock_hz    {};        // Unthrottled when 0. When unset, INTERACTIVE_CLOCK_HZ
+                                                            // on a terminal and unthrottled otherwise
+        std::uint64_t                max_cycles  {0};       // No limit when 0
+        std::uint64_t                seed        {0};       // Of the $FE random bytes, a new one every run when 0
+        bool                         profile     {false};   // Flat profile after the end state
+        std::string                  stacks_path {};        // Collapsed stacks for flamegraphs, none when empty
+
+        bool profiling() const noexcept
+        { return profile or not stacks_path.empty(); }
+    };
+
+    // Runs the image on the emulator from $0600 until BRK, STP, WAI, the cycle limit or Ctrl-C.
+    // On a terminal the screen is drawn and keys go to $FF. The end state is printed to stdout.
+    // Profiling needs the map of the image
+    int run_program(const memory_image &image, const run_options &options, const source_map *map = nullptr);
+}
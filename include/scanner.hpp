@@ -0,0 +1,21 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |            Scanner            |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#pragma once
+
+
+namespace mxasm
+{
+    // Each function returns the first position in [begin, end) that does not belong to the scanned run,
+    // or end. Vector versions for SSE2 and AVX2 are chosen once at startup, with a scalar fallback.
+
+    const char *scan_spaces(const char *begin, const char *end) noexcept;
+    const char *scan_identifier(const char *begin, const char *end) noexcept;
+    const char *scan_line_end(const char *begin, const char *end) noexcept;
+
+    const char *scanner_instruction_set() noexcept;
+}
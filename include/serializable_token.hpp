@@ -7,9 +7,14 @@
 
 #pragma once
 
+#include <array>
+#include <bit>
+#include <memory>
+#include <span>
 #include <vector>
 
 #include "util.hpp"
+#include "source_file.hpp"
 
 
 namespace mxasm
@@ -18,7 +23,7 @@ namespace mxasm
     {
     public:
         enum class st_kind
-        { OPCODE, LABEL, CODE_POS, BYTE, WORD };
+        { OPCODE, LABEL, CODE_POS, BYTE, WORD, BINARY };
 
         enum class st_command : byte_t
         {
@@ -40,25 +45,95 @@ namespace mxasm
             BEQ_rel = 0xF0, SBC_izy = 0xF1, SBC_izp = 0xF2,                 SBC_zpx = 0xF5, INC_zpx = 0xF6, SMB7_zpg = 0xF7, SED_imp = 0xF8, SBC_aby = 0xF9, PLX_stk = 0xFA,                                 SBC_abx = 0xFD, INC_abx = 0xFE, BBS7_zpr = 0xFF
         };
 
+        // Addressing mode of a command, defines the operand bytes after the opcode
+        enum class st_mode : byte_t
+        { IMP, STK, ACC, IMM, ZPG, ZPX, ZPY, ZPR, IZP, IZX, IZY, ABS, ABX, ABY, IND, IAX, REL };
+
+        // Base cycles of every opcode byte on the W65C02S, without the extra cycles of command_penalties.
+        // Bytes without a command run as NOPs of their own timing
+        static constexpr std::array<byte_t, 0x100> command_cycles {
+        //  x0 x1 x2 x3 x4 x5 x6 x7 x8 x9 xA xB xC xD xE xF
+            7, 6, 2, 1, 5, 3, 5, 5, 3, 2, 2, 1, 6, 4, 6, 5,     // 0x
+            2, 5, 5, 1, 5, 4, 6, 5, 2, 4, 2, 1, 6, 4, 6, 5,     // 1x
+            6, 6, 2, 1, 3, 3, 5, 5, 4, 2, 2, 1, 4, 4, 6, 5,     // 2x
+            2, 5, 5, 1, 4, 4, 6, 5, 2, 4, 2, 1, 4, 4, 6, 5,     // 3x
+            6, 6, 2, 1, 3, 3, 5, 5, 3, 2, 2, 1, 3, 4, 6, 5,     // 4x
+            2, 5, 5, 1, 4, 4, 6, 5, 2, 4, 3, 1, 8, 4, 6, 5,     // 5x
+            6, 6, 2, 1, 3, 3, 5, 5, 4, 2, 2, 1, 6, 4, 6, 5,     // 6x
+            2, 5, 5, 1, 4, 4, 6, 5, 2, 4, 4, 1, 6, 4, 6, 5,     // 7x
+            3, 6, 2, 1, 3, 3, 3, 5, 2, 2, 2, 1, 4, 4, 4, 5,     // 8x
+            2, 6, 5, 1, 4, 4, 4, 5, 2, 5, 2, 1, 4, 5, 5, 5,     // 9x
+            2, 6, 2, 1, 3, 3, 3, 5, 2, 2, 2, 1, 4, 4, 4, 5,     // Ax
+            2, 5, 5, 1, 4, 4, 4, 5, 2, 4, 2, 1, 4, 4, 4, 5,     // Bx
+            2, 6, 2, 1, 3, 3, 5, 5, 2, 2, 2, 3, 4, 4, 6, 5,     // Cx
+            2, 5, 5, 1, 4, 4, 6, 5, 2, 4, 3, 3, 4, 4, 7, 5,     // Dx
+            2, 6, 2, 1, 3, 3, 5, 5, 2, 2, 2, 1, 4, 4, 6, 5,     // Ex
+            2, 5, 5, 1, 4, 4, 6, 5, 2, 4, 4, 1, 4, 4, 7, 5      // Fx
+        };
+
+        // Cycles a command may take beyond command_cycles, one bit each
+        enum st_penalty : byte_t
+        {
+            PAGE_PENALTY    = 0x01,     // Indexed operand or branch target on another page
+            BRANCH_PENALTY  = 0x02,     // Branch taken
+            DECIMAL_PENALTY = 0x04      // ADC and SBC with the D flag set
+        };
+
+        static constexpr std::array<byte_t, 0x100> command_penalties {
+        //  x0 x1 x2 x3 x4 x5 x6 x7 x8 x9 xA xB xC xD xE xF
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3,     // 0x
+            3, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 1, 3,     // 1x
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3,     // 2x
+            3, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 1, 1, 3,     // 3x
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3,     // 4x
+            3, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 1, 3,     // 5x
+            0, 4, 0, 0, 0, 4, 0, 0, 0, 4, 0, 0, 0, 4, 0, 3,     // 6x
+            3, 5, 4, 0, 0, 4, 0, 0, 0, 5, 0, 0, 0, 5, 1, 3,     // 7x
+            1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3,     // 8x
+            3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3,     // 9x
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3,     // Ax
+            3, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 1, 1, 3,     // Bx
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3,     // Cx
+            3, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 3,     // Dx
+            0, 4, 0, 0, 0, 4, 0, 0, 0, 4, 0, 0, 0, 4, 0, 3,     // Ex
+            3, 5, 4, 0, 0, 4, 0, 0, 0, 5, 0, 0, 0, 5, 0, 3      // Fx
+        };
+
+        // Fewest and most cycles of a command, the most paying every penalty it has
+        static constexpr std::size_t min_cycles(const st_command command) noexcept
+        { return command_cycles[static_cast<byte_t>(command)]; }
+
+        static constexpr std::size_t max_cycles(const st_command command) noexcept
+        { return min_cycles(command) + std::popcount(command_penalties[static_cast<byte_t>(command)]); }
+
         serializable_token(const st_kind token_kind);
 
-        st_kind             kind() const noexcept;
-        st_command          command() const noexcept;
-        std::vector<word_t> byteline() const noexcept;
-        word_t              number() const noexcept;
-        bool                labelable() const noexcept;
+        st_kind                    kind() const noexcept;
+        st_command                 command() const noexcept;
+        const std::vector<word_t> &byteline() const noexcept;
+        word_t                     number() const noexcept;
+        bool                       labelable() const noexcept;
+        std::span<const byte_t>    binary() const noexcept;
+        uint32_t                   row() const noexcept;
 
         void kind(const st_kind token_kind) noexcept;
         void command(const st_command token_command) noexcept;
         void byteline(std::vector<word_t> line) noexcept;
         void number(const word_t value) noexcept;
         void labelable(const bool value) noexcept;
+        // Bytes of an included file, kept mapped as long as a token refers to it
+        void binary(std::shared_ptr<const source_file> file, std::span<const byte_t> bytes) noexcept;
+        // Source row the token comes from
+        void row(const uint32_t value) noexcept;
 
     private:
-        st_kind             m_kind;
-        st_command          m_command;
-        std::vector<word_t> m_byteline;
-        word_t              m_number;
-        bool                m_labelable;
+        st_kind                            m_kind;
+        st_command                         m_command     {st_command::BRK_stk};
+        std::vector<word_t>                m_byteline;
+        word_t                             m_number      {0};
+        bool                               m_labelable   {false};
+        std::shared_ptr<const source_file> m_binary_file {};
+        std::span<const byte_t>            m_binary      {};
+        uint32_t                           m_row         {0};
     };
 }
@@ -8,28 +8,69 @@
 #pragma once
 
 #include <vector>
-#include <map>
-#include <set>
 
+#include "diagnostic.hpp"
 #include "serializable_token.hpp"
+#include "instruction_set.hpp"
+#include "memory_image.hpp"
+#include "source_map.hpp"
 
 
 namespace mxasm
 {
+    // Choices of the encoder that change the bytes of a program
+    struct encoding_options
+    {
+        bool zero_page    {true};   // Absolute label operands under $100 take the zero page form
+        bool relax        {true};   // Branches out of reach go over a JMP, a BRA out of reach is a JMP
+        bool shrink_jumps {false};  // A JMP within reach on its page is a BRA, which moves the code after it
+    };
+
     class serializer
     {
     public:
-        explicit serializer(std::list<serializable_token> &tokens);
-        std::vector<byte_t> binary_program();
+        explicit serializer(const std::vector<serializable_token> &tokens, const encoding_options &encoding = {});
+        // Fills the rows and label addresses of the map, when there is one.
+        // Throws the diagnostic_list of operands that can't be encoded, like branches out of reach without relaxing
+        memory_image binary_program(source_map *map = nullptr);
 
     private:
-        const std::list<serializable_token> m_tokens;
-        std::vector<byte_t>                 m_program       {};
-        word_t                              m_write_address {0x0600};
-        word_t                              m_end_of_program {0};
+        static constexpr word_t START_ADDRESS = 0x0600;
+
+        enum class command_form : byte_t
+        {
+            SHORT,          // The command itself
+            LONG_BRANCH     // Branch on the opposite condition over a JMP to the target
+        };
+
+        // What the layout needs of a token, small enough to go over the program again and again
+        struct layout_item
+        {
+            serializable_token::st_kind kind;
+            uint32_t                    value;      // Label id, code position or size
+        };
+
+        const std::vector<serializable_token> &m_tokens;
+        const encoding_options                 m_encoding;
+        memory_image                           m_image          {};
+        std::vector<serializable_token::st_command> m_commands;    // Command of every token, once relaxed
+        std::vector<command_form>              m_forms;
+        std::vector<layout_item>               m_layout;
+        std::vector<word_t>                    m_addresses;        // Of every token, from the last layout
+        std::vector<word_t>                    m_label_address;    // By label id, final once relaxed
+        word_t                                 m_write_address  {START_ADDRESS};
+        source_map                            *m_map            {nullptr};
+        uint32_t                               m_row            {source_map::NO_ROW};
+        diagnostic_list                        m_diagnostics    {};
 
+        std::size_t         command_size(std::size_t token) const noexcept;
+        void layout();
+        void relax_commands();
+        bool relax_command(std::size_t token, bool &pinned);
         void serialize();
         void write_byte_to_memory(const byte_t value);
         void write_word_to_memory(const word_t value);
+        void write_relative(const word_t target);
+        void write_pointer(const word_t target);
     };
 }
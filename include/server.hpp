@@ -0,0 +1,37 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |             Server            |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "assembler.hpp"
+
+
+namespace mxasm
+{
+    // Resident assembler on a Unix domain socket. Every message is a little-endian
+    // u32 payload length followed by the payload.
+    //
+    // Request:   'P' + source path (absolute, or relative to the server)
+    //            'T' + source text
+    //            'Q'   stops the server
+    // Response:  the result in the form of encode_result()
+    //
+    // A connection may carry any number of requests, and every connection is served on a
+    // thread of its own. Results are cached by file path, size and modification time, or by
+    // the whole source text
+    int run_server(const std::string &socket_path, const pipeline_options &pipeline);
+
+    // Sends every path to a running server, the results come back in the same order
+    std::vector<assembly_result> request_assembly(const std::string &socket_path,
+                                                  const std::vector<std::string> &source_paths);
+
+    // $XDG_RUNTIME_DIR/mxasm.sock, or /tmp/mxasm-<uid>.sock
+    std::string default_socket_path();
+}
@@ -0,0 +1,59 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |          Source File          |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "util.hpp"
+
+
+namespace mxasm
+{
+    class source_file
+    {
+    public:
+        explicit source_file(const std::string &file_path);
+        source_file(source_file &&other) noexcept;
+        source_file(const source_file &) = delete;
+        ~source_file();
+
+        // Source held in memory, e.g. text sent to the server
+        static source_file from_text(std::string text);
+        // Source in memory owned by the caller, which must outlive the source file
+        static source_file from_view(std::string_view text);
+        // Binary file, e.g. an .incbin asset: mapped like a source, but not split into lines
+        static source_file binary(const std::string &file_path);
+
+        source_file &operator=(source_file &&other) noexcept;
+        source_file &operator=(const source_file &) = delete;
+
+        std::string_view                text() const noexcept;
+        const source_listing           &lines() const noexcept;
+        const std::vector<std::size_t> &line_offsets() const noexcept;
+
+    private:
+        source_file() = default;
+
+        const char              *m_data        {nullptr};
+        std::size_t              m_size        {0};
+        bool                     m_is_mapped   {false};
+        bool                     m_is_view     {false};
+        std::string              m_buffer      {};
+        source_listing           m_lines       {};
+        std::vector<std::size_t> m_line_offsets {};
+
+        void map_file(const std::string &file_path);
+        void read_file(const std::string &file_path);
+        // Reads to the end, for what has no size to map
+        void read_descriptor(int descriptor, const std::string &file_path);
+        void index_lines();
+        void release() noexcept;
+    };
+}
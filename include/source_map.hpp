@@ -0,0 +1,43 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |           Source Map          |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "util.hpp"
+#include "source_file.hpp"
+
+
+namespace mxasm
+{
+    // Where the bytes of a program come from, for the tools that run it
+    struct source_map
+    {
+        static constexpr uint32_t NO_ROW = 0;
+
+        struct label
+        {
+            std::string name    {};
+            word_t      address {0};
+            uint32_t    row     {NO_ROW};
+            bool        placed  {false};    // Declared in the program, never for macros
+        };
+
+        std::vector<uint32_t>    rows     {};   // Source row of every address, NO_ROW where nothing was written
+        std::vector<word_t>      commands {};   // Address of every command, in source order
+        std::vector<label>       labels   {};   // By label id
+        std::vector<std::string> lines    {};   // Source text by row - 1
+
+        void             add_lines(const source_file &source);
+        std::string_view row_text(uint32_t row) const noexcept;
+        // Ids of the placed labels, lowest address first
+        std::vector<std::size_t> labels_by_address() const;
+    };
+}
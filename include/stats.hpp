@@ -0,0 +1,73 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |           Statistics          |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace mxasm
+{
+    // Heap use of the calling thread. Counted only when the program links the
+    // replacement operator new from allocation_hooks.cpp, zero otherwise
+    struct allocation_count
+    {
+        std::uint64_t allocations {0};
+        std::uint64_t bytes       {0};
+    };
+
+    allocation_count thread_allocations() noexcept;
+    void             count_allocation(std::size_t bytes) noexcept;
+
+
+    // Wall time, tokens and heap use of every pipeline phase of one source file
+    class assembly_stats
+    {
+    public:
+        struct phase
+        {
+            std::string   name;
+            double        milliseconds {0};
+            std::size_t   tokens       {0};
+            std::uint64_t allocations  {0};
+            std::uint64_t bytes        {0};
+        };
+
+        // Measures from construction to destruction, does nothing without stats
+        class timer
+        {
+        public:
+            timer(assembly_stats *stats, std::string_view name) noexcept;
+            timer(const timer &) = delete;
+            timer &operator=(const timer &) = delete;
+            ~timer();
+
+            void set_tokens(const std::size_t tokens) noexcept { m_tokens = tokens; }
+
+        private:
+            assembly_stats                        *m_stats;
+            std::string_view                       m_name;
+            std::size_t                            m_tokens {0};
+            std::chrono::steady_clock::time_point  m_start;
+            allocation_count                       m_start_allocations;
+        };
+
+        const std::vector<phase> &phases() const noexcept;
+        phase                     total() const noexcept;
+
+    private:
+        std::vector<phase> m_phases;
+    };
+
+    // A table per file, or one JSON document for all of them
+    std::string stats_to_text(const std::vector<std::string> &paths, const std::vector<assembly_stats> &stats);
+    std::string stats_to_json(const std::vector<std::string> &paths, const std::vector<assembly_stats> &stats);
+}
@@ -0,0 +1,41 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |          Thread Pool          |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+
+namespace mxasm
+{
+    // Work-stealing pool for a known set of jobs. Every worker takes jobs from the back of
+    // its own queue, and steals from the front of the others when it runs dry
+    class thread_pool
+    {
+    public:
+        explicit thread_pool(const std::size_t thread_count);
+
+        void run(const std::size_t job_count, const std::function<void(std::size_t)> &job);
+
+        std::size_t thread_count() const noexcept;
+
+    private:
+        struct job_queue
+        {
+            std::mutex              lock;
+            std::deque<std::size_t> jobs;
+        };
+
+        std::size_t m_thread_count;
+
+        static bool take_own(job_queue &queue, std::size_t &job);
+        static bool steal(job_queue &queue, std::size_t &job);
+    };
+}
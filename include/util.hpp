@@ -9,10 +9,10 @@
 
 #include <vector>
 #include <string>
-#include <list>
+#include <string_view>
 #include <fstream>
 #include <memory>
-#include <cmath>
+#include <algorithm>
 
 #include "exceptions/arguments_exception.hpp"
 
@@ -21,17 +21,42 @@ namespace mxasm
 {
     typedef uint8_t  byte_t;
     typedef uint16_t word_t;
-    typedef std::list<std::pair<std::size_t, std::string>> source_listing;
-    typedef std::list<std::unique_ptr<mxasm_exception>>    exception_list;
 
-    std::string    get_source_file_path_from_cmd(const std::vector<std::string> &arguments);
-    source_listing open_source_code(const std::string file_path);
-    void           write_program_to_file(const std::vector<byte_t> &program, const std::string out_name);
+    struct source_line
+    {
+        std::size_t      number;
+        std::string_view text;
+    };
+
+    typedef std::vector<source_line> source_listing;
+
+    // Hash and equality for case-insensitive lookup of label and macro names
+    struct case_insensitive_hash
+    {
+        std::size_t operator()(const std::string_view str) const noexcept;
+    };
+
+    struct case_insensitive_equal
+    {
+        bool operator()(const std::string_view lhs, const std::string_view rhs) const noexcept;
+    };
+
 
     std::string to_lower(const std::string &default_string);
     std::string to_upper(const std::string &default_string);
 
+    // Little-endian fields of the server protocol and cache files
+    void     append_u16(std::string &out, const uint16_t value);
+    void     append_u32(std::string &out, const uint32_t value);
+    void     append_u64(std::string &out, const uint64_t value);
+    uint16_t read_u16(const char *data) noexcept;
+    uint32_t read_u32(const char *data) noexcept;
+    uint64_t read_u64(const char *data) noexcept;
+
     uint8_t  get_char_digit_value(const char c) noexcept;
-    uint64_t string_to_number(const std::string str, const uint8_t base) noexcept;
-    
+
+    // Digits are checked by the lexer. A value over 64 bits comes back as UINT64_MAX,
+    // which every size check rejects
+    uint64_t string_to_number(std::string_view str, const uint8_t base) noexcept;
+
 }
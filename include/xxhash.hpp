@@ -0,0 +1,18 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |             xxHash            |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+
+namespace mxasm
+{
+    // XXH64 of the bytes, same values as the reference implementation
+    std::uint64_t xxhash64(std::string_view data, std::uint64_t seed = 0) noexcept;
+}
@@ -0,0 +1,35 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |        Allocation Hooks       |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <cstdlib>
+#include <new>
+
+#include "../include/stats.hpp"
+
+// Replacement global operator new and delete that feed thread_allocations().
+// The array and nothrow forms of the standard library forward to these
+
+
+void *operator new(std::size_t size)
+{
+    if (size == 0) size = 1;
+    while (true) {
+        if (void *memory = std::malloc(size)) {
+            mxasm::count_allocation(size);
+            return memory;
+        }
+        const auto handler = std::get_new_handler();
+        if (handler == nullptr) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void operator delete(void *memory) noexcept
+{ std::free(memory); }
+
+void operator delete(void *memory, std::size_t) noexcept
+{ std::free(memory); }
@@ -0,0 +1,280 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |           Assembler           |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+#include "../include/assembler.hpp"
+#include "../include/assembly_cache.hpp"
+#include "../include/options.hpp"
+#include "../include/lexer.hpp"
+#include "../include/parser.hpp"
+#include "../include/serializer.hpp"
+#include "../include/listing.hpp"
+
+//#define DEBUG_INPUT
+//#define DEBUG_LEXER
+
+using namespace mxasm;
+
+
+namespace
+{
+    // Turns every error thrown by the pipeline into a failed result with its diagnostics
+    template<typename Pipeline>
+    assembly_result run_reported(Pipeline &&pipeline)
+    {
+        assembly_result failed {EXIT_FAILURE, {}, {}};
+        try {
+            return pipeline();
+
+        } catch (const mxasm_exception &ex) {
+            failed.diagnostics.add(diagnostic_code::ARGUMENTS_ERROR, 0, 0, ex.message());
+        } catch (const std::exception &ex) {
+            failed.diagnostics.add(diagnostic_code::SYSTEM_ERROR, 0, 0, ex.what());
+        } catch (diagnostic_list &errors) {
+            failed.diagnostics = std::move(errors);
+        }
+        return failed;
+    }
+
+    void append_string(std::string &out, const std::string_view str)
+    {
+        append_u32(out, static_cast<uint32_t>(str.size()));
+        out += str;
+    }
+
+    bool read_string(const std::string_view encoded, std::size_t &pos, std::string_view &str)
+    {
+        if (encoded.size() - pos < 4) return false;
+        const uint32_t size = read_u32(encoded.data() + pos);
+        pos += 4;
+        if (encoded.size() - pos < size) return false;
+        str = encoded.substr(pos, size);
+        pos += size;
+        return true;
+    }
+
+    source_file read_source(const std::string &source_path, assembly_stats *stats)
+    {
+        assembly_stats::timer timer(stats, "source_file");
+        source_file program_source(source_path);
+        timer.set_tokens(program_source.lines().size());
+        return program_source;
+    }
+
+    // Assets of a file are looked up next to it
+    pipeline_options source_pipeline(const std::string &source_path, pipeline_options pipeline)
+    {
+        const auto directory = std::filesystem::path(source_path).parent_path();
+        pipeline.asset_directory = directory.empty() ? "." : directory.string();
+        return pipeline;
+    }
+
+    // A hit skips the lexer, the parser and the serializer
+    assembly_result cached_assemble_file(const std::string &source_path, const pipeline_options &pipeline,
+                                         assembly_cache &cache, assembly_stats *stats)
+    {
+        return run_reported([&] {
+            const source_file program_source = read_source(source_path, stats);
+            std::uint64_t key;
+            {
+                assembly_stats::timer timer(stats, "assembly_cache::find");
+                key = cache.key(program_source.text());
+                if (auto cached = cache.find(key, program_source.text())) return std::move(*cached);
+            }
+
+            auto result = assemble_source(program_source, source_pipeline(source_path, pipeline), stats);
+            if (not result.is_reproducible()) return result;    // The key covers the source text only
+
+            assembly_stats::timer timer(stats, "assembly_cache::store");
+            cache.store(key, program_source.text(), result);
+            return result;
+        });
+    }
+}
+
+
+std::string             assembly_result::
+report() const
+{
+    if (diagnostics.empty()) return {};
+
+    std::string report = "ERROR!\n";
+    for (const auto &error : diagnostics) {
+        const auto type = error.type();
+        if (not type.empty()) report += type + ": ";
+        report += diagnostics.message(error) + '\n';
+    }
+    return report;
+}
+
+bool                    assembly_result::
+is_reproducible() const noexcept
+{
+    if (not assets.empty()) return false;
+    return std::none_of(diagnostics.begin(), diagnostics.end(), [](const diagnostic &error) {
+        return error.code == diagnostic_code::ARGUMENTS_ERROR or error.code == diagnostic_code::SYSTEM_ERROR;
+    });
+}
+
+
+assembly_result         mxasm::
+assemble(const std::string_view source, const pipeline_options &pipeline, assembly_stats *stats)
+{
+    return run_reported([&] {
+        const auto program_source = source_file::from_view(source);
+        return assemble_source(program_source, pipeline, stats);
+    });
+}
+
+assembly_result         mxasm::
+assemble_source(const source_file &source, const pipeline_options &pipeline, assembly_stats *stats,
+                source_map *map)
+{
+    return run_reported([&] {
+#ifdef DEBUG_INPUT
+        for (const auto &[num, str] : source.lines()) {
+            std::cout << std::setw(5) << num << ": ";
+            std::cout << str << '\n';
+        }
+#endif
+
+        lexer tokenizer(source.lines(), pipeline.max_errors);
+        const auto &lexed_tokens = [&]() -> const auto & {
+            assembly_stats::timer timer(stats, "lexer::tokenize");
+            const auto &tokens = tokenizer.tokens();
+            timer.set_tokens(tokens.size());
+            return tokens;
+        }();
+
+#ifdef DEBUG_LEXER
+        for (const auto &token : lexed_tokens) {
+            std::cout << "[" << std::setw(4) << token.row() << ", " << std::setw(4) << token.column() << "]: ";
+            std::cout << std::setw(20) << token.kind()  << ": " << token.lexeme() << '\n';
+        }
+#endif
+
+        parser lex_parser(lexed_tokens, pipeline.max_errors, stats, pipeline.asset_directory);
+        const auto &parsed_tokens = lex_parser.tokens();
+
+        assembly_stats::timer timer(stats, "serializer::serialize");
+        timer.set_tokens(parsed_tokens.size());
+        if (map != nullptr) {
+            *map = {};
+            map->add_lines(source);
+            for (auto &name : lex_parser.label_names()) {
+                map->labels.push_back({std::move(name)});
+            }
+        }
+        serializer encoder(parsed_tokens, pipeline.encoding);
+        return assembly_result{EXIT_SUCCESS, {}, encoder.binary_program(map), lex_parser.assets()};
+    });
+}
+
+assembly_result         mxasm::
+assemble_file(const std::string &source_path, const pipeline_options &pipeline, assembly_stats *stats,
+              source_map *map)
+{
+    return run_reported([&] {
+        const source_file program_source = read_source(source_path, stats);
+        return assemble_source(program_source, source_pipeline(source_path, pipeline), stats, map);
+    });
+}
+
+assembly_result         mxasm::
+assemble_file(const std::string &source_path, const pipeline_options &pipeline, const write_options &output,
+              assembly_cache *cache, assembly_stats *stats)
+{
+    return run_reported([&] {
+        // The cache keeps images only, the listing needs the map of a fresh assembly
+        source_map map;
+        auto result = output.listing  ? assemble_file(source_path, pipeline, stats, &map)
+                    : cache != nullptr ? cached_assemble_file(source_path, pipeline, *cache, stats)
+                                       : assemble_file(source_path, pipeline, stats);
+        if (result.exit_code == EXIT_SUCCESS) {
+            assembly_stats::timer timer(stats, "write_program_to_file");
+            write_program_to_file(result.image, get_output_path(source_path), output);
+        }
+        if (result.exit_code == EXIT_SUCCESS and output.listing) {
+            assembly_stats::timer timer(stats, "write_listing");
+            write_listing(result.image, map, get_listing_path(source_path));
+        }
+        return result;
+    });
+}
+
+
+std::string             mxasm::
+encode_result(const assembly_result &result)
+{
+    const auto segments = result.image.segments();
+
+    std::string encoded;
+    encoded.push_back(static_cast<char>(result.exit_code));
+    append_u32(encoded, static_cast<uint32_t>(segments.size()));
+    for (const auto &range : segments) {
+        append_u16(encoded, range.address);
+        append_u32(encoded, static_cast<uint32_t>(range.size));
+        for (const auto chunk : result.image.chunks(range)) {
+            encoded.append(reinterpret_cast<const char *>(chunk.data()), chunk.size());
+        }
+    }
+    append_u32(encoded, static_cast<uint32_t>(result.diagnostics.size()));
+    for (const auto &error : result.diagnostics) {
+        encoded.push_back(static_cast<char>(error.code));
+        append_u32(encoded, error.row);
+        append_u32(encoded, error.column);
+        append_string(encoded, result.diagnostics.argument(error));
+    }
+    return encoded;
+}
+
+std::optional<assembly_result>  mxasm::
+decode_result(const std::string_view encoded)
+{
+    if (encoded.size() < 5) return std::nullopt;
+
+    assembly_result result;
+    result.exit_code = static_cast<byte_t>(encoded[0]);
+    const uint32_t segment_count = read_u32(encoded.data() + 1);
+
+    std::size_t pos = 5;
+    for (uint32_t i = 0; i < segment_count; ++i) {
+        if (encoded.size() - pos < 6) return std::nullopt;
+        const word_t   address = read_u16(encoded.data() + pos);
+        const uint32_t size    = read_u32(encoded.data() + pos + 2);
+        pos += 6;
+        if (encoded.size() - pos < size or address + size > 0x10000) return std::nullopt;
+
+        for (uint32_t offset = 0; offset < size; ++offset) {
+            result.image.write(static_cast<word_t>(address + offset), static_cast<byte_t>(encoded[pos + offset]));
+        }
+        pos += size;
+    }
+
+    if (encoded.size() - pos < 4) return std::nullopt;
+    const uint32_t diagnostic_count = read_u32(encoded.data() + pos);
+    pos += 4;
+    for (uint32_t i = 0; i < diagnostic_count; ++i) {
+        if (encoded.size() - pos < 9) return std::nullopt;
+        const auto     code   = static_cast<diagnostic_code>(encoded[pos]);
+        const uint32_t row    = read_u32(encoded.data() + pos + 1);
+        const uint32_t column = read_u32(encoded.data() + pos + 5);
+        pos += 9;
+        std::string_view argument;
+        if (code > diagnostic_code::BRANCH_OUT_OF_REACH or not read_string(encoded, pos, argument)) {
+            return std::nullopt;
+        }
+        result.diagnostics.add(code, row, column, argument);
+    }
+    if (pos != encoded.size()) return std::nullopt;
+    return result;
+}
@@ -0,0 +1,185 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |         Assembly Cache        |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#if defined(__unix__) or defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#include "../include/assembly_cache.hpp"
+#include "../include/xxhash.hpp"
+
+using namespace mxasm;
+
+
+namespace
+{
+    constexpr std::string_view ENTRY_MAGIC     = "MXC5";
+    constexpr std::string_view ENTRY_EXTENSION = ".mxc";
+
+    std::string temporary_suffix()
+    {
+        static std::atomic<unsigned> counter {0};
+#if defined(__unix__) or defined(__APPLE__)
+        const auto pid = static_cast<long>(getpid());
+#else
+        const long pid = 0;
+#endif
+        return ".tmp." + std::to_string(pid) + "." + std::to_string(counter++);
+    }
+}
+
+
+assembly_cache::
+assembly_cache(std::filesystem::path directory, const std::uint64_t max_size, const std::string_view fingerprint)
+    : m_directory {std::move(directory)},
+      m_max_size  {max_size},
+      m_seed      {xxhash64(fingerprint)}
+{
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+    if (error or not std::filesystem::is_directory(m_directory, error)) {
+        throw arguments_exception("Can't create cache directory '" + m_directory.string() + "'");
+    }
+}
+
+
+std::uint64_t           assembly_cache::
+key(const std::string_view source) const noexcept
+{ return xxhash64(source, m_seed); }
+
+std::optional<assembly_result>  assembly_cache::
+find(const std::uint64_t key, const std::string_view source)
+{
+    const auto path = entry_path(key);
+    std::ifstream entry(path, std::ios_base::binary);
+    const std::string contents = entry.is_open()
+        ? std::string(std::istreambuf_iterator<char>(entry), std::istreambuf_iterator<char>())
+        : std::string();
+
+    // Magic, key, source length and check hash
+    const std::size_t header_size = ENTRY_MAGIC.size() + 3 * sizeof(std::uint64_t);
+    const char *header = contents.data() + ENTRY_MAGIC.size();
+    if (contents.size() >= header_size and contents.starts_with(ENTRY_MAGIC)
+        and read_u64(header) == key and read_u64(header + 8) == source.size()
+        and read_u64(header + 16) == check_hash(source)) {
+        if (auto result = decode_result(std::string_view(contents).substr(header_size))) {
+            // The modification time orders entries for eviction
+            std::error_code error;
+            std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+            ++m_hits;
+            return result;
+        }
+    }
+    ++m_misses;
+    return std::nullopt;
+}
+
+void                    assembly_cache::
+store(const std::uint64_t key, const std::string_view source, const assembly_result &result)
+{
+    if (not result.is_reproducible()) return;
+
+    std::string contents(ENTRY_MAGIC);
+    append_u64(contents, key);
+    append_u64(contents, source.size());
+    append_u64(contents, check_hash(source));
+    contents += encode_result(result);
+
+    // A failed store only costs a later miss
+    const auto path = entry_path(key);
+    auto temporary  = path;
+    temporary += temporary_suffix();
+    {
+        std::ofstream entry(temporary, std::ios_base::binary | std::ios_base::trunc);
+        if (not entry.write(contents.data(), static_cast<std::streamsize>(contents.size()))) {
+            entry.close();
+            std::error_code error;
+            std::filesystem::remove(temporary, error);
+            return;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) std::filesystem::remove(temporary, error);
+}
+
+void                    assembly_cache::
+trim()
+{
+    struct cached_entry
+    {
+        std::filesystem::path           path;
+        std::uint64_t                   size;
+        std::filesystem::file_time_type used;
+    };
+
+    std::vector<cached_entry> entries;
+    std::uint64_t total_size = 0;
+    std::error_code error;
+    for (const auto &file : std::filesystem::directory_iterator(m_directory, error)) {
+        if (file.path().extension() != ENTRY_EXTENSION) continue;
+        std::error_code file_error;
+        const auto size = file.file_size(file_error);
+        const auto used = file.last_write_time(file_error);
+        if (file_error) continue;
+        entries.push_back({file.path(), size, used});
+        total_size += size;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.used < rhs.used;
+    });
+    auto oldest = entries.begin();
+    for (; oldest != entries.end() and total_size > m_max_size; ++oldest) {
+        std::filesystem::remove(oldest->path, error);
+        total_size -= oldest->size;
+        ++m_evictions;
+    }
+
+    m_entries = static_cast<std::size_t>(entries.end() - oldest);
+    m_bytes   = total_size;
+}
+
+assembly_cache::statistics  assembly_cache::
+stats() const noexcept
+{ return {m_hits.load(), m_misses.load(), m_evictions, m_entries, m_bytes}; }
+
+
+std::filesystem::path   assembly_cache::
+entry_path(const std::uint64_t key) const
+{
+    static constexpr char digits[] = "0123456789abcdef";
+    std::string name(16, '0');
+    for (std::size_t i = 0; i < 16; ++i) {
+        name[15 - i] = digits[(key >> (i * 4)) & 0xF];
+    }
+    return m_directory / (name + std::string(ENTRY_EXTENSION));
+}
+
+// Second hash of the source, on a seed of its own, so it doesn't collide along with the key
+std::uint64_t           assembly_cache::
+check_hash(const std::string_view source) const noexcept
+{ return xxhash64(source, ~m_seed); }
+
+
+std::string             mxasm::
+default_cache_directory()
+{
+    if (const char *cache_home = std::getenv("XDG_CACHE_HOME"); cache_home != nullptr and *cache_home != '\0') {
+        return std::string(cache_home) + "/mxasm";
+    }
+    if (const char *home = std::getenv("HOME"); home != nullptr and *home != '\0') {
+        return std::string(home) + "/.cache/mxasm";
+    }
+    return ".mxasm-cache";
+}
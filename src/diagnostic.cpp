@@ -0,0 +1,142 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |           Diagnostic          |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <array>
+#include <string_view>
+
+#include "../include/diagnostic.hpp"
+
+using namespace mxasm;
+
+
+namespace
+{
+    // %r - row, %c - column, %a - argument
+    constexpr auto FORMATS = std::to_array<std::string_view>({
+        "%a",
+        "%a",
+        "Too many errors, only the first %a are shown",
+
+        "Unexpected token at [%r, %c]:\n%a",
+
+        "Unexpected token at [%r, %c]:\n%a",
+        "Error at [%r, %c]:\nUnknown DIRECTIVE %a",
+        "Unknown token at [%r, %c]:\nCommand can starts from OPCODE, LABEL DECLARATION, or DIRECTIVE, but %a was found",
+        "Error at line %r:\nLine can starts from DIRECTIVE, LABEL DECLARATION, or OPCODE, but %a was found",
+        "Error at line %r:\nA NEW LINE was expected, but %a was found",
+        "Error at line %r:\nExpected NEW LINE, OPCODE, or DIRECTIVE, but %a was found",
+        "Error at [%r, %c]: Expected NEW LINE, OPCODE, or DIRECTIVE, but REGISTER NAME was found",
+        "Error at line %r:\nAn IDENTIFIER was expected, but NEW LINE was found",
+        "Error at [%r, %c]:\nAn IDENTIFIER was expected, but %a was found",
+        "Error at line %r:\nA NUMBER was expected, but NEW LINE was found",
+        "Error at [%r, %c]:\nA NUMBER was expected, but %a was found",
+        "Error at line %r:\nA '=' was expected, but NEW LINE was found",
+        "Error at [%r, %c]:\nA '=' was expected, but %a was found",
+        "Error at line %r:\nA NUMBER or STRING was expected, but NEW LINE was found",
+        "Error at [%r, %c]:\nA NUMBER or STRING was expected, but %a was found",
+        "Error at [%r, %c]:\nA COMMA was expected, but %a was found",
+        "Error at [%r, %c]:\nA NEW LINE was expected, but %a was found",
+        "Error at [%r, %c]:\nMaximal CONSTANT size is 0xFF'FF",
+        "Error at [%r, %c]:\nNumerical constant can't be greater than 0xFF'FF",
+        "Error at [%r, %c]:\nConstant, defined by BYTE should not be greater than 0xFF",
+        "Error at [%r, %c]:\nConstant, defined by WORD should not be greater than 0xFF'FF",
+        "Error at line %r\nRepeated declaration of macro: %a",
+        "Error at line %r:\nLabel %a is actually exists",
+        "Error at [%r, %c]: Non-existed label call\n%a",
+        "Error at line %r:\nUnavailable addressing mode for %a",
+        "Error at line %r:\nA STRING with the file name was expected, but NEW LINE was found",
+        "Error at [%r, %c]:\nA STRING with the file name was expected, but %a was found",
+        "Error at [%r, %c]:\nCan't read binary file %a",
+        "Error at [%r, %c]:\nOffset and length are out of binary file %a",
+        "Error at [%r, %c]:\nBinary file %a doesn't fit into 64 KiB of memory",
+        "Error at [%r, %c]:\nBinary file %a can't be included, the source has no directory for assets",
+
+        "Error at line %r:\nA pointer in parentheses must be in the zero page, but the label is at %a",
+        "Error at line %r:\nBranch target is %a bytes away, out of reach without relaxing"
+    });
+    static_assert(FORMATS.size() == static_cast<std::size_t>(diagnostic_code::BRANCH_OUT_OF_REACH) + 1);
+}
+
+
+std::string             diagnostic::
+type() const
+{
+    switch (code) {
+        case diagnostic_code::ARGUMENTS_ERROR:        return "arguments_exception";
+        case diagnostic_code::SYSTEM_ERROR:
+        case diagnostic_code::TOO_MANY_ERRORS:        return {};
+        case diagnostic_code::LEXER_UNEXPECTED_TOKEN: return "lexer_exception";
+        case diagnostic_code::ZERO_PAGE_EXPECTED:
+        case diagnostic_code::BRANCH_OUT_OF_REACH:    return "serializer_exception";
+        default:                                      return "parser_exception";
+    }
+}
+
+diagnostic_list::
+diagnostic_list(const diagnostic_code code, const std::string_view message)
+{ add(code, 0, 0, message); }
+
+
+void                    diagnostic_list::
+add(const diagnostic_code code, const uint32_t row, const uint32_t column, const std::string_view argument)
+{
+    m_records.push_back({code, row, column, static_cast<uint32_t>(m_arguments.size()),
+                         static_cast<uint32_t>(argument.size())});
+    m_arguments += argument;
+}
+
+void                    diagnostic_list::
+clear() noexcept
+{
+    m_records.clear();
+    m_arguments.clear();
+}
+
+
+std::string_view        diagnostic_list::
+argument(const diagnostic &error) const noexcept
+{ return std::string_view(m_arguments).substr(error.argument_offset, error.argument_size); }
+
+std::string             diagnostic_list::
+message(const diagnostic &error) const
+{
+    const auto format   = FORMATS[static_cast<std::size_t>(error.code)];
+    const auto argument = this->argument(error);
+
+    std::string text;
+    text.reserve(format.size() + argument.size() + 8);
+    for (std::size_t i = 0; i < format.size(); ++i) {
+        if (format[i] != '%' or i + 1 == format.size()) {
+            text += format[i];
+            continue;
+        }
+        switch (format[++i]) {
+            case 'r': text += std::to_string(error.row);    break;
+            case 'c': text += std::to_string(error.column); break;
+            case 'a': text += argument;                     break;
+            default:  text += format[i];
+        }
+    }
+    return text;
+}
+
+
+std::size_t             diagnostic_list::
+size() const noexcept
+{ return m_records.size(); }
+
+bool                    diagnostic_list::
+empty() const noexcept
+{ return m_records.empty(); }
+
+diagnostic_list::const_iterator  diagnostic_list::
+begin() const noexcept
+{ return m_records.begin(); }
+
+diagnostic_list::const_iterator  diagnostic_list::
+end() const noexcept
+{ return m_records.end(); }
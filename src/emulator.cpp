@@ -0,0 +1,431 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |            Emulator           |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <utility>
+
+#include "../include/emulator.hpp"
+
+using namespace mxasm;
+using pt_opcode = parser_token::pt_opcode;
+using st_mode   = serializable_token::st_mode;
+
+
+namespace
+{
+    // Length of the NOP that runs on a byte without a command
+    std::size_t unused_command_size(const byte_t opcode) noexcept
+    {
+        if ((opcode & 0x0F) == 0x02) return 2;
+        if (opcode == 0x44 or opcode == 0x54 or opcode == 0xD4 or opcode == 0xF4) return 2;
+        if (opcode == 0x5C or opcode == 0xDC or opcode == 0xFC) return 3;
+        return 1;
+    }
+
+    // xorshift64*, the source of the bytes read from $FE
+    byte_t next_random(std::uint64_t &state) noexcept
+    {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return static_cast<byte_t>((state * 0x2545'F491'4F6C'DD1Dull) >> 56);
+    }
+
+    template<typename Opcode>
+    unsigned bit_number(const Opcode opcode, const Opcode first) noexcept
+    { return static_cast<unsigned>(opcode) - static_cast<unsigned>(first); }
+}
+
+
+emulator::
+emulator(const memory_image &image, const std::uint64_t seed)
+    : m_random {seed == 0 ? 0x9E37'79B9'7F4A'7C15ull : seed}
+{
+    for (const auto &range : image.segments()) {
+        image.copy(range, std::span(m_memory).subspan(range.address, range.size));
+    }
+}
+
+
+std::size_t             emulator::
+step()
+{
+    if (m_stopped != stop_reason::RUNNING) return 0;
+
+    const byte_t opcode = fetch();
+    m_page_crossed = false;
+    m_branch_taken = false;
+    if (const instruction *in = command_instructions[opcode]) {
+        execute(*in, operand_address(in->mode));
+    } else {
+        m_registers.pc += unused_command_size(opcode) - 1;
+    }
+
+    const byte_t penalties = serializable_token::command_penalties[opcode];
+    std::size_t cycles = serializable_token::command_cycles[opcode];
+    if (penalties & serializable_token::PAGE_PENALTY and m_page_crossed) ++cycles;
+    if (penalties & serializable_token::BRANCH_PENALTY and m_branch_taken) ++cycles;
+    if (penalties & serializable_token::DECIMAL_PENALTY and get_flag(DECIMAL)) ++cycles;
+    m_cycles += cycles;
+    return cycles;
+}
+
+emulator::stop_reason   emulator::
+run(const std::uint64_t cycle_limit)
+{
+    while (m_stopped == stop_reason::RUNNING and m_cycles < cycle_limit) {
+        step();
+    }
+    return m_stopped == stop_reason::RUNNING ? stop_reason::CYCLE_LIMIT : m_stopped;
+}
+
+void                    emulator::
+press_key(const byte_t key) noexcept
+{ m_memory[KEY_ADDRESS] = key; }
+
+bool                    emulator::
+take_screen_change() noexcept
+{ return std::exchange(m_screen_changed, false); }
+
+
+const emulator::registers&  emulator::
+state() const noexcept
+{ return m_registers; }
+
+std::uint64_t           emulator::
+cycles() const noexcept
+{ return m_cycles; }
+
+emulator::stop_reason   emulator::
+stopped() const noexcept
+{ return m_stopped; }
+
+byte_t                  emulator::
+peek(const word_t address) const noexcept
+{ return m_memory[address]; }
+
+std::span<const byte_t> emulator::
+screen() const noexcept
+{ return std::span(m_memory).subspan(SCREEN_ADDRESS, SCREEN_WIDTH * SCREEN_HEIGHT); }
+
+
+byte_t                  emulator::
+read(const word_t address) noexcept
+{
+    if (address == RANDOM_ADDRESS) m_memory[address] = next_random(m_random);
+    return m_memory[address];
+}
+
+void                    emulator::
+write(const word_t address, const byte_t value) noexcept
+{
+    m_memory[address] = value;
+    if (static_cast<word_t>(address - SCREEN_ADDRESS) < SCREEN_WIDTH * SCREEN_HEIGHT) m_screen_changed = true;
+}
+
+byte_t                  emulator::
+fetch() noexcept
+{ return read(m_registers.pc++); }
+
+word_t                  emulator::
+fetch_word() noexcept
+{
+    const byte_t low = fetch();
+    return static_cast<word_t>(low | fetch() << 8);
+}
+
+word_t                  emulator::
+read_zero_page_word(const byte_t address) noexcept
+{ return static_cast<word_t>(read(address) | read(static_cast<byte_t>(address + 1)) << 8); }
+
+void                    emulator::
+push(const byte_t value) noexcept
+{ write(0x0100 | m_registers.sp--, value); }
+
+byte_t                  emulator::
+pull() noexcept
+{ return read(0x0100 | ++m_registers.sp); }
+
+
+word_t                  emulator::
+operand_address(const st_mode mode) noexcept
+{
+    auto &r = m_registers;
+    switch (mode) {
+        case st_mode::IMP:
+        case st_mode::STK:
+        case st_mode::ACC: return 0;
+        case st_mode::IMM: return r.pc++;
+        case st_mode::ZPG:
+        case st_mode::ZPR: return fetch();
+        case st_mode::ZPX: return static_cast<byte_t>(fetch() + r.x);
+        case st_mode::ZPY: return static_cast<byte_t>(fetch() + r.y);
+        case st_mode::IZP: return read_zero_page_word(fetch());
+        case st_mode::IZX: return read_zero_page_word(static_cast<byte_t>(fetch() + r.x));
+        case st_mode::IZY: return indexed(read_zero_page_word(fetch()), r.y);
+        case st_mode::ABS: return fetch_word();
+        case st_mode::ABX: return indexed(fetch_word(), r.x);
+        case st_mode::ABY: return indexed(fetch_word(), r.y);
+        case st_mode::IND: {
+            const word_t pointer = fetch_word();         // No page wrap bug on the 65C02
+            return static_cast<word_t>(read(pointer) | read(pointer + 1) << 8);
+        }
+        case st_mode::IAX: {
+            const word_t pointer = static_cast<word_t>(fetch_word() + r.x);
+            return static_cast<word_t>(read(pointer) | read(pointer + 1) << 8);
+        }
+        case st_mode::REL: {
+            const auto offset = static_cast<int8_t>(fetch());
+            return static_cast<word_t>(r.pc + offset);
+        }
+    }
+    return 0;
+}
+
+void                    emulator::
+execute(const instruction &in, const word_t address)
+{
+    auto &r = m_registers;
+    const bool on_a = in.mode == st_mode::ACC;
+
+    // Shifts, rotations, increments and decrements work on A or on memory
+    const auto modify = [&](const auto operation) {
+        if (on_a) {
+            r.a = set_nz(operation(r.a));
+        } else {
+            write(address, set_nz(operation(read(address))));
+        }
+    };
+
+    switch (in.mnemonic) {
+        case pt_opcode::ADC: add(read(address)); break;
+        case pt_opcode::SBC: subtract(read(address)); break;
+        case pt_opcode::AND: r.a = set_nz(r.a & read(address)); break;
+        case pt_opcode::ORA: r.a = set_nz(r.a | read(address)); break;
+        case pt_opcode::EOR: r.a = set_nz(r.a ^ read(address)); break;
+
+        case pt_opcode::ASL:
+            modify([this](const byte_t v) { set_flag(CARRY, v & 0x80); return static_cast<byte_t>(v << 1); });
+            break;
+        case pt_opcode::LSR:
+            modify([this](const byte_t v) { set_flag(CARRY, v & 0x01); return static_cast<byte_t>(v >> 1); });
+            break;
+        case pt_opcode::ROL:
+            modify([this](const byte_t v) {
+                const byte_t result = static_cast<byte_t>(v << 1 | get_flag(CARRY));
+                set_flag(CARRY, v & 0x80);
+                return result;
+            });
+            break;
+        case pt_opcode::ROR:
+            modify([this](const byte_t v) {
+                const byte_t result = static_cast<byte_t>(v >> 1 | get_flag(CARRY) << 7);
+                set_flag(CARRY, v & 0x01);
+                return result;
+            });
+            break;
+        case pt_opcode::INC: modify([](const byte_t v) { return static_cast<byte_t>(v + 1); }); break;
+        case pt_opcode::DEC: modify([](const byte_t v) { return static_cast<byte_t>(v - 1); }); break;
+        case pt_opcode::INX: r.x = set_nz(r.x + 1); break;
+        case pt_opcode::INY: r.y = set_nz(r.y + 1); break;
+        case pt_opcode::DEX: r.x = set_nz(r.x - 1); break;
+        case pt_opcode::DEY: r.y = set_nz(r.y - 1); break;
+
+        case pt_opcode::BBR0: case pt_opcode::BBR1: case pt_opcode::BBR2: case pt_opcode::BBR3:
+        case pt_opcode::BBR4: case pt_opcode::BBR5: case pt_opcode::BBR6: case pt_opcode::BBR7: {
+            const byte_t value = read(address);
+            const auto offset = static_cast<int8_t>(fetch());
+            branch(not (value >> bit_number(in.mnemonic, pt_opcode::BBR0) & 1), static_cast<word_t>(r.pc + offset));
+            break;
+        }
+        case pt_opcode::BBS0: case pt_opcode::BBS1: case pt_opcode::BBS2: case pt_opcode::BBS3:
+        case pt_opcode::BBS4: case pt_opcode::BBS5: case pt_opcode::BBS6: case pt_opcode::BBS7: {
+            const byte_t value = read(address);
+            const auto offset = static_cast<int8_t>(fetch());
+            branch(value >> bit_number(in.mnemonic, pt_opcode::BBS0) & 1, static_cast<word_t>(r.pc + offset));
+            break;
+        }
+        case pt_opcode::RMB0: case pt_opcode::RMB1: case pt_opcode::RMB2: case pt_opcode::RMB3:
+        case pt_opcode::RMB4: case pt_opcode::RMB5: case pt_opcode::RMB6: case pt_opcode::RMB7:
+            write(address, read(address) & ~(1u << bit_number(in.mnemonic, pt_opcode::RMB0)));
+            break;
+        case pt_opcode::SMB0: case pt_opcode::SMB1: case pt_opcode::SMB2: case pt_opcode::SMB3:
+        case pt_opcode::SMB4: case pt_opcode::SMB5: case pt_opcode::SMB6: case pt_opcode::SMB7:
+            write(address, read(address) | 1u << bit_number(in.mnemonic, pt_opcode::SMB0));
+            break;
+
+        case pt_opcode::BCC: branch(not get_flag(CARRY), address); break;
+        case pt_opcode::BCS: branch(get_flag(CARRY), address); break;
+        case pt_opcode::BNE: branch(not get_flag(ZERO), address); break;
+        case pt_opcode::BEQ: branch(get_flag(ZERO), address); break;
+        case pt_opcode::BPL: branch(not get_flag(NEGATIVE), address); break;
+        case pt_opcode::BMI: branch(get_flag(NEGATIVE), address); break;
+        case pt_opcode::BVC: branch(not get_flag(OVERFLOW), address); break;
+        case pt_opcode::BVS: branch(get_flag(OVERFLOW), address); break;
+        case pt_opcode::BRA: branch(true, address); break;
+
+        case pt_opcode::BIT: {
+            const byte_t value = read(address);
+            set_flag(ZERO, (r.a & value) == 0);
+            if (in.mode != st_mode::IMM) {
+                set_flag(NEGATIVE, value & 0x80);
+                set_flag(OVERFLOW, value & 0x40);
+            }
+            break;
+        }
+        case pt_opcode::TRB:
+        case pt_opcode::TSB: {
+            const byte_t value = read(address);
+            set_flag(ZERO, (r.a & value) == 0);
+            write(address, in.mnemonic == pt_opcode::TSB ? value | r.a : value & ~r.a);
+            break;
+        }
+
+        case pt_opcode::CMP: compare(r.a, read(address)); break;
+        case pt_opcode::CPX: compare(r.x, read(address)); break;
+        case pt_opcode::CPY: compare(r.y, read(address)); break;
+
+        case pt_opcode::CLC: set_flag(CARRY, false); break;
+        case pt_opcode::CLD: set_flag(DECIMAL, false); break;
+        case pt_opcode::CLI: set_flag(INTERRUPT, false); break;
+        case pt_opcode::CLV: set_flag(OVERFLOW, false); break;
+        case pt_opcode::SEC: set_flag(CARRY, true); break;
+        case pt_opcode::SED: set_flag(DECIMAL, true); break;
+        case pt_opcode::SEI: set_flag(INTERRUPT, true); break;
+
+        case pt_opcode::JMP: r.pc = address; break;
+        case pt_opcode::JSR:
+            push(static_cast<byte_t>((r.pc - 1) >> 8));
+            push(static_cast<byte_t>(r.pc - 1));
+            r.pc = address;
+            break;
+        case pt_opcode::RTS: {
+            const byte_t low = pull();
+            r.pc = static_cast<word_t>((low | pull() << 8) + 1);
+            break;
+        }
+        case pt_opcode::RTI: {
+            r.p = (pull() & ~BREAK_FLAG) | UNUSED;
+            const byte_t low = pull();
+            r.pc = static_cast<word_t>(low | pull() << 8);
+            break;
+        }
+
+        case pt_opcode::LDA: r.a = set_nz(read(address)); break;
+        case pt_opcode::LDX: r.x = set_nz(read(address)); break;
+        case pt_opcode::LDY: r.y = set_nz(read(address)); break;
+        case pt_opcode::STA: write(address, r.a); break;
+        case pt_opcode::STX: write(address, r.x); break;
+        case pt_opcode::STY: write(address, r.y); break;
+        case pt_opcode::STZ: write(address, 0); break;
+
+        case pt_opcode::PHA: push(r.a); break;
+        case pt_opcode::PHX: push(r.x); break;
+        case pt_opcode::PHY: push(r.y); break;
+        case pt_opcode::PHP: push(r.p | BREAK_FLAG | UNUSED); break;
+        case pt_opcode::PLA: r.a = set_nz(pull()); break;
+        case pt_opcode::PLX: r.x = set_nz(pull()); break;
+        case pt_opcode::PLY: r.y = set_nz(pull()); break;
+        case pt_opcode::PLP: r.p = (pull() & ~BREAK_FLAG) | UNUSED; break;
+
+        case pt_opcode::TAX: r.x = set_nz(r.a); break;
+        case pt_opcode::TAY: r.y = set_nz(r.a); break;
+        case pt_opcode::TXA: r.a = set_nz(r.x); break;
+        case pt_opcode::TYA: r.a = set_nz(r.y); break;
+        case pt_opcode::TSX: r.x = set_nz(r.sp); break;
+        case pt_opcode::TXS: r.sp = r.x; break;
+
+        case pt_opcode::BRK: m_stopped = stop_reason::BREAK; break;
+        case pt_opcode::STP: m_stopped = stop_reason::STOP; break;
+        case pt_opcode::WAI: m_stopped = stop_reason::WAIT; break;
+        case pt_opcode::NOP:
+        default:
+            break;
+    }
+}
+
+
+void                    emulator::
+set_flag(const flag f, const bool value) noexcept
+{ m_registers.p = value ? m_registers.p | f : m_registers.p & ~f; }
+
+bool                    emulator::
+get_flag(const flag f) const noexcept
+{ return m_registers.p & f; }
+
+byte_t                  emulator::
+set_nz(const byte_t value) noexcept
+{
+    set_flag(ZERO, value == 0);
+    set_flag(NEGATIVE, value & 0x80);
+    return value;
+}
+
+void                    emulator::
+compare(const byte_t reg, const byte_t value) noexcept
+{
+    set_flag(CARRY, reg >= value);
+    set_nz(static_cast<byte_t>(reg - value));
+}
+
+void                    emulator::
+add(const byte_t value) noexcept
+{
+    auto &a = m_registers.a;
+    const unsigned carry = get_flag(CARRY);
+    if (not get_flag(DECIMAL)) {
+        const unsigned sum = a + value + carry;
+        set_flag(OVERFLOW, ~(a ^ value) & (a ^ sum) & 0x80);
+        set_flag(CARRY, sum > 0xFF);
+        a = set_nz(static_cast<byte_t>(sum));
+        return;
+    }
+
+    // Decimal mode, N and Z are valid on the 65C02
+    unsigned low = (a & 0x0F) + (value & 0x0F) + carry;
+    if (low >= 0x0A) low = ((low + 0x06) & 0x0F) + 0x10;
+    unsigned sum = (a & 0xF0) + (value & 0xF0) + low;
+    set_flag(OVERFLOW, ~(a ^ value) & (a ^ sum) & 0x80);
+    if (sum >= 0xA0) sum += 0x60;
+    set_flag(CARRY, sum > 0xFF);
+    a = set_nz(static_cast<byte_t>(sum));
+}
+
+void                    emulator::
+subtract(const byte_t value) noexcept
+{
+    auto &a = m_registers.a;
+    const int borrow     = get_flag(CARRY) ? 0 : 1;
+    const int difference = a - value - borrow;
+    set_flag(OVERFLOW, (a ^ value) & (a ^ difference) & 0x80);
+    set_flag(CARRY, difference >= 0);
+    if (not get_flag(DECIMAL)) {
+        a = set_nz(static_cast<byte_t>(difference));
+        return;
+    }
+
+    int result = difference;
+    if (result < 0) result -= 0x60;
+    if ((a & 0x0F) - (value & 0x0F) - borrow < 0) result -= 0x06;
+    a = set_nz(static_cast<byte_t>(result));
+}
+
+word_t                  emulator::
+indexed(const word_t base, const byte_t index) noexcept
+{
+    const word_t address = static_cast<word_t>(base + index);
+    m_page_crossed = (base ^ address) & 0xFF'00;
+    return address;
+}
+
+void                    emulator::
+branch(const bool condition, const word_t target) noexcept
+{
+    if (not condition) return;
+    m_branch_taken = true;
+    m_page_crossed = (m_registers.pc ^ target) & 0xFF'00;
+    m_registers.pc = target;
+}
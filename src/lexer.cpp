@@ -5,18 +5,121 @@
  |       Author: MOlex-dev       |
  *-------------------------------*/
 
+#include <array>
+
 #include "../include/lexer.hpp"
+#include "../include/scanner.hpp"
 
 using namespace mxasm;
 using lt_kind = lexer_token::lt_kind;
 
 
+namespace
+{
+    // Character classes, one bit each
+    enum : uint16_t
+    {
+        CC_SPACE  = 1 << 0,
+        CC_DIGIT  = 1 << 1,
+        CC_IDENT  = 1 << 2,     // letter, digit or '_'
+        CC_HEX    = 1 << 3,
+        CC_BIN    = 1 << 4,
+        CC_OCTAL  = 1 << 5,
+        CC_STRING = 1 << 6,     // printable ASCII, allowed inside string literals
+        CC_BACK   = 1 << 7,     // may follow a token: end of line, space or comment
+        CC_AFTER  = 1 << 8,     // may follow a number or an identifier: CC_BACK, ',' or ')'
+    };
+
+    // Scanner state entered from the first symbol of a token
+    enum class start_state : uint8_t
+    {
+        UNEXPECTED, SPACE, END_OF_LINE,
+        IDENTIFIER, HEX, BINARY, OCTAL, DECIMAL,     // Numbers in the order of number_states
+        COMMENT, DIRECTIVE, STRING,
+        COMMA, HASH, LEFT_PARENTHESIS, RIGHT_PARENTHESIS, LESS, GREATER, ASTERISK, EQUALS
+    };
+
+    constexpr std::array<uint16_t, 256> make_char_classes() noexcept
+    {
+        std::array<uint16_t, 256> table {};
+        for (int c = 0; c < 256; ++c) {
+            uint16_t cls = 0;
+            const bool digit  = c >= '0' and c <= '9';
+            const bool letter = (c >= 'a' and c <= 'z') or (c >= 'A' and c <= 'Z');
+
+            if (c == ' ' or c == '\t' or c == '\r' or c == '\n')       cls |= CC_SPACE;
+            if (digit)                                                   cls |= CC_DIGIT;
+            if (digit or letter or c == '_')                             cls |= CC_IDENT;
+            if (digit or (c >= 'a' and c <= 'f') or (c >= 'A' and c <= 'F')) cls |= CC_HEX;
+            if (c == '0' or c == '1')                                    cls |= CC_BIN;
+            if (c >= '0' and c <= '7')                                   cls |= CC_OCTAL;
+            if (c >= 0x20 and c <= 0x7E)                                 cls |= CC_STRING;
+            if (c == '\0' or c == ';' or (cls & CC_SPACE))               cls |= CC_BACK;
+            if ((cls & CC_BACK) or c == ',' or c == ')')                 cls |= CC_AFTER;
+            table[c] = cls;
+        }
+        return table;
+    }
+
+    constexpr std::array<start_state, 256> make_start_states() noexcept
+    {
+        std::array<start_state, 256> table {};
+        for (int c = 0; c < 256; ++c) {
+            if ((c >= 'a' and c <= 'z') or (c >= 'A' and c <= 'Z') or c == '_') table[c] = start_state::IDENTIFIER;
+            else if (c >= '1' and c <= '9') table[c] = start_state::DECIMAL;
+            else table[c] = start_state::UNEXPECTED;
+        }
+        table[' ']  = table['\t'] = table['\r'] = table['\n'] = start_state::SPACE;
+        table['\0'] = start_state::END_OF_LINE;
+        table['0']  = start_state::OCTAL;
+        table[';']  = start_state::COMMENT;
+        table['.']  = start_state::DIRECTIVE;
+        table['\"'] = start_state::STRING;
+        table['$']  = start_state::HEX;
+        table['%']  = start_state::BINARY;
+        table[',']  = start_state::COMMA;
+        table['#']  = start_state::HASH;
+        table['(']  = start_state::LEFT_PARENTHESIS;
+        table[')']  = start_state::RIGHT_PARENTHESIS;
+        table['<']  = start_state::LESS;
+        table['>']  = start_state::GREATER;
+        table['*']  = start_state::ASTERISK;
+        table['=']  = start_state::EQUALS;
+        return table;
+    }
+
+    // Number states, after the start symbol: the class of the body and the shortest whole token
+    struct number_state
+    {
+        lt_kind     kind;
+        uint16_t    body;
+        std::size_t min_length;
+    };
+
+    constexpr std::array<number_state, 4> number_states {{
+        {lt_kind::HEX_CONSTANT,     CC_HEX,   2},     // '$' alone is no number
+        {lt_kind::BINARY_CONSTANT,  CC_BIN,   2},     // Nor is '%'
+        {lt_kind::OCTAL_CONSTANT,   CC_OCTAL, 1},
+        {lt_kind::DECIMAL_CONSTANT, CC_DIGIT, 1}
+    }};
+
+    constexpr const number_state &number_state_of(const start_state state) noexcept
+    { return number_states[static_cast<std::size_t>(state) - static_cast<std::size_t>(start_state::HEX)]; }
+
+    constexpr auto char_classes = make_char_classes();
+    constexpr auto start_states = make_start_states();
+
+    constexpr bool has_class(const char c, const uint16_t cls) noexcept
+    { return char_classes[static_cast<unsigned char>(c)] & cls; }
+}
+
+
 lexer::
-lexer(const source_listing &source) noexcept
-        : m_source_listing {source} {}
+lexer(const source_listing &source, const std::size_t max_errors) noexcept
+        : m_source_listing {source}, m_max_errors {max_errors} {}
 
 
-std::list<lexer_token>  lexer::
+const std::vector<lexer_token>& lexer::
 tokens()
 {
     if (m_tokens.empty()) tokenize();
@@ -27,56 +130,57 @@ tokens()
 void                    lexer::
 tokenize()
 {
+    m_tokens.reserve(m_source_listing.size() * 4);
     for (const auto &line : m_source_listing) {
         auto token = next(line);
         while (token.is_not(lt_kind::END_OF_LINE)) {
             if (token.is(lt_kind::UNEXPECTED)) {
-                add_exception("Unexpected token at [" + std::to_string(token.row())
-                              + ", " + std::to_string(token.column()) + "]:\n"
-                              + token.lexeme());
+                if (not add_error(token)) throw std::move(m_diagnostics);
             } else {
                 m_tokens.push_back(token);
             }
             token = next(line);
         }
     }
-    if (not m_exceptions.empty()) {
-        throw std::move(m_exceptions);
+    if (not m_diagnostics.empty()) {
+        throw std::move(m_diagnostics);
     }
 }
 
 lexer_token             lexer::
-next(const std::pair<std::size_t, std::string> &line) noexcept
+next(const source_line &line) noexcept
 {
-    if (m_current_begin != line.second.cbegin()) {
-        m_current_begin = m_current_iter = line.second.cbegin();
-        m_current_row = line.first;
-    }
-
-    while (is_space(peek())) get();
-
-    if (is_end_of_line(peek())) return lexer_token(lt_kind::END_OF_LINE);
-    if (is_letter(peek()) or peek() == '_') return identifier_or_label_decl();
-
-    if (is_digit(peek())) {
-        if (peek() == '0') return octal_constant();
-        return decimal_constant();
+    if (m_current_begin != line.text.cbegin()) {
+        m_current_begin = m_current_iter = line.text.cbegin();
+        m_current_end = line.text.cend();
+        m_current_row = line.number;
     }
 
-    switch (peek()) {
-        case ';' : return comment();
-        case '.' : return directive();
-        case '\"': return string();
-        case '$' : return hex_constant();
-        case '%' : return bin_constant();
-        case ',' : return atom(lt_kind::COMMA);
-        case '#' : return atom(lt_kind::HASH);
-        case '(' : return atom(lt_kind::LEFT_PARENTHESIS);
-        case ')' : return atom(lt_kind::RIGHT_PARENTHESIS);
-        case '<' : return atom(lt_kind::LESS);
-        case '>' : return atom(lt_kind::GREATER);
-        case '*' : return atom(lt_kind::ASTERISK);
-        case '=' : return atom(lt_kind::EQUALS);
+    skip_run(CC_SPACE, scan_spaces);
+
+    const start_state state = start_states[static_cast<unsigned char>(peek())];
+    switch (state) {
+        case start_state::END_OF_LINE       : return lexer_token(lt_kind::END_OF_LINE);
+        case start_state::IDENTIFIER        : return identifier_or_label_decl();
+        case start_state::COMMENT           : return comment();
+        case start_state::DIRECTIVE         : return directive();
+        case start_state::STRING            : return string();
+        case start_state::COMMA             : return atom(lt_kind::COMMA);
+        case start_state::HASH              : return atom(lt_kind::HASH);
+        case start_state::LEFT_PARENTHESIS  : return atom(lt_kind::LEFT_PARENTHESIS);
+        case start_state::RIGHT_PARENTHESIS : return atom(lt_kind::RIGHT_PARENTHESIS);
+        case start_state::LESS              : return atom(lt_kind::LESS);
+        case start_state::GREATER           : return atom(lt_kind::GREATER);
+        case start_state::ASTERISK          : return atom(lt_kind::ASTERISK);
+        case start_state::EQUALS            : return atom(lt_kind::EQUALS);
+        case start_state::HEX               :
+        case start_state::BINARY            :
+        case start_state::OCTAL             :
+        case start_state::DECIMAL           : {
+            const auto &number_body = number_state_of(state);
+            return number(number_body.kind, number_body.body, number_body.min_length);
+        }
+        default                             : break;
     }
     return unexpected(m_current_iter);
 }
@@ -86,35 +190,36 @@ atom(const lt_kind kind) noexcept
 {
     auto begin = m_current_iter;
     if (kind == lt_kind::RIGHT_PARENTHESIS) {
-        auto next_symbol = *(std::next(m_current_iter));
+        auto next_symbol = symbol_at(std::next(m_current_iter));
         if (not (is_allowed_back_symbol(next_symbol) or next_symbol == ',')) {
             return unexpected(begin);
         }
     }
-    return lexer_token(kind, std::string(1, get()), m_current_row, get_column_number(m_current_iter));
+    get();
+    return lexer_token(kind, std::string_view(begin, m_current_iter), m_current_row, get_column_number(begin));
 }
 
 lexer_token             lexer::
-unexpected(const std::string::const_iterator begin) noexcept
+unexpected(const std::string_view::const_iterator begin) noexcept
 {
     auto iter = begin;
     ++iter;
-    while (not (is_space(*iter) or is_end_of_line(*iter))) ++iter;
+    while (not (is_space(symbol_at(iter)) or is_end_of_line(symbol_at(iter)))) ++iter;
     m_current_iter = iter;
-    return unexpected(std::string(begin, iter), get_column_number(begin));
+    return unexpected(std::string_view(begin, iter), get_column_number(begin));
 }
 
 lexer_token             lexer::
-unexpected(std::string lexeme, const std::size_t column) noexcept
-{ return lexer_token(lt_kind::UNEXPECTED, std::move(lexeme), m_current_row, column); }
+unexpected(const std::string_view lexeme, const std::size_t column) noexcept
+{ return lexer_token(lt_kind::UNEXPECTED, lexeme, m_current_row, column); }
 
 lexer_token        lexer::
 comment() noexcept
 {
     auto begin = m_current_iter;
     get();
-    while (not is_end_of_line(peek())) get();
-    return lexer_token(lt_kind::COMMENT, std::string(begin, m_current_iter), m_current_row, get_column_number(begin));
+    skip_with(scan_line_end);
+    return lexer_token(lt_kind::COMMENT, std::string_view(begin, m_current_iter), m_current_row, get_column_number(begin));
 }
 
 lexer_token        lexer::
@@ -122,13 +227,13 @@ directive() noexcept
 {
     auto begin = m_current_iter;
     get();
-    while (is_identifier_char(peek())) get();
+    skip_run(CC_IDENT, scan_identifier);
 
     if (not is_allowed_back_symbol(peek())) {
         return unexpected(begin);
     }
 
-    const std::string result_lexeme(begin, m_current_iter);
+    const std::string_view result_lexeme(begin, m_current_iter);
 
     if (result_lexeme.length() == 1) {
         return unexpected(result_lexeme, get_column_number(begin));
@@ -160,73 +265,28 @@ string() noexcept
         return unexpected(begin);
     }
 
-    const std::string result_lexeme(begin, m_current_iter);
+    const std::string_view result_lexeme(begin, m_current_iter);
     if (result_lexeme.length() == 2) {
         return unexpected(result_lexeme, get_column_number(begin));
     }
     return lexer_token(lt_kind::STRING, result_lexeme, m_current_row, get_column_number(begin));
 }
 
+// The start symbol picked the state, its body runs over one class of the table
 lexer_token             lexer::
-hex_constant() noexcept
+number(const lt_kind kind, const uint16_t body, const std::size_t min_length) noexcept
 {
     auto begin = m_current_iter;
     get();
-    while (is_hex_digit(peek())) get();
+    while (has_class(peek(), body)) get();
 
-    if (not (is_allowed_back_symbol(peek()) or peek() == ',' or peek() == ')')) {
+    if (not has_class(peek(), CC_AFTER)) {
         return unexpected(begin);
     }
 
-    const std::string result_lexeme(begin, m_current_iter);
-    if (result_lexeme.length() == 1) return unexpected(result_lexeme, get_column_number(begin));
-    return lexer_token(lt_kind::HEX_CONSTANT, result_lexeme, m_current_row, get_column_number(begin));
-}
-
-lexer_token             lexer::
-bin_constant() noexcept
-{
-    auto begin = m_current_iter;
-    get();
-    while (is_bin_digit(peek())) get();
-
-    if (not (is_allowed_back_symbol(peek()) or peek() == ',' or peek() == ')')) {
-        return unexpected(begin);
-    }
-
-    const std::string result_lexeme(begin, m_current_iter);
-    if (result_lexeme.length() == 1) return unexpected(result_lexeme, get_column_number(begin));
-    return lexer_token(lt_kind::BINARY_CONSTANT, result_lexeme, m_current_row, get_column_number(begin));
-}
-
-lexer_token             lexer::
-octal_constant() noexcept
-{
-    auto begin = m_current_iter;
-    get();
-    while (is_octal_digit(peek())) get();
-
-    if (not (is_allowed_back_symbol(peek()) or peek() == ',' or peek() == ')')) {
-        return unexpected(begin);
-    }
-
-    return lexer_token(lt_kind::OCTAL_CONSTANT, std::string(begin, m_current_iter), m_current_row,
-                       get_column_number(begin));
-}
-
-lexer_token             lexer::
-decimal_constant() noexcept
-{
-    auto begin = m_current_iter;
-    get();
-    while (is_digit(peek())) get();
-
-    if (not (is_allowed_back_symbol(peek()) or peek() == ',' or peek() == ')')) {
-        return unexpected(begin);
-    }
-
-    return lexer_token(lt_kind::DECIMAL_CONSTANT, std::string(begin, m_current_iter), m_current_row,
-                       get_column_number(begin));
+    const std::string_view result_lexeme(begin, m_current_iter);
+    if (result_lexeme.length() < min_length) return unexpected(result_lexeme, get_column_number(begin));
+    return lexer_token(kind, result_lexeme, m_current_row, get_column_number(begin));
 }
 
 lexer_token             lexer::
@@ -234,19 +294,19 @@ identifier_or_label_decl() noexcept
 {
     auto begin = m_current_iter;
     get();
-    while (is_identifier_char(peek())) get();
+    skip_run(CC_IDENT, scan_identifier);
 
     if (peek() == ':') {
         get();
     }
 
-    const std::string result_lexeme(begin, m_current_iter);
+    const std::string_view result_lexeme(begin, m_current_iter);
 
     if (not validate_identifier_name(result_lexeme)) {
         return unexpected(result_lexeme, get_column_number(begin));
     }
 
-    if (not (is_allowed_back_symbol(peek()) or peek() == ',' or peek() == ')')) {
+    if (not has_class(peek(), CC_AFTER)) {
         return unexpected(begin);
     }
 
@@ -267,81 +327,79 @@ identifier_or_label_decl() noexcept
 
 
 std::size_t             lexer::
-get_column_number(const std::string::const_iterator position) const noexcept
+get_column_number(const std::string_view::const_iterator position) const noexcept
 { return std::distance(m_current_begin, position) + 1; }
 
-void                    lexer::
-add_exception(const std::string &exception) noexcept
-{ m_exceptions.emplace_back(new lexer_exception(exception)); }
+// False once there are too many errors to go on
+bool                    lexer::
+add_error(const lexer_token &token)
+{
+    if (m_max_errors != 0 and m_diagnostics.size() == m_max_errors) {
+        m_diagnostics.add(diagnostic_code::TOO_MANY_ERRORS, 0, 0, std::to_string(m_max_errors));
+        return false;
+    }
+    m_diagnostics.add(diagnostic_code::LEXER_UNEXPECTED_TOKEN, static_cast<uint32_t>(token.row()),
+                      static_cast<uint32_t>(token.column()), token.lexeme());
+    return true;
+}
+
+char                    lexer::
+symbol_at(const std::string_view::const_iterator position) const noexcept
+{ return position == m_current_end ? '\0' : *position; }
 
 char                    lexer::
 peek() const noexcept
-{ return *m_current_iter; }
+{ return symbol_at(m_current_iter); }
 
 char                    lexer::
 get() noexcept
 { return *m_current_iter++; }
 
+void                    lexer::
+skip_with(const char *(*scan)(const char *begin, const char *end) noexcept) noexcept
+{
+    const char *position = std::to_address(m_current_iter);
+    m_current_iter += scan(position, std::to_address(m_current_end)) - position;
+}
 
-bool                    lexer::
-is_space(const char c) noexcept
+void                    lexer::
+skip_run(const uint16_t char_class, const char *(*scan)(const char *begin, const char *end) noexcept) noexcept
 {
-    switch (c) {
-        case ' ':
-        case '\t':
-        case '\r':
-        case '\n':
-            return true;
-        default:
-            return false;
+    // Most runs are a few symbols long, the vector scanner only pays off once a run gets past one block
+    for (int i = 0; i < 16; ++i) {
+        if (not has_class(peek(), char_class)) return;
+        get();
     }
+    skip_with(scan);
 }
 
-bool                    lexer::
-is_end_of_line(const char c) noexcept
-{ return c == '\0'; }
 
 bool                    lexer::
-is_digit(const char c) noexcept
-{ return c >= '0' and c <= '9'; }
+is_space(const char c) noexcept
+{ return has_class(c, CC_SPACE); }
 
 bool                    lexer::
-is_letter(const char c) noexcept
-{ return c >= 'a' and c <= 'z' or c >= 'A' and c <= 'Z'; }
+is_end_of_line(const char c) noexcept
+{ return c == '\0'; }
 
 bool                    lexer::
 is_identifier_char(const char c) noexcept
-{ return is_letter(c) or is_digit(c) or c == '_'; }
+{ return has_class(c, CC_IDENT); }
 
 bool                    lexer::
 is_string_symbol(const char c) noexcept
-{ return c >= 0x20 and c <= 0x7E; }
-
-bool                    lexer::
-is_hex_digit(const char c) noexcept
-{
-    char x = tolower(c);
-    return is_digit(c) or (x >= 'a' and x <= 'f');
-}
-
-bool                    lexer::
-is_bin_digit(const char c) noexcept
-{ return c == '0' or c == '1'; }
-
-bool                    lexer::
-is_octal_digit(const char c) noexcept
-{ return c >= '0' and c <= '7'; }
+{ return has_class(c, CC_STRING); }
 
 bool                    lexer::
-validate_identifier_name(const std::string &id) noexcept
+validate_identifier_name(const std::string_view id) noexcept
 {
     if (id.empty()) {
         return false;
     }
-    if (std::count(id.begin(), id.end(), ' ') == id.length()) {
+    if (id.find_first_not_of(' ') == std::string_view::npos) {
         return false;
     }
-    if (std::count(id.begin(), id.end(), '_') == id.length()) {
+    if (id.find_first_not_of('_') == std::string_view::npos) {
         return false;
     }
     return true;
@@ -349,4 +407,4 @@ validate_identifier_name(const std::string &id) noexcept
 
 bool                    lexer::
 is_allowed_back_symbol(const char c) noexcept
-{ return is_end_of_line(c) or is_space(c) or c == ';'; }
+{ return has_class(c, CC_BACK); }
@@ -16,8 +16,8 @@ lexer_token::
 lexer_token(const lt_kind kind) : lexer_token(kind, "", 0, 0) {}
 
 lexer_token::
-lexer_token(const lt_kind kind, const std::string lexeme, const std::size_t row, const std::size_t column)
-    : m_kind {kind}, m_lexeme {lexeme}, m_row {row}, m_column {column} {}
+lexer_token(const lt_kind kind, const std::string_view lexeme, const std::size_t row, const std::size_t column)
+    : m_row {row}, m_column {column}, m_lexeme {lexeme}, m_kind {kind} {}
 
 
 std::size_t        lexer_token::
@@ -28,7 +28,7 @@ std::size_t        lexer_token::
 column() const noexcept
 { return m_column; }
 
-std::string        lexer_token::
+std::string_view   lexer_token::
 lexeme() const noexcept
 { return m_lexeme; }
 
@@ -46,8 +46,8 @@ column(const std::size_t column) noexcept
 { m_column = column; }
 
 void               lexer_token::
-lexeme(std::string lexeme) noexcept
-{ m_lexeme = std::move(lexeme); }
+lexeme(const std::string_view lexeme) noexcept
+{ m_lexeme = lexeme; }
 
 void               lexer_token::
 kind(const lt_kind kind) noexcept
@@ -0,0 +1,209 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |            Listing            |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <optional>
+#include <sstream>
+
+#include "../include/listing.hpp"
+#include "../include/instruction_set.hpp"
+#include "../include/exceptions/arguments_exception.hpp"
+
+using namespace mxasm;
+using st_command = serializable_token::st_command;
+using st_mode    = serializable_token::st_mode;
+
+
+namespace
+{
+    constexpr std::size_t BYTES_PER_LINE = 8;
+
+    struct cost
+    {
+        std::size_t min;
+        std::size_t max;
+    };
+
+    // Bytes of one source row
+    struct row_bytes
+    {
+        word_t      address {0};
+        std::size_t size    {0};
+    };
+
+    std::string hex(const unsigned value, const int digits)
+    {
+        std::ostringstream text;
+        text << std::uppercase << std::hex << std::setw(digits) << std::setfill('0') << value;
+        return text.str();
+    }
+
+    std::size_t command_size(const st_command command) noexcept
+    { return 1 + operand_size(command_mode(command)); }
+
+    // Where a branch goes, if the command is one
+    std::optional<word_t> branch_target(const memory_image &program, const word_t address)
+    {
+        const auto command = static_cast<st_command>(program.read(address));
+        const word_t next = static_cast<word_t>(address + command_size(command));
+        switch (command_mode(command)) {
+            case st_mode::REL:
+                return static_cast<word_t>(next + static_cast<int8_t>(program.read(address + 1)));
+            case st_mode::ZPR:
+                return static_cast<word_t>(next + static_cast<int8_t>(program.read(address + 2)));
+            default:
+                return std::nullopt;
+        }
+    }
+
+    // The page penalty of a branch is known here, so it counts only when the target is on another page.
+    // BRA is always taken
+    cost command_cost(const memory_image &program, const word_t address, const bool taken = false)
+    {
+        const auto command = static_cast<st_command>(program.read(address));
+        const byte_t penalties = serializable_token::command_penalties[static_cast<byte_t>(command)];
+        const auto target = branch_target(program, address);
+        if (not target) {
+            return {serializable_token::min_cycles(command), serializable_token::max_cycles(command)};
+        }
+
+        const word_t next = static_cast<word_t>(address + command_size(command));
+        const std::size_t base = serializable_token::min_cycles(command);
+        const std::size_t jump = base + (penalties & serializable_token::BRANCH_PENALTY ? 1 : 0)
+                               + ((next ^ *target) & 0xFF'00 ? 1 : 0);
+        return taken or command == st_command::BRA_rel ? cost{jump, jump} : cost{base, jump};
+    }
+
+    // Commands of a row: one, or a branch over a JMP where a branch out of reach was relaxed.
+    // That pair costs the taken branch alone, or the branch and the JMP
+    cost row_cost(const memory_image &program, const row_bytes &bytes)
+    {
+        const auto command = static_cast<st_command>(program.read(bytes.address));
+        const word_t jump = static_cast<word_t>(bytes.address + command_size(command));
+        const word_t end  = static_cast<word_t>(bytes.address + bytes.size);
+        if (jump == end or program.read(jump) != static_cast<byte_t>(st_command::JMP_abs)
+            or branch_target(program, bytes.address) != end) {
+            return command_cost(program, bytes.address);
+        }
+        return {command_cost(program, bytes.address, true).min,
+                command_cost(program, bytes.address).min + command_cost(program, jump).max};
+    }
+
+    // Backward branches and jumps to a label close a loop, which runs from the label to them
+    struct loop
+    {
+        word_t   begin;
+        word_t   end;           // Past the closing command
+        uint32_t label;
+        cost     cycles;
+    };
+
+    std::vector<loop> find_loops(const memory_image &program, const source_map &map)
+    {
+        std::vector<uint32_t> label_at(0x1'00'00, UINT32_MAX);
+        for (const std::size_t id : map.labels_by_address()) {
+            if (label_at[map.labels[id].address] == UINT32_MAX) label_at[map.labels[id].address] = id;
+        }
+        std::vector<word_t> commands = map.commands;
+        std::sort(commands.begin(), commands.end());
+
+        std::vector<loop> loops;
+        for (const word_t address : commands) {
+            const auto command = static_cast<st_command>(program.read(address));
+            std::optional<word_t> target = branch_target(program, address);
+            if (command == st_command::JMP_abs) {
+                target = static_cast<word_t>(program.read(address + 1) | program.read(address + 2) << 8);
+            }
+            if (not target or *target > address or label_at[*target] == UINT32_MAX) continue;
+
+            loop found {*target, static_cast<word_t>(address + command_size(command)), label_at[*target], {0, 0}};
+            const auto first = std::lower_bound(commands.begin(), commands.end(), found.begin);
+            for (auto inside = first; inside != commands.end() and *inside <= address; ++inside) {
+                const cost c = command_cost(program, *inside, *inside == address);
+                found.cycles.min += c.min;
+                found.cycles.max += c.max;
+            }
+            loops.push_back(found);
+        }
+        return loops;
+    }
+
+    std::string cycles_text(const cost c)
+    { return c.min == c.max ? std::to_string(c.min) : std::to_string(c.min) + "-" + std::to_string(c.max); }
+}
+
+
+std::string             mxasm::
+listing_text(const memory_image &program, const source_map &map)
+{
+    std::vector<row_bytes> rows(map.lines.size() + 1);
+    for (std::size_t address = 0; address < map.rows.size(); ++address) {
+        const uint32_t row = map.rows[address];
+        if (row == source_map::NO_ROW or row >= rows.size()) continue;
+        if (rows[row].size == 0) rows[row].address = static_cast<word_t>(address);
+        ++rows[row].size;
+    }
+    std::vector<bool> is_command(0x1'00'00);
+    for (const word_t address : map.commands) {
+        is_command[address] = true;
+    }
+    std::vector<std::optional<word_t>> label_rows(rows.size());
+    for (const auto &label : map.labels) {
+        if (label.placed and label.row < label_rows.size()) label_rows[label.row] = label.address;
+    }
+
+    std::ostringstream out;
+    out << std::left << "Addr  " << std::setw(BYTES_PER_LINE * 3) << "Bytes" << std::setw(7) << "Cycles"
+        << std::right << std::setw(6) << "Row" << "  Source\n";
+    for (uint32_t row = 1; row < rows.size(); ++row) {
+        const row_bytes &bytes = rows[row];
+        std::string first_bytes;
+        std::string cycles;
+        std::string address;
+        if (bytes.size != 0) {
+            address = hex(bytes.address, 4);
+            for (std::size_t i = 0; i < std::min(bytes.size, BYTES_PER_LINE); ++i) {
+                first_bytes += hex(program.read(bytes.address + i), 2) + ' ';
+            }
+            if (is_command[bytes.address]) cycles = cycles_text(row_cost(program, bytes));
+        } else if (label_rows[row]) {
+            address = hex(*label_rows[row], 4);
+        }
+        out << std::left << std::setw(6) << address << std::setw(BYTES_PER_LINE * 3) << first_bytes
+            << std::setw(7) << cycles << std::right << std::setw(6) << row << "  " << map.row_text(row) << '\n';
+
+        // Long data rows go on, BYTES_PER_LINE bytes a line
+        for (std::size_t offset = BYTES_PER_LINE; offset < bytes.size; offset += BYTES_PER_LINE) {
+            std::string more;
+            for (std::size_t i = offset; i < std::min(bytes.size, offset + BYTES_PER_LINE); ++i) {
+                more += hex(program.read(bytes.address + i), 2) + ' ';
+            }
+            out << std::left << std::setw(6) << hex(static_cast<word_t>(bytes.address + offset), 4)
+                << more << '\n';
+        }
+    }
+
+    const auto loops = find_loops(program, map);
+    if (not loops.empty()) {
+        out << "\nLoops, cycles of one pass with the closing branch taken. Inner loops count once, calls as their JSR\n";
+        for (const auto &found : loops) {
+            out << std::left << std::setw(11) << hex(found.begin, 4) + '-' + hex(found.end - 1, 4)
+                << std::setw(9) << cycles_text(found.cycles) << map.labels[found.label].name << '\n';
+        }
+    }
+    return out.str();
+}
+
+void                    mxasm::
+write_listing(const memory_image &program, const source_map &map, const std::string &out_name)
+{
+    std::ofstream out(out_name, std::ios::binary | std::ios::trunc);
+    out << listing_text(program, map);
+    if (not out.flush()) throw arguments_exception("Can't write listing file '" + out_name + "'");
+}
@@ -0,0 +1,168 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |          Memory Image         |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <algorithm>
+
+#include "../include/memory_image.hpp"
+
+using namespace mxasm;
+
+
+memory_image::
+memory_image(const memory_image &other)
+{ *this = other; }
+
+memory_image&           memory_image::
+operator=(const memory_image &other)
+{
+    if (this == &other) return *this;
+    for (std::size_t i = 0; i < PAGE_COUNT; ++i) {
+        m_pages[i] = other.m_pages[i] ? std::make_unique<page>(*other.m_pages[i]) : nullptr;
+    }
+    m_page_count = other.m_page_count;
+    return *this;
+}
+
+
+void                    memory_image::
+write(const word_t address, const byte_t value)
+{
+    auto &pg = m_pages[address / PAGE_SIZE];
+    if (not pg) {
+        pg = std::make_unique<page>();
+        ++m_page_count;
+    }
+    pg->bytes[address % PAGE_SIZE] = value;
+    pg->written.set(address % PAGE_SIZE);
+}
+
+void                    memory_image::
+write(word_t address, std::span<const byte_t> values)
+{
+    while (not values.empty()) {
+        const std::size_t offset = address % PAGE_SIZE;
+        const std::size_t count  = std::min(values.size(), PAGE_SIZE - offset);
+
+        auto &pg = m_pages[address / PAGE_SIZE];
+        if (not pg) {
+            pg = std::make_unique<page>();
+            ++m_page_count;
+        }
+        std::copy_n(values.begin(), count, pg->bytes.begin() + offset);
+        if (count == PAGE_SIZE) {
+            pg->written.set();
+        } else {
+            pg->written |= (~std::bitset<PAGE_SIZE>() >> (PAGE_SIZE - count)) << offset;
+        }
+
+        address = static_cast<word_t>(address + count);
+        values  = values.subspan(count);
+    }
+}
+
+byte_t                  memory_image::
+read(const word_t address) const noexcept
+{
+    const auto &pg = m_pages[address / PAGE_SIZE];
+    return pg ? pg->bytes[address % PAGE_SIZE] : 0;
+}
+
+bool                    memory_image::
+is_written(const word_t address) const noexcept
+{
+    const auto &pg = m_pages[address / PAGE_SIZE];
+    return pg and pg->written.test(address % PAGE_SIZE);
+}
+
+bool                    memory_image::
+empty() const noexcept
+{ return m_page_count == 0; }
+
+
+std::vector<memory_image::segment>  memory_image::
+segments() const
+{
+    std::vector<segment> result;
+    bool in_segment = false;
+
+    for (std::size_t p = 0; p < PAGE_COUNT; ++p) {
+        const auto &pg = m_pages[p];
+        if (not pg) {
+            in_segment = false;
+            continue;
+        }
+        if (pg->written.all()) {
+            if (in_segment) {
+                result.back().size += PAGE_SIZE;
+            } else {
+                result.push_back({word_t(p * PAGE_SIZE), PAGE_SIZE});
+                in_segment = true;
+            }
+            continue;
+        }
+        for (std::size_t i = 0; i < PAGE_SIZE; ++i) {
+            if (not pg->written.test(i)) {
+                in_segment = false;
+                continue;
+            }
+            if (in_segment) {
+                ++result.back().size;
+            } else {
+                result.push_back({word_t(p * PAGE_SIZE + i), 1});
+                in_segment = true;
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<std::span<const byte_t>>    memory_image::
+chunks(const segment &range) const
+{
+    // Segment bytes as they lie in the pages, one view per page
+    std::vector<std::span<const byte_t>> result;
+    std::size_t address = range.address;
+    const std::size_t end = std::min(range.address + range.size, PAGE_COUNT * PAGE_SIZE);
+
+    while (address < end) {
+        const std::size_t chunk = std::min(PAGE_SIZE - address % PAGE_SIZE, end - address);
+        const auto &pg = m_pages[address / PAGE_SIZE];
+        if (not pg) break;
+        result.emplace_back(pg->bytes.data() + address % PAGE_SIZE, chunk);
+        address += chunk;
+    }
+    return result;
+}
+
+void                    memory_image::
+copy(const segment &range, std::span<byte_t> destination) const
+{
+    // Page by page, unwritten bytes read as zero
+    std::size_t address = range.address;
+    const std::size_t end = std::min(range.address + std::min(range.size, destination.size()), PAGE_COUNT * PAGE_SIZE);
+    auto out = destination.begin();
+
+    while (address < end) {
+        const std::size_t chunk = std::min(PAGE_SIZE - address % PAGE_SIZE, end - address);
+        const auto &pg = m_pages[address / PAGE_SIZE];
+        if (pg) {
+            std::copy_n(pg->bytes.begin() + address % PAGE_SIZE, chunk, out);
+        } else {
+            std::fill_n(out, chunk, 0);
+        }
+        out += chunk;
+        address += chunk;
+    }
+}
+
+std::vector<byte_t>     memory_image::
+bytes(const segment &range) const
+{
+    std::vector<byte_t> result(range.size);
+    copy(range, result);
+    return result;
+}
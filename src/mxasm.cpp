@@ -4,57 +4,49 @@
  *-------------------------------*/
 
 #include <iostream>
-#include <iomanip>
 #include <vector>
 #include <string>
 
 #include "../include/util.hpp"
-#include "../include/lexer.hpp"
-#include "../include/parser.hpp"
-#include "../include/serializer.hpp"
-
-//#define DEBUG_INPUT
-//#define DEBUG_LEXER
+#include "../include/options.hpp"
+#include "../include/assembler.hpp"
+#include "../include/thread_pool.hpp"
+#include "../include/server.hpp"
+#include "../include/assembly_cache.hpp"
+#include "../include/stats.hpp"
+#include "../include/runner.hpp"
 
 using namespace mxasm;
 
 
 int main(int argc, char **argv)
 {
+    assembler_options options;
+    std::unique_ptr<assembly_cache> cache;
     try {
         std::vector<std::string> cmd_arguments(argc);
         for (int i = 0; i < argc; ++i) {
             cmd_arguments[i] = std::string(argv[i]);
         }
-
-        auto source_file_path = get_source_file_path_from_cmd(cmd_arguments);
-        auto program_listing = open_source_code(source_file_path);
-
-#ifdef DEBUG_INPUT
-        for (const auto &[num, str] : program_listing) {
-            std::cout << std::setw(5) << num << ": ";
-            std::cout << str << '\n';
+        options = get_options_from_cmd(cmd_arguments);
+        if (options.mode == run_mode::SERVE) {
+            return run_server(options.socket_path, options.pipeline);
         }
-#endif
-
-        lexer tokenizer(program_listing);
-        auto lexed_tokens = tokenizer.tokens();
-
-#ifdef DEBUG_LEXER
-        for (const auto &token : lexed_tokens) {
-            std::cout << "[" << std::setw(4) << token.row() << ", " << std::setw(4) << token.column() << "]: ";
-            std::cout << std::setw(20) << token.kind()  << ": " << token.lexeme() << '\n';
+        if (options.mode == run_mode::RUN) {
+            // Straight from the serializer into the emulator, nothing is written
+            source_map map;
+            const auto result = assemble_file(options.source_paths.front(), options.pipeline, nullptr,
+                                              options.run.profiling() ? &map : nullptr);
+            if (result.exit_code != EXIT_SUCCESS) {
+                std::cerr << result.report();
+                return result.exit_code;
+            }
+            return run_program(result.image, options.run, &map);
+        }
+        if (not options.cache_directory.empty() and options.mode == run_mode::ASSEMBLE) {
+            cache = std::make_unique<assembly_cache>(options.cache_directory, options.cache_size,
+                                                     assembly_fingerprint(options));
         }
-#endif
-
-        parser lex_parser(lexed_tokens);
-        auto parsed_tokens = lex_parser.tokens();
-
-        serializer encoder(parsed_tokens);
-        auto program = encoder.binary_program();
-
-        std::string output_name = source_file_path.substr(0, source_file_path.length() - 4) + ".bin";
-        write_program_to_file(program, output_name);
 
     } catch (const mxasm_exception &ex) {
         std::cerr << "ERROR!" << std::endl;
@@ -64,12 +56,54 @@ int main(int argc, char **argv)
         std::cerr << "ERROR!" << std::endl;
         std::cerr << ex.what() << std::endl;
         return EXIT_FAILURE;
-    } catch (const exception_list &exs) {
-        std::cerr << "ERROR!" << std::endl;
-        for (const auto &ex : exs) {
-            std::cerr << ex->type() << ": " << ex->message() << '\n';
+    }
+
+    // Every file is an independent job, reports are printed in input order once all are done
+    std::vector<assembly_result> results(options.source_paths.size());
+    if (options.mode == run_mode::CONNECT) {
+        try {
+            results = request_assembly(options.socket_path, options.source_paths);
+        } catch (const mxasm_exception &ex) {
+            std::cerr << "ERROR!" << std::endl;
+            std::cerr << ex.type() << ": " << ex.message() << std::endl;
+            return EXIT_FAILURE;
         }
-        return EXIT_FAILURE;
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            if (results[i].exit_code != EXIT_SUCCESS) continue;
+            try {
+                write_program_to_file(results[i].image, get_output_path(options.source_paths[i]), options.output);
+            } catch (const mxasm_exception &ex) {
+                results[i] = {EXIT_FAILURE, {diagnostic_code::ARGUMENTS_ERROR, ex.message()}, {}};
+            }
+        }
+    } else {
+        std::vector<assembly_stats> stats(options.stats != stats_format::NONE ? results.size() : 0);
+        thread_pool workers(options.jobs);
+        workers.run(results.size(), [&](const std::size_t i) {
+            results[i] = assemble_file(options.source_paths[i], options.pipeline, options.output, cache.get(),
+                                       stats.empty() ? nullptr : &stats[i]);
+        });
+
+        if (options.stats == stats_format::TEXT) std::cout << stats_to_text(options.source_paths, stats);
+        if (options.stats == stats_format::JSON) std::cout << stats_to_json(options.source_paths, stats);
+    }
+
+    if (cache) {
+        cache->trim();
+        if (options.cache_stats) {
+            const auto stats = cache->stats();
+            std::cerr << "cache: " << stats.hits << " hits, " << stats.misses << " misses, "
+                      << stats.evictions << " evicted, " << stats.entries << " entries, "
+                      << stats.bytes << " bytes" << std::endl;
+        }
+    }
+
+    int exit_code = EXIT_SUCCESS;
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        if (results[i].exit_code == EXIT_SUCCESS) continue;
+        if (results.size() > 1) std::cerr << options.source_paths[i] << ":\n";
+        std::cerr << results[i].report();
+        exit_code = EXIT_FAILURE;
     }
-    return EXIT_SUCCESS;
+    return exit_code;
 }
@@ -0,0 +1,256 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |            Options            |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <algorithm>
+#include <fstream>
+#include <thread>
+
+#include "../include/options.hpp"
+#include "../include/server.hpp"
+#include "../include/assembly_cache.hpp"
+#include "../include/exceptions/arguments_exception.hpp"
+
+#ifndef MXASM_VERSION
+#define MXASM_VERSION "unknown"
+#endif
+
+using namespace mxasm;
+
+
+namespace
+{
+    sync_policy parse_sync_policy(const std::string &value)
+    {
+        if (value == "none")   return sync_policy::NONE;
+        if (value == "fsync")  return sync_policy::FSYNC;
+        if (value == "direct") return sync_policy::DIRECT;
+        throw arguments_exception("Unknown sync policy '" + value + "'. Should be none, fsync or direct");
+    }
+
+    std::uint64_t parse_count(const std::string &value, const std::string &meaning, const std::string &zero_meaning)
+    {
+        std::size_t parsed = 0;
+        std::uint64_t count = 0;
+        try {
+            count = std::stoull(value, &parsed);
+        } catch (const std::exception &) {
+            parsed = 0;
+        }
+        if (parsed == 0 or parsed != value.length() or value.front() == '-') {
+            throw arguments_exception("Wrong " + meaning + " '" + value + "'. Should be a number, 0 for " + zero_meaning);
+        }
+        return count;
+    }
+
+    std::size_t parse_jobs(const std::string &value)
+    {
+        std::size_t parsed = 0;
+        std::size_t jobs = 0;
+        try {
+            jobs = std::stoul(value, &parsed);
+        } catch (const std::exception &) {
+            parsed = 0;
+        }
+        if (parsed == 0 or parsed != value.length() or jobs == 0) {
+            throw arguments_exception("Wrong number of jobs '" + value + "'. Should be a positive number");
+        }
+        return jobs;
+    }
+
+    std::uint64_t parse_cache_size(const std::string &value)
+    {
+        std::size_t parsed = 0;
+        std::uint64_t size = 0;
+        try {
+            size = std::stoull(value, &parsed);
+        } catch (const std::exception &) {
+            parsed = 0;
+        }
+
+        int shift = 0;
+        if (parsed != 0 and parsed + 1 == value.length()) {
+            switch (value.back()) {
+                case 'K': case 'k': shift = 10; ++parsed; break;
+                case 'M': case 'm': shift = 20; ++parsed; break;
+                case 'G': case 'g': shift = 30; ++parsed; break;
+                default: break;
+            }
+        }
+        if (parsed == 0 or parsed != value.length() or size > (UINT64_MAX >> shift)) {
+            throw arguments_exception("Wrong cache size '" + value + "'. Should be a number of bytes, K, M or G");
+        }
+        return size << shift;
+    }
+
+    // Arguments from the command line, with every @file replaced by its lines
+    std::vector<std::string> expand_response_files(const std::vector<std::string> &arguments)
+    {
+        std::vector<std::string> expanded;
+        for (std::size_t i = 1; i < arguments.size(); ++i) {
+            const auto &arg = arguments[i];
+            if (not arg.starts_with('@')) {
+                expanded.push_back(arg);
+                continue;
+            }
+
+            std::ifstream response(arg.substr(1));
+            if (not response.is_open()) {
+                throw arguments_exception("Can't open response file '" + arg.substr(1) + "'");
+            }
+            std::string line;
+            while (std::getline(response, line)) {
+                if (not line.empty() and line.back() == '\r') line.pop_back();
+                const auto first = line.find_first_not_of(" \t");
+                if (first == std::string::npos) continue;
+                const auto last = line.find_last_not_of(" \t");
+                expanded.push_back(line.substr(first, last - first + 1));
+            }
+        }
+        return expanded;
+    }
+
+    void validate_source_file_path(const std::string &path_to_file)
+    {
+        if (path_to_file.length() < 5 or path_to_file.substr(path_to_file.length() - 4, 4) != ".asm") {
+            throw arguments_exception("Wrong source code file name or extension: \'" + path_to_file
+                                      + "\'. Should be [name].asm");
+        }
+    }
+}
+
+
+assembler_options       mxasm::
+get_options_from_cmd(const std::vector<std::string> &arguments)
+{
+    assembler_options options;
+    options.jobs = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::string> sources;
+    std::vector<std::string> server_side;       // Options a server started with, a client can't change them
+    std::vector<std::string> in_process;        // Options of assembling in this process, e.g. --listing
+
+    auto expanded = expand_response_files(arguments);
+    if (not expanded.empty() and expanded.front() == "run") {
+        options.mode = run_mode::RUN;
+        expanded.erase(expanded.begin());
+    }
+    const auto run_only = [&](const std::string &arg) {
+        if (options.mode != run_mode::RUN) {
+            throw arguments_exception("Option '" + arg + "' is only for 'mxasm run'");
+        }
+    };
+
+    for (const auto &arg : expanded) {
+        if (arg.starts_with("--clock=")) {
+            run_only(arg);
+            options.run.clock_hz = parse_count(arg.substr(8), "clock rate", "full speed");
+        } else if (arg.starts_with("--max-cycles=")) {
+            run_only(arg);
+            options.run.max_cycles = parse_count(arg.substr(13), "cycle limit", "no limit");
+        } else if (arg.starts_with("--seed=")) {
+            run_only(arg);
+            options.run.seed = parse_count(arg.substr(7), "random seed", "a new one every run");
+        } else if (arg == "--profile") {
+            run_only(arg);
+            options.run.profile = true;
+        } else if (arg.starts_with("--stacks=")) {
+            run_only(arg);
+            options.run.stacks_path = arg.substr(9);
+            if (options.run.stacks_path.empty()) {
+                throw arguments_exception("Option '--stacks' needs a file name");
+            }
+        } else if (arg == "--listing") {
+            in_process.push_back(arg);
+            options.output.listing = true;
+        } else if (arg == "--atomic") {
+            options.output.atomic = true;
+        } else if (arg.starts_with("--sync=")) {
+            options.output.sync = parse_sync_policy(arg.substr(7));
+        } else if (arg.starts_with("--jobs=")) {
+            options.jobs = parse_jobs(arg.substr(7));
+        } else if (arg == "--server" or arg.starts_with("--server=")) {
+            options.mode        = run_mode::SERVE;
+            options.socket_path = arg.length() > 9 ? arg.substr(9) : default_socket_path();
+        } else if (arg == "--connect" or arg.starts_with("--connect=")) {
+            options.mode        = run_mode::CONNECT;
+            options.socket_path = arg.length() > 10 ? arg.substr(10) : default_socket_path();
+        } else if (arg == "--cache" or arg.starts_with("--cache=")) {
+            in_process.push_back(arg);
+            options.cache_directory = arg.length() > 8 ? arg.substr(8) : default_cache_directory();
+        } else if (arg.starts_with("--cache-size=")) {
+            in_process.push_back(arg);
+            options.cache_size = parse_cache_size(arg.substr(13));
+        } else if (arg == "--cache-stats") {
+            in_process.push_back(arg);
+            options.cache_stats = true;
+        } else if (arg.starts_with("--max-errors=")) {
+            server_side.push_back(arg);
+            options.pipeline.max_errors = parse_count(arg.substr(13), "maximal number of errors", "no limit");
+        } else if (arg == "--no-zero-page") {
+            server_side.push_back(arg);
+            options.pipeline.encoding.zero_page = false;
+        } else if (arg == "--relax" or arg == "--no-relax") {
+            server_side.push_back(arg);
+            options.pipeline.encoding.relax = arg == "--relax";
+        } else if (arg == "--shrink-jumps") {
+            server_side.push_back(arg);
+            options.pipeline.encoding.shrink_jumps = true;
+        } else if (arg == "--stats" or arg == "--stats=text") {
+            in_process.push_back(arg);
+            options.stats = stats_format::TEXT;
+        } else if (arg == "--stats=json") {
+            in_process.push_back(arg);
+            options.stats = stats_format::JSON;
+        } else if (arg.starts_with("--")) {
+            throw arguments_exception("Unknown option '" + arg + "'");
+        } else {
+            sources.push_back(arg);
+        }
+    }
+
+    if (not in_process.empty() and options.mode != run_mode::ASSEMBLE) {
+        throw arguments_exception("Option '" + in_process.front() + "' is only for assembling in this process");
+    }
+    if (options.mode == run_mode::CONNECT and not server_side.empty()) {
+        throw arguments_exception("Option '" + server_side.front() + "' is not for '--connect', "
+                                  "the server assembles with the options it was started with");
+    }
+    if (options.mode == run_mode::SERVE) {
+        if (not sources.empty()) {
+            throw arguments_exception("Server mode takes no input files");
+        }
+        return options;
+    }
+    if (sources.empty()) {
+        throw arguments_exception("No input file");
+    }
+    if (options.mode == run_mode::RUN and sources.size() != 1) {
+        throw arguments_exception("Run mode takes exactly one input file");
+    }
+    for (const auto &source : sources) {
+        validate_source_file_path(source);
+    }
+    options.source_paths = std::move(sources);
+    return options;
+}
+
+std::string             mxasm::
+get_output_path(const std::string &source_path)
+{ return source_path.substr(0, source_path.length() - 4) + ".bin"; }
+
+std::string             mxasm::
+get_listing_path(const std::string &source_path)
+{ return source_path.substr(0, source_path.length() - 4) + ".lst"; }
+
+std::string             mxasm::
+assembly_fingerprint(const assembler_options &options)
+{
+    return "mxasm " MXASM_VERSION " pipeline=" + std::to_string(PIPELINE_REVISION)
+         + " max-errors=" + std::to_string(options.pipeline.max_errors)
+         + " zero-page=" + (options.pipeline.encoding.zero_page ? "on" : "off")
+         + " relax=" + (options.pipeline.encoding.relax ? "on" : "off")
+         + " shrink-jumps=" + (options.pipeline.encoding.shrink_jumps ? "on" : "off");
+}
@@ -5,6 +5,8 @@
  |       Author: MOlex-dev       |
  *-------------------------------*/
 
+#include <filesystem>
+
 #include "../include/parser.hpp"
 
 using namespace mxasm;
@@ -14,1816 +16,814 @@ using pt_opcode  = parser_token::pt_opcode;
 using st_kind    = serializable_token::st_kind;
 using st_command = serializable_token::st_command;
 using adr_mode   = parser_token::adr_mode;
+using st_mode    = serializable_token::st_mode;
 
 
 parser::
-parser(std::list<lexer_token> &lexed_tokens)
-{ organize_lexer_tokens(lexed_tokens); }
+parser(const std::vector<lexer_token> &lexed_tokens, const std::size_t max_errors, assembly_stats *stats,
+       std::string asset_directory)
+    : m_asset_directory {std::move(asset_directory)}, m_max_errors {max_errors}, m_stats {stats}
+{
+    assembly_stats::timer timer(m_stats, "parser::organize_lexer_tokens");
+    organize_lexer_tokens(lexed_tokens);
+    timer.set_tokens(m_lexer_tokens.size());
+}
 
 
-std::list<serializable_token>     parser::
+const std::vector<serializable_token>&  parser::
 tokens()
 {
     if (m_tokens.empty()) tokenize();
     return m_tokens;
 }
 
-
-void                    parser::
-tokenize()
+std::vector<std::string>    parser::
+assets() const
 {
-    // Convert to parser list
-    std::size_t current_row = 0;
-    for (auto &line : m_lexer_tokens) {
-        for (auto &token : line) {
-            parser_token tk(token);
-            switch (token.kind()) {
-                case lt_kind::BINARY_CONSTANT:
-                    tk.v_number(string_to_number(token.lexeme().substr(1), 2));
-                    tk.kind(pt_kind::NUMBER); break;
-                case lt_kind::OCTAL_CONSTANT:
-                    tk.v_number(string_to_number(token.lexeme().substr(1), 8));
-                    tk.kind(pt_kind::NUMBER); break;
-                case lt_kind::DECIMAL_CONSTANT:
-                    tk.v_number(string_to_number(token.lexeme(), 10));
-                    tk.kind(pt_kind::NUMBER); break;
-                case lt_kind::HEX_CONSTANT:
-                    tk.v_number(string_to_number(token.lexeme().substr(1), 16));
-                    tk.kind(pt_kind::NUMBER); break;
-                case lt_kind::LABEL_DECLARATION:
-                    tk.v_lexeme(token.lexeme().substr(0, token.lexeme().length() - 1));
-                    tk.kind(pt_kind::LABEL_DECLARATION); break;
-                case lt_kind::IDENTIFIER:
-                    if (parser_token::is_opcode_or_register(token.lexeme())) {
-                        tk.v_opcode(parser_token::get_opcode_by_name(token.lexeme()));
-                        tk.kind(pt_kind::OPCODE);
-                    } else {
-                        tk.v_lexeme(token.lexeme());
-                        tk.kind(pt_kind::_IDENTIFIER);
-                    }
-                    break;
-                case lt_kind::ASTERISK:
-                    tk.v_directive(parser_token::pt_directive::CODE_POSITION);
-                    tk.kind(pt_kind::DIRECTIVE); break;
-                case lt_kind::DIRECTIVE:
-                    tk.v_directive(parser_token::get_directive_by_name(token.lexeme().substr(1)));
-                    tk.kind(pt_kind::DIRECTIVE); break;
-                case lt_kind::STRING:
-                    tk.v_lexeme(token.lexeme().substr(1, token.lexeme().length() - 2));
-                    tk.kind(pt_kind::STRING); break;
-                case lt_kind::COMMA:
-                    tk.kind(pt_kind::COMMA); break;
-                case lt_kind::HASH:
-                    tk.kind(pt_kind::HASH); break;
-                case lt_kind::LESS:
-                    tk.kind(pt_kind::LESS); break;
-                case lt_kind::GREATER:
-                    tk.kind(pt_kind::GREATER); break;
-                case lt_kind::LEFT_PARENTHESIS:
-                    tk.kind(pt_kind::LEFT_PARENTHESIS); break;
-                case lt_kind::RIGHT_PARENTHESIS:
-                    tk.kind(pt_kind::RIGHT_PARENTHESIS); break;
-                case lt_kind::EQUALS:
-                    tk.kind(pt_kind::EQUALS); break;
-                default:
-                    add_exception("Unexpected token at [" + std::to_string(token.row()) + ", "
-                                  + std::to_string(token.column()) + "]:\n" + token.lexeme());
-                    continue;
-            }
-            if (token.row() != current_row) {
-                m_parser_tokens.push_back({tk});
-                current_row = token.row();
-                continue;
-            }
-            m_parser_tokens.rbegin()->push_back(tk);
-        }
-    }
-
-
-    // Check directives
-    index_and_replace_constants();
-    validate_numbers_size();
-    validate_code_pos_directives();
-    find_byte_lines();
-
-    if (not m_exceptions.empty()) {
-        throw std::move(m_exceptions);
-    }
-
-    // Rows can start from directive, opcode or label declaration
-    for (const auto &l : m_parser_tokens) {
-        switch (l.begin()->kind()) {
-            case pt_kind::LABEL_DECLARATION:
-            case pt_kind::DIRECTIVE:
-                continue;
-            case pt_kind::OPCODE:
-                if (l.begin()->v_opcode() == parser_token::pt_opcode::REGISTER_X or
-                    l.begin()->v_opcode() == parser_token::pt_opcode::REGISTER_Y or
-                    l.begin()->v_opcode() == parser_token::pt_opcode::REGISTER_A) {
-                    add_exception("Error at line " + std::to_string(l.begin()->row()) + ":\nLine can starts from " \
-                                  "DIRECTIVE, LABEL DECLARATION, or OPCODE, but "
-                                  + parser_token::pt_opcode_to_string(l.begin()->v_opcode())
-                                  + " was found");
-                }
-                continue;
-            default:
-                add_exception("Error at line " + std::to_string(l.begin()->row()) + ":\nLine can starts from " \
-                              "DIRECTIVE, LABEL DECLARATION, or OPCODE, but "
-                              + parser_token::pt_kind_to_string(l.begin()->kind()) + " was found");
-                continue;
-        }
-    }
-
-    if (not m_exceptions.empty()) {
-        throw std::move(m_exceptions);
-    }
-
-    validate_and_replace_labels();
-    if (not m_exceptions.empty()) {
-        throw std::move(m_exceptions);
-    }
-
-    parser_tokens_to_serializable();
-    if (not m_exceptions.empty()) {
-        throw std::move(m_exceptions);
+    std::vector<std::string> paths;
+    paths.reserve(m_assets.size());
+    for (const auto &[path, file] : m_assets) {
+        paths.push_back(path);
     }
+    return paths;
 }
 
-void                    parser::
-validate_numbers_size()
+std::vector<std::string>    parser::
+label_names() const
 {
-    for (const auto &line : m_parser_tokens) {
-        for (const auto &token : line) {
-            if (token.kind() == pt_kind::NUMBER) {
-                if (token.v_number() > 0xFF'FF) {
-                    add_exception("Error at [" + std::to_string(token.row()) + ", " + std::to_string(token.column())
-                                  + "]:\nNumerical constant can't be greater than 0xFF\'FF");
-                }
-            }
-        }
+    std::vector<std::string> names(m_symbols.size());
+    for (const auto &[name, index] : m_symbol_indexes) {
+        if (not m_symbols[index].is_macro) names[index] = name;
     }
+    return names;
 }
 
+
 void                    parser::
-index_and_replace_constants()
+tokenize()
 {
-    std::map<std::string, word_t> macro_table;
-
-    // Find and validate .define
-    for (auto &line : m_parser_tokens) {
-        auto iter = line.begin();
-        auto ln_end = line.end();
-        if (iter->kind() != pt_kind::DIRECTIVE) continue;
-        if (iter->v_directive() != parser_token::pt_directive::MACRO) continue;
-
-        std::string macro_name;
-        word_t      macro_value;
-
-
-        std::advance(iter, 1);
-        if (iter == ln_end) {
-            add_exception("Error at line " + std::to_string(line.cbegin()->row())
-                          + ":\nAn IDENTIFIER was expected, but NEW LINE was found");
-            continue;
-        }
-        if (iter->kind() != pt_kind::_IDENTIFIER) {
-            add_exception("Error at [" + std::to_string(iter->row()) + ", " + std::to_string(iter->column())
-                          + "]:\nAn IDENTIFIER was expected, but " + parser_token::pt_kind_to_string(iter->kind())
-                          + " was found");
-            continue;
-        }
-        if (macro_table.contains(to_lower(iter->v_lexeme()))) {
-            add_exception("Error at line " + std::to_string(iter->row()) + "\nRepeated declaration of macro: "
-                          + iter->v_lexeme());
-            continue;
-        }
-        macro_name = to_lower(iter->v_lexeme());
+    // Every row is converted into the arena and translated right away; the arena never
+    // reallocates, so the rows kept for forward references stay valid
+    {
+        assembly_stats::timer timer(m_stats, "parser::translate");
+        m_token_arena.reserve(m_lexer_tokens.size());
 
-        std::advance(iter, 1);
-        if (iter == ln_end) {
-            add_exception("Error at line " + std::to_string(line.cbegin()->row())
-                          + ":\nA NUMBER was expected, but NEW LINE was found");
-            continue;
-        }
-        if (iter->kind() != pt_kind::NUMBER) {
-            add_exception("Error at [" + std::to_string(iter->row()) + ", " + std::to_string(iter->column())
-                          + "]:\nA NUMBER was expected, but " + parser_token::pt_kind_to_string(iter->kind())
-                          + " was found");
-            continue;
-        }
-        if (iter->v_number() > 0xFF'FF) {
-            add_exception("Error at [" + std::to_string(iter->row()) + ", " + std::to_string(iter->column())
-                          + "]:\nMaximal CONSTANT size is 0xFF'FF");
-            continue;
-        }
-        macro_value = iter->v_number();
-
-        std::advance(iter, 1);
-        if (iter != ln_end) {
-            add_exception("Error at [" + std::to_string(iter->row()) + ", " + std::to_string(iter->column())
-                          + "]:\nA NEW LINE was expected, but " + parser_token::pt_kind_to_string(iter->kind())
-                          + " was found");
-            continue;
-        }
-        macro_table.emplace(macro_name, macro_value);
-    }
+        auto iter = m_lexer_tokens.cbegin();
+        const auto end = m_lexer_tokens.cend();
+        while (iter != end) {
+            const std::size_t row   = iter->row();
+            const std::size_t first = m_token_arena.size();
+            m_stage = parse_stage::TOKENS;
 
-    if (not m_exceptions.empty()) return;
-
-    // Remove macro declarations from parser tokens
-    erase_if(m_parser_tokens, [](auto &line) {
-        return line.begin()->kind() == pt_kind::DIRECTIVE and
-               line.begin()->v_directive() == parser_token::pt_directive::MACRO;
-    });
-
-    // Replace macros code
-    for (auto &line : m_parser_tokens) {
-        for (auto &token : line) {
-            if (token.kind() == pt_kind::_IDENTIFIER) {
-                std::string lex = to_lower(token.v_lexeme());
-                if (macro_table.contains(lex)) {
-                    token.kind(pt_kind::NUMBER);
-                    token.v_number(macro_table.at(lex));
-                } else {
-                    token.kind(pt_kind::LABEL_CALL);
-                }
+            m_converting = true;
+            for (; iter != end and iter->row() == row; ++iter) {
+                parser_token tk(*iter);
+                if (convert_token(*iter, tk)) m_token_arena.push_back(tk);
+            }
+            m_converting = false;
+            if (m_token_arena.size() != first) {
+                parse_line(token_line(m_token_arena.data() + first, m_token_arena.size() - first), false);
             }
+            ++m_line;
+
+            // Token errors come first and in row order, so later rows can't change the report
+            if (m_max_errors != 0 and m_token_errors > m_max_errors) throw_errors();
         }
+        timer.set_tokens(m_tokens.size());
+    }
+    {
+        assembly_stats::timer timer(m_stats, "parser::resolve_forward_references");
+        resolve_forward_references();
+        timer.set_tokens(m_pending_lines.size());
+    }
+    throw_errors();
+}
+
+bool                    parser::
+convert_token(const lexer_token &token, parser_token &tk)
+{
+    switch (token.kind()) {
+        case lt_kind::BINARY_CONSTANT:
+            tk.v_number(string_to_number(token.lexeme().substr(1), 2));
+            tk.kind(pt_kind::NUMBER); break;
+        case lt_kind::OCTAL_CONSTANT:
+            tk.v_number(string_to_number(token.lexeme().substr(1), 8));
+            tk.kind(pt_kind::NUMBER); break;
+        case lt_kind::DECIMAL_CONSTANT:
+            tk.v_number(string_to_number(token.lexeme(), 10));
+            tk.kind(pt_kind::NUMBER); break;
+        case lt_kind::HEX_CONSTANT:
+            tk.v_number(string_to_number(token.lexeme().substr(1), 16));
+            tk.kind(pt_kind::NUMBER); break;
+        case lt_kind::LABEL_DECLARATION:
+            tk.v_lexeme(token.lexeme().substr(0, token.lexeme().length() - 1));
+            tk.kind(pt_kind::LABEL_DECLARATION); break;
+        case lt_kind::IDENTIFIER:
+            if (parser_token::is_opcode_or_register(token.lexeme())) {
+                tk.v_opcode(parser_token::get_opcode_by_name(token.lexeme()));
+                tk.kind(pt_kind::OPCODE);
+            } else {
+                tk.v_lexeme(token.lexeme());
+                tk.kind(pt_kind::_IDENTIFIER);
+            }
+            break;
+        case lt_kind::ASTERISK:
+            tk.v_directive(parser_token::pt_directive::CODE_POSITION);
+            tk.kind(pt_kind::DIRECTIVE); break;
+        case lt_kind::DIRECTIVE:
+            if (not parser_token::is_directive(token.lexeme().substr(1))) {
+                add_error(diagnostic_code::UNKNOWN_DIRECTIVE, token.row(), token.column(), token.lexeme());
+                return false;
+            }
+            tk.v_directive(parser_token::get_directive_by_name(token.lexeme().substr(1)));
+            tk.kind(pt_kind::DIRECTIVE); break;
+        case lt_kind::STRING:
+            tk.v_lexeme(token.lexeme().substr(1, token.lexeme().length() - 2));
+            tk.kind(pt_kind::STRING); break;
+        case lt_kind::COMMA:
+            tk.kind(pt_kind::COMMA); break;
+        case lt_kind::HASH:
+            tk.kind(pt_kind::HASH); break;
+        case lt_kind::LESS:
+            tk.kind(pt_kind::LESS); break;
+        case lt_kind::GREATER:
+            tk.kind(pt_kind::GREATER); break;
+        case lt_kind::LEFT_PARENTHESIS:
+            tk.kind(pt_kind::LEFT_PARENTHESIS); break;
+        case lt_kind::RIGHT_PARENTHESIS:
+            tk.kind(pt_kind::RIGHT_PARENTHESIS); break;
+        case lt_kind::EQUALS:
+            tk.kind(pt_kind::EQUALS); break;
+        default:
+            add_error(diagnostic_code::UNEXPECTED_TOKEN, token.row(), token.column(), token.lexeme());
+            return false;
     }
+    return true;
 }
 
 void                    parser::
-validate_code_pos_directives()
+parse_line(token_line line, const bool fixup)
 {
-    for (auto &line : m_parser_tokens) {
-        auto element = std::find_if(line.begin(), line.end(), [](const auto &token) {
-            return token.kind() == pt_kind::DIRECTIVE and
-                   token.v_directive() == parser_token::pt_directive::CODE_POSITION;
-        });
-
-        auto ast = element;
-        if (element == line.end()) continue;
-        auto ln_end = line.end();
-        std::advance(element, 1);
-
-        if (element == ln_end) {
-            add_exception("Error at line " + std::to_string(element->row())
-                          + ":\nA \'=\' was expected, but NEW LINE was found");
-            continue;
-        }
-        if (element->kind() != pt_kind::EQUALS) {
-            add_exception("Error at [" + std::to_string(element->row()) + ", " + std::to_string(element->column())
-                          + "]:\nA \'=\' was expected, but " + parser_token::pt_kind_to_string(element->kind())
-                          + " was found");
-            continue;
-        }
-
-        std::advance(element, 1);
-        if (element == ln_end) {
-            add_exception("Error at line " + std::to_string(element->row())
-                          + ":\nA NUMBER was expected, but NEW LINE was found");
-            continue;
-        }
-        if (element->kind() != pt_kind::NUMBER) {
-            add_exception("Error at [" + std::to_string(element->row()) + ", " + std::to_string(element->column())
-                          + "]:\nA NUMBER was expected, but " + parser_token::pt_kind_to_string(element->kind())
-                          + " was found");
-            continue;
-        }
-
-        ast->v_number(element->v_number());
-
-        std::advance(element, 1);
-
-        if (element != ln_end) {
-            add_exception("Error at [" + std::to_string(element->row()) + ", " + std::to_string(element->column())
-                          + "]:\nA NEW LINE was expected, but " + parser_token::pt_kind_to_string(element->kind())
-                          + " was found");
-            continue;
-        }
+    const std::size_t first_output = m_tokens.size();
+    const bool has_label_calls = translate_line(line);
+    for (auto token = m_tokens.begin() + first_output; token != m_tokens.end(); ++token) {
+        token->row(static_cast<uint32_t>(line.begin()->row()));
     }
-
-    // REMOVE "=$NUMBER"
-    for (auto &line : m_parser_tokens) {
-        auto element = std::find_if(line.begin(), line.end(), [](const auto &token) {
-            return token.kind() == pt_kind::DIRECTIVE and
-                   token.v_directive() == parser_token::pt_directive::CODE_POSITION;
-        });
-
-        if (element == line.end()) continue;
-        std::advance(element, 1);
-        line.erase(element, line.end());
+    if (has_label_calls and not fixup) {
+        m_pending_lines.push_back({line, m_line, first_output, m_tokens.size()});
     }
 }
 
-void                   parser::
-find_byte_lines()
+bool                    parser::
+translate_line(token_line line)
 {
-    for (auto &line: m_parser_tokens) {
-        auto element = std::find_if(line.begin(), line.end(), [](const auto &token) {
-            return token.kind() == pt_kind::DIRECTIVE and
-            (
-                token.v_directive() == parser_token::pt_directive::BYTE or
-                token.v_directive() == parser_token::pt_directive::WORD
-            );
-        });
+    const std::size_t errors_before = m_diagnostics.size();
 
-        auto opc = element;
-        if (element == line.end()) continue;
-
-        std::advance(element, 1);
-        if (element == line.end()) {
-            add_exception("Error at line " + std::to_string(opc->row())
-                          + ":\nA NUMBER or STRING was expected, but NEW LINE was found");
-            continue;
-        }
-
-        std::vector<word_t> byte_line{};
-        do {
-            if (element->kind() != pt_kind::NUMBER and element->kind() != pt_kind::STRING) {
-                add_exception("Error at [" + std::to_string(element->row()) + ", " + std::to_string(element->column())
-                              + "]:\nA NUMBER or STRING was expected, but " +
-                              parser_token::pt_kind_to_string(element->kind()) + " was found");
-                goto _end;
-            }
-            if (element->kind() == pt_kind::STRING) {
-                for (const auto &c : element->v_lexeme()) {
-                    byte_line.push_back(c);
-                }
-            } else {
-                if (opc->v_directive() == parser_token::pt_directive::BYTE and element->v_number() > 0xFF) {
-                    add_exception("Error at [" + std::to_string(element->row()) + ", " + std::to_string(element->column())
-                                  + "]:\nConstant, defined by BYTE should not be greater than 0xFF");
-                    goto _end;
-                } else if (opc->v_directive() == parser_token::pt_directive::WORD and element->v_number() > 0xFF'FF) {
-                    add_exception("Error at [" + std::to_string(element->row()) + ", " + std::to_string(element->column())
-                                  + "]:\nConstant, defined by WORD should not be greater than 0xFF'FF");
-                    goto _end;
-                }
-                byte_line.push_back(element->v_number());
-            }
-
-            std::advance(element, 1);
-            if (element == line.end()) {
-                goto _end;
-            }
-            if (element->kind() != pt_kind::COMMA) {
-                add_exception("Error at [" + std::to_string(element->row()) + ", " + std::to_string(element->column())
-                              + "]:\nA COMMA was expected, but " +
-                              parser_token::pt_kind_to_string(element->kind()) + " was found");
-                goto _end;
-            }
-
-            std::advance(element, 1);
-            if (element == line.end()) {
-                add_exception("Error at line " + std::to_string(opc->row())
-                              + ":\nA NUMBER or STRING was expected, but NEW LINE was found");
-                goto _end;
-            }
-            if (element->kind() != pt_kind::NUMBER and element->kind() != pt_kind::STRING) {
-                add_exception("Error at [" + std::to_string(element->row()) + ", " + std::to_string(element->column())
-                              + "]:\nA NUMBER or STRING was expected, but " +
-                              parser_token::pt_kind_to_string(element->kind()) + " was found");
-                goto _end;
-            }
-
-        } while (element != line.end());
-_end:
-        opc->v_byteline(byte_line);
-    }
-
-    for (auto &line : m_parser_tokens) {
-        auto element = std::find_if(line.begin(), line.end(), [](const auto &token) {
-            return token.kind() == pt_kind::DIRECTIVE and
-                   (
-                           token.v_directive() == parser_token::pt_directive::BYTE or
-                           token.v_directive() == parser_token::pt_directive::WORD
-                   );
-        });
-
-        if (element == line.end()) continue;
-        std::advance(element, 1);
-        line.erase(element, line.end());
+    m_stage = parse_stage::TOKENS;
+    if (line.begin()->kind() == pt_kind::DIRECTIVE and
+        line.begin()->v_directive() == parser_token::pt_directive::MACRO) {
+        define_macro(line);
+        validate_numbers_size(line);
+        return false;
     }
-}
 
-void                    parser::
-validate_and_replace_labels()
-{
-    std::map<std::string, std::size_t> label_indexes;
+    const bool has_label_calls = replace_symbols(line);
+    validate_numbers_size(line);
+    validate_code_pos_directive(line);
+    find_byte_line(line);
+    find_incbin(line);
+    if (m_diagnostics.size() != errors_before) return has_label_calls;
 
-    std::size_t label_id {0};
-    for (auto iter = m_parser_tokens.begin(); iter != m_parser_tokens.end(); ++iter) {
-        auto &line = *iter;
+    m_stage = parse_stage::LINE_START;
+    validate_line_start(line);
+    if (m_diagnostics.size() != errors_before) return has_label_calls;
 
-        if (line.begin()->kind() != pt_kind::LABEL_DECLARATION) continue;
+    // Every label declaration keeps its own row, the rest of the line follows them
+    m_stage = parse_stage::LABELS;
+    token_line command = line;
+    while (command.begin()->kind() == pt_kind::LABEL_DECLARATION) {
+        if (not declare_label(*command.begin())) break;
 
-        std::string label_name = to_lower(line.begin()->v_lexeme());
-        if (label_indexes.contains(label_name)) {
-            add_exception("Error at line " + std::to_string(line.begin()->row())
-                          + ":\nLabel " + line.begin()->v_lexeme() + " is actually exists");
-            continue;
-        }
-        line.begin()->v_number(label_id);
-        label_indexes.emplace(label_name, label_id);
-        ++label_id;
-
-        auto ti = std::next(line.begin());
-        if (ti != line.end() and ti->kind() != pt_kind::DIRECTIVE) {
+        auto ti = std::next(command.begin());
+        if (ti != command.end() and ti->kind() != pt_kind::DIRECTIVE) {
             if (ti->kind() != pt_kind::OPCODE) {
-                add_exception("Error at line " + std::to_string(line.begin()->row())
-                              + ":\nExpected NEW LINE, OPCODE, or DIRECTIVE, but "
-                              + parser_token::pt_kind_to_string(ti->kind()) + " was found");
+                add_error(diagnostic_code::LINE_END_EXPECTED, command.begin()->row(), 0,
+                          parser_token::pt_kind_to_string(ti->kind()));
             }
             if (ti->v_opcode() == pt_opcode::REGISTER_X or ti->v_opcode() == pt_opcode::REGISTER_Y or
                 ti->v_opcode() == pt_opcode::REGISTER_A) {
-                add_exception("Error at [" + std::to_string(ti->row()) + ", "
-                              + std::to_string(ti->column()) + "]: Expected NEW LINE, OPCODE, or DIRECTIVE, but " \
-                          "REGISTER NAME was found");
+                add_error(diagnostic_code::REGISTER_AFTER_COMMAND, ti->row(), ti->column());
             }
         }
-        if (ti != line.end()) {                                 // TODO POSSIBLE ERROR HERE!
-            m_parser_tokens.insert(std::next(iter), {ti, line.end()});
-        }
-        line.erase(ti, line.end());
+        if (ti == command.end()) break;
+        command = command.subspan(1);
     }
+    if (m_diagnostics.size() != errors_before) return has_label_calls;
 
-
-    for (auto &line : m_parser_tokens) {
-        for (auto &token : line) {
-            if (token.kind() == pt_kind::LABEL_CALL) {
-                std::string lex = to_lower(token.v_lexeme());
-                if (label_indexes.contains(lex)) {
-                    token.v_number(label_indexes.at(lex));
-                    continue;
-                }
-                add_exception("Error at [" + std::to_string(token.row()) + ", " + std::to_string(token.column())
-                              + "]: Non-existed label call\n" + token.v_lexeme());
-            }
-        }
+    m_stage = parse_stage::COMMANDS;
+    for (auto label = line.begin(); label != command.begin(); ++label) {
+        l_decl(label, std::next(label));
     }
+    line_to_serializable(command);
+    return has_label_calls;
 }
 
-
 void                    parser::
-organize_lexer_tokens(std::list<lexer_token> &lexed_tokens)
+resolve_forward_references()
 {
-    std::size_t i = 0;
-    for (auto &token : lexed_tokens) {
-        if (token.is(lt_kind::COMMENT)) continue;
-        if (token.row() != i) {
-            i = token.row();
-            m_lexer_tokens.push_back(std::list<lexer_token>());
+    // Lines that used a macro before its .define are parsed once more. Going from the last one
+    // keeps the output ranges of the earlier lines in place
+    for (auto pending = m_pending_lines.rbegin(); pending != m_pending_lines.rend(); ++pending) {
+        const bool uses_macro = std::any_of(pending->tokens.begin(), pending->tokens.end(), [this](const auto &token) {
+            return token.kind() == pt_kind::LABEL_CALL and m_symbols[token.v_number()].is_macro;
+        });
+        if (not uses_macro) continue;
+
+        m_line = pending->line;
+        std::erase_if(m_diagnostics, [this](const auto &d) {
+            return d.line == m_line and not d.converting;
+        });
+
+        const std::size_t fixed_begin = m_tokens.size();
+        parse_line(pending->tokens, true);
+        std::vector<serializable_token> fixed(std::make_move_iterator(m_tokens.begin() + fixed_begin),
+                                              std::make_move_iterator(m_tokens.end()));
+        m_tokens.erase(m_tokens.begin() + fixed_begin, m_tokens.end());
+        m_tokens.erase(m_tokens.begin() + pending->first_output, m_tokens.begin() + pending->last_output);
+        m_tokens.insert(m_tokens.begin() + pending->first_output, fixed.begin(), fixed.end());
+    }
+
+    // Everything that is left must be a declared label
+    m_stage = parse_stage::LABELS;
+    for (const auto &pending : m_pending_lines) {
+        m_line = pending.line;
+        for (const auto &token : pending.tokens) {
+            if (token.kind() != pt_kind::LABEL_CALL or m_symbols[token.v_number()].declaration) continue;
+            add_error(diagnostic_code::UNDECLARED_LABEL, token.row(), token.column(), token.v_lexeme());
         }
-        m_lexer_tokens.rbegin()->push_back(std::move(token));
     }
 }
 
 void                    parser::
-add_exception(const std::string &exception) noexcept
-{ m_exceptions.emplace_back(new parser_exception(exception)); }
-
-
-#include <iomanip> //TODO: REMOVE THIS LIB
-#include <iostream>
-void                    parser::
-parser_tokens_to_serializable()
+throw_errors()
 {
-    for (auto &line : m_parser_tokens) {
-        auto iter = line.begin();
-        auto iend = line.end();
+    if (m_diagnostics.empty()) return;
 
-        if (iter->kind() == pt_kind::LABEL_DECLARATION) {
-            l_decl(iter, iend);
-            continue;
-        }
+    const auto first_stage = std::min_element(m_diagnostics.begin(), m_diagnostics.end(),
+                                              [](const auto &a, const auto &b) { return a.stage < b.stage; })->stage;
+    std::stable_sort(m_diagnostics.begin(), m_diagnostics.end(),
+                     [](const auto &a, const auto &b) { return a.line < b.line; });
 
-        if (iter->kind() == pt_kind::DIRECTIVE) {
-            switch (iter->v_directive()) {
-                case parser_token::pt_directive::CODE_POSITION: d_code_pos(iter, iend); break;
-                case parser_token::pt_directive::BYTE: d_byteline(iter, iend, st_kind::BYTE); break;
-                case parser_token::pt_directive::WORD: d_byteline(iter, iend, st_kind::WORD); break;
-            }
-            continue;
-        }
-
-        if (iter->kind() == pt_kind::OPCODE) {
-            switch (iter->v_opcode()) {
-                case pt_opcode::BRK: o_opc_imp(iter, iend, serializable_token::st_command::BRK_stk); break;
-                case pt_opcode::CLC: o_opc_imp(iter, iend, serializable_token::st_command::CLC_imp); break;
-                case pt_opcode::CLD: o_opc_imp(iter, iend, serializable_token::st_command::CLD_imp); break;
-                case pt_opcode::CLI: o_opc_imp(iter, iend, serializable_token::st_command::CLI_imp); break;
-                case pt_opcode::CLV: o_opc_imp(iter, iend, serializable_token::st_command::CLV_imp); break;
-                case pt_opcode::DEX: o_opc_imp(iter, iend, serializable_token::st_command::DEX_imp); break;
-                case pt_opcode::DEY: o_opc_imp(iter, iend, serializable_token::st_command::DEY_imp); break;
-                case pt_opcode::INX: o_opc_imp(iter, iend, serializable_token::st_command::INX_imp); break;
-                case pt_opcode::INY: o_opc_imp(iter, iend, serializable_token::st_command::INY_imp); break;
-                case pt_opcode::NOP: o_opc_imp(iter, iend, serializable_token::st_command::NOP_imp); break;
-                case pt_opcode::PHA: o_opc_imp(iter, iend, serializable_token::st_command::PHA_stk); break;
-                case pt_opcode::PHP: o_opc_imp(iter, iend, serializable_token::st_command::PHP_stk); break;
-                case pt_opcode::PHX: o_opc_imp(iter, iend, serializable_token::st_command::PHX_stk); break;
-                case pt_opcode::PHY: o_opc_imp(iter, iend, serializable_token::st_command::PHY_stk); break;
-                case pt_opcode::PLA: o_opc_imp(iter, iend, serializable_token::st_command::PLA_stk); break;
-                case pt_opcode::PLP: o_opc_imp(iter, iend, serializable_token::st_command::PLP_stk); break;
-                case pt_opcode::PLX: o_opc_imp(iter, iend, serializable_token::st_command::PLX_stk); break;
-                case pt_opcode::PLY: o_opc_imp(iter, iend, serializable_token::st_command::PLY_stk); break;
-                case pt_opcode::RTS: o_opc_imp(iter, iend, serializable_token::st_command::RTS_stk); break;
-                case pt_opcode::RTI: o_opc_imp(iter, iend, serializable_token::st_command::RTI_stk); break;
-                case pt_opcode::SEC: o_opc_imp(iter, iend, serializable_token::st_command::SEC_imp); break;
-                case pt_opcode::SED: o_opc_imp(iter, iend, serializable_token::st_command::SED_imp); break;
-                case pt_opcode::SEI: o_opc_imp(iter, iend, serializable_token::st_command::SEI_imp); break;
-                case pt_opcode::STP: o_opc_imp(iter, iend, serializable_token::st_command::STP_imp); break;
-                case pt_opcode::TAX: o_opc_imp(iter, iend, serializable_token::st_command::TAX_imp); break;
-                case pt_opcode::TAY: o_opc_imp(iter, iend, serializable_token::st_command::TAY_imp); break;
-                case pt_opcode::TSX: o_opc_imp(iter, iend, serializable_token::st_command::TSX_imp); break;
-                case pt_opcode::TXA: o_opc_imp(iter, iend, serializable_token::st_command::TXA_imp); break;
-                case pt_opcode::TXS: o_opc_imp(iter, iend, serializable_token::st_command::TXS_imp); break;
-                case pt_opcode::TYA: o_opc_imp(iter, iend, serializable_token::st_command::TYA_imp); break;
-                case pt_opcode::WAI: o_opc_imp(iter, iend, serializable_token::st_command::WAI_imp); break;
-
-                case pt_opcode::JMP: o_jmp(iter, iend); break;
-                case pt_opcode::JSR: o_jsr(iter, iend); break;
-                case pt_opcode::ASL: o_asl(iter, iend); break;
-                case pt_opcode::INC: o_inc(iter, iend); break;
-                case pt_opcode::ROL: o_rol(iter, iend); break;
-                case pt_opcode::DEC: o_dec(iter, iend); break;
-                case pt_opcode::LSR: o_lsr(iter, iend); break;
-                case pt_opcode::ROR: o_ror(iter, iend); break;
-                case pt_opcode::STX: o_stx(iter, iend); break;
-                case pt_opcode::LDX: o_ldx(iter, iend); break;
-                case pt_opcode::TSB: o_tsb(iter, iend); break;
-                case pt_opcode::ORA: o_ora(iter, iend); break;
-                case pt_opcode::TRB: o_trb(iter, iend); break;
-                case pt_opcode::BIT: o_bit(iter, iend); break;
-                case pt_opcode::AND: o_and(iter, iend); break;
-                case pt_opcode::EOR: o_eor(iter, iend); break;
-                case pt_opcode::ADC: o_adc(iter, iend); break;
-                case pt_opcode::CPX: o_cpx(iter, iend); break;
-                case pt_opcode::SBC: o_sbc(iter, iend); break;
-                case pt_opcode::STY: o_sty(iter, iend); break;
-                case pt_opcode::STA: o_sta(iter, iend); break;
-                case pt_opcode::STZ: o_stz(iter, iend); break;
-                case pt_opcode::LDY: o_ldy(iter, iend); break;
-                case pt_opcode::LDA: o_lda(iter, iend); break;
-                case pt_opcode::CPY: o_cpy(iter, iend); break;
-                case pt_opcode::CMP: o_cmp(iter, iend); break;
-
-                case pt_opcode::BPL: o_opc_rel(iter, iend, st_command::BPL_rel); break;
-                case pt_opcode::BMI: o_opc_rel(iter, iend, st_command::BMI_rel); break;
-                case pt_opcode::BVC: o_opc_rel(iter, iend, st_command::BVC_rel); break;
-                case pt_opcode::BVS: o_opc_rel(iter, iend, st_command::BVS_rel); break;
-                case pt_opcode::BRA: o_opc_rel(iter, iend, st_command::BRA_rel); break;
-                case pt_opcode::BCC: o_opc_rel(iter, iend, st_command::BCC_rel); break;
-                case pt_opcode::BCS: o_opc_rel(iter, iend, st_command::BCS_rel); break;
-                case pt_opcode::BNE: o_opc_rel(iter, iend, st_command::BNE_rel); break;
-                case pt_opcode::BEQ: o_opc_rel(iter, iend, st_command::BEQ_rel); break;
-
-                case pt_opcode::RMB0: o_rmb_or_smb(iter, iend, st_command::RMB0_zpg); break;
-                case pt_opcode::RMB1: o_rmb_or_smb(iter, iend, st_command::RMB1_zpg); break;
-                case pt_opcode::RMB2: o_rmb_or_smb(iter, iend, st_command::RMB2_zpg); break;
-                case pt_opcode::RMB3: o_rmb_or_smb(iter, iend, st_command::RMB3_zpg); break;
-                case pt_opcode::RMB4: o_rmb_or_smb(iter, iend, st_command::RMB4_zpg); break;
-                case pt_opcode::RMB5: o_rmb_or_smb(iter, iend, st_command::RMB5_zpg); break;
-                case pt_opcode::RMB6: o_rmb_or_smb(iter, iend, st_command::RMB6_zpg); break;
-                case pt_opcode::RMB7: o_rmb_or_smb(iter, iend, st_command::RMB7_zpg); break;
-                case pt_opcode::SMB0: o_rmb_or_smb(iter, iend, st_command::SMB0_zpg); break;
-                case pt_opcode::SMB1: o_rmb_or_smb(iter, iend, st_command::SMB1_zpg); break;
-                case pt_opcode::SMB2: o_rmb_or_smb(iter, iend, st_command::SMB2_zpg); break;
-                case pt_opcode::SMB3: o_rmb_or_smb(iter, iend, st_command::SMB3_zpg); break;
-                case pt_opcode::SMB4: o_rmb_or_smb(iter, iend, st_command::SMB4_zpg); break;
-                case pt_opcode::SMB5: o_rmb_or_smb(iter, iend, st_command::SMB5_zpg); break;
-                case pt_opcode::SMB6: o_rmb_or_smb(iter, iend, st_command::SMB6_zpg); break;
-                case pt_opcode::SMB7: o_rmb_or_smb(iter, iend, st_command::SMB7_zpg); break;
-
-                case pt_opcode::BBR0: o_bbr_or_bbs(iter, iend, st_command::BBR0_zpr); break;
-                case pt_opcode::BBR1: o_bbr_or_bbs(iter, iend, st_command::BBR1_zpr); break;
-                case pt_opcode::BBR2: o_bbr_or_bbs(iter, iend, st_command::BBR2_zpr); break;
-                case pt_opcode::BBR3: o_bbr_or_bbs(iter, iend, st_command::BBR3_zpr); break;
-                case pt_opcode::BBR4: o_bbr_or_bbs(iter, iend, st_command::BBR4_zpr); break;
-                case pt_opcode::BBR5: o_bbr_or_bbs(iter, iend, st_command::BBR5_zpr); break;
-                case pt_opcode::BBR6: o_bbr_or_bbs(iter, iend, st_command::BBR6_zpr); break;
-                case pt_opcode::BBR7: o_bbr_or_bbs(iter, iend, st_command::BBR7_zpr); break;
-                case pt_opcode::BBS0: o_bbr_or_bbs(iter, iend, st_command::BBS0_zpr); break;
-                case pt_opcode::BBS1: o_bbr_or_bbs(iter, iend, st_command::BBS1_zpr); break;
-                case pt_opcode::BBS2: o_bbr_or_bbs(iter, iend, st_command::BBS2_zpr); break;
-                case pt_opcode::BBS3: o_bbr_or_bbs(iter, iend, st_command::BBS3_zpr); break;
-                case pt_opcode::BBS4: o_bbr_or_bbs(iter, iend, st_command::BBS4_zpr); break;
-                case pt_opcode::BBS5: o_bbr_or_bbs(iter, iend, st_command::BBS5_zpr); break;
-                case pt_opcode::BBS6: o_bbr_or_bbs(iter, iend, st_command::BBS6_zpr); break;
-                case pt_opcode::BBS7: o_bbr_or_bbs(iter, iend, st_command::BBS7_zpr); break;
-
-            }
-            continue;
+    diagnostic_list errors;
+    for (const auto &d : m_diagnostics) {
+        if (d.stage != first_stage) continue;
+        if (m_max_errors != 0 and errors.size() == m_max_errors) {
+            errors.add(diagnostic_code::TOO_MANY_ERRORS, 0, 0, std::to_string(m_max_errors));
+            break;
         }
-
-        add_exception("Unknown token at [" + std::to_string(iter->row()) + ", " + std::to_string(iter->column())
-                      + "]:\nCommand can starts from OPCODE, LABEL DECLARATION, or DIRECTIVE, but "
-                      + parser_token::pt_kind_to_string(iter->kind()) + " was found");
+        errors.add(d.error.code, d.error.row, d.error.column,
+                   std::string_view(m_error_arguments).substr(d.error.argument_offset, d.error.argument_size));
     }
+    m_diagnostics.clear();
+    m_error_arguments.clear();
+    throw std::move(errors);
 }
 
 void                    parser::
-l_decl(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
+define_macro(token_line line)
 {
-    serializable_token stoken(st_kind::LABEL);
-    stoken.number(beg->v_number());
-    validate_end_of_command(beg, end);
-    m_tokens.push_back(stoken);
-}
+    auto iter = line.begin();
+    auto ln_end = line.end();
 
-void                    parser::
-d_code_pos(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
-{
-    serializable_token stoken(st_kind::CODE_POS);
-    stoken.number(beg->v_number());
-    validate_end_of_command(beg, end);
-    m_tokens.push_back(stoken);
-}
+    std::advance(iter, 1);
+    if (iter == ln_end) {
+        add_error(diagnostic_code::IDENTIFIER_MISSING, line.begin()->row(), 0);
+        return;
+    }
+    if (iter->kind() != pt_kind::_IDENTIFIER) {
+        add_error(diagnostic_code::IDENTIFIER_EXPECTED, iter->row(), iter->column(),
+                  parser_token::pt_kind_to_string(iter->kind()));
+        return;
+    }
+    const std::size_t index = symbol_index(iter->v_lexeme());
+    if (m_symbols[index].is_macro) {
+        add_error(diagnostic_code::REPEATED_MACRO, iter->row(), 0, iter->v_lexeme());
+        return;
+    }
 
-void                    parser::
-d_byteline(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end,
-           serializable_token::st_kind dir_type)
-{
-    serializable_token stoken(dir_type);
-    stoken.byteline(beg->v_byteline());
-    validate_end_of_command(beg, end);
-    m_tokens.push_back(stoken);
-}
+    std::advance(iter, 1);
+    if (iter == ln_end) {
+        add_error(diagnostic_code::NUMBER_MISSING, line.begin()->row(), 0);
+        return;
+    }
+    if (iter->kind() != pt_kind::NUMBER) {
+        add_error(diagnostic_code::NUMBER_EXPECTED, iter->row(), iter->column(),
+                  parser_token::pt_kind_to_string(iter->kind()));
+        return;
+    }
+    if (iter->v_number() > 0xFF'FF) {
+        add_error(diagnostic_code::CONSTANT_TOO_BIG, iter->row(), iter->column());
+        return;
+    }
+    const word_t macro_value = iter->v_number();
 
-void                    parser::
-o_opc_imp(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end,
-          serializable_token::st_command opc)
-{
-    serializable_token stoken(serializable_token::st_kind::OPCODE);
-    stoken.command(opc);
-    validate_end_of_command(beg, end);
-    m_tokens.push_back(stoken);
+    std::advance(iter, 1);
+    if (iter != ln_end) {
+        add_error(diagnostic_code::NEW_LINE_EXPECTED, iter->row(), iter->column(),
+                  parser_token::pt_kind_to_string(iter->kind()));
+        return;
+    }
+    m_symbols[index].is_macro = true;
+    m_symbols[index].value = macro_value;
 }
 
-void                    parser::
-o_opc_rel(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end,
-          serializable_token::st_command opc)
+bool                    parser::
+replace_symbols(token_line line)
 {
-    serializable_token stoken(st_kind::OPCODE);
-    if (define_addr_mode(std::next(beg), end) == adr_mode::ABS_or_REL) {
-        stoken.command(opc);
-        stoken.number(std::next(beg)->v_number());
-        if (std::next(beg)->kind() != pt_kind::LABEL_CALL) goto _err;
-    } else {
-_err:
-        add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for " +
-        parser_token::pt_kind_to_string(beg->kind()));
+    // Known macros become numbers, the rest are label calls by symbol index
+    bool has_label_calls = false;
+    for (auto &token : line) {
+        if (token.kind() != pt_kind::_IDENTIFIER and token.kind() != pt_kind::LABEL_CALL) continue;
+
+        const std::size_t index = symbol_index(token.v_lexeme());
+        if (m_symbols[index].is_macro) {
+            token.kind(pt_kind::NUMBER);
+            token.v_number(m_symbols[index].value);
+        } else {
+            token.kind(pt_kind::LABEL_CALL);
+            token.v_number(index);
+            has_label_calls = true;
+        }
     }
-    m_tokens.push_back(stoken);
+    return has_label_calls;
 }
 
 void                    parser::
-o_rmb_or_smb(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end,
-             serializable_token::st_command opc)
+validate_numbers_size(token_line line)
 {
-    serializable_token stoken(st_kind::OPCODE);
-    if (define_addr_mode(std::next(beg), end) == adr_mode::ZP) {
-        stoken.command(opc);
-        stoken.number(std::next(beg)->v_number());
-    } else {
-        add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for RMB or SMB");
+    for (const auto &token : line) {
+        if (token.kind() == pt_kind::NUMBER) {
+            if (token.v_number() > 0xFF'FF) {
+                add_error(diagnostic_code::NUMBER_TOO_BIG, token.row(), token.column());
+            }
+        }
     }
-    m_tokens.push_back(stoken);
 }
 
 void                    parser::
-o_bbr_or_bbs(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end,
-             serializable_token::st_command opc)
+validate_code_pos_directive(token_line &line)
 {
-    serializable_token stoken(st_kind::OPCODE);
-    if (define_addr_mode(std::next(beg), end) == adr_mode::ZP_REL) {
-        stoken.command(opc);
-        std::advance(beg, 1);
-        stoken.number(beg->v_number());
-        std::advance(beg, 2);
-        stoken.byteline({word_t(beg->v_number())});
-    } else {
-        add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for BBR or BBS");
-    }
-    m_tokens.push_back(stoken);
-}
+    auto element = std::find_if(line.begin(), line.end(), [](const auto &token) {
+        return token.kind() == pt_kind::DIRECTIVE and
+               token.v_directive() == parser_token::pt_directive::CODE_POSITION;
+    });
 
+    auto ast = element;
+    if (element == line.end()) return;
+    auto ln_end = line.end();
+    std::advance(element, 1);
 
-// ------------------------------------- INSTRUCTIONS -------------------------------------
-void                    parser::
-o_jmp(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
-{
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::JMP_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ABS_IND:
-            stoken.command(st_command::JMP_ind);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            if (beg->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ABS_X_IND:
-            stoken.command(st_command::JMP_iax);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            if (beg->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for JMP");
+    if (element == ln_end) {
+        add_error(diagnostic_code::EQUALS_MISSING, ast->row(), 0);
+        return;
     }
-    m_tokens.push_back(stoken);
-}
-
-void                    parser::
-o_jsr(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
-{
-    serializable_token stoken(st_kind::OPCODE);
-    if (define_addr_mode(std::next(beg), end) == adr_mode::ABS_or_REL) {
-        stoken.command(st_command::JSR_abs);
-        stoken.number(std::next(beg)->v_number());
-        if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-        else { stoken.labelable(false); }
-    } else {
-        add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for JSR");
+    if (element->kind() != pt_kind::EQUALS) {
+        add_error(diagnostic_code::EQUALS_EXPECTED, element->row(), element->column(),
+                  parser_token::pt_kind_to_string(element->kind()));
+        return;
     }
-    m_tokens.push_back(stoken);
-}
 
-void                    parser::
-o_asl(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
-{
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::ASL_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::A:
-        case adr_mode::STK_or_IMP:
-            stoken.command(st_command::ASL_a);
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::ASL_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ZP_X:
-            stoken.command(st_command::ASL_zpx);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ABS_X:
-            stoken.command(st_command::ASL_abx);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for ASL");
+    std::advance(element, 1);
+    if (element == ln_end) {
+        add_error(diagnostic_code::NUMBER_MISSING, ast->row(), 0);
+        return;
     }
-    m_tokens.push_back(stoken);
-}
-
-void                    parser::
-o_inc(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
-{
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::INC_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::A:
-        case adr_mode::STK_or_IMP:
-            stoken.command(st_command::INC_a);
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::INC_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ZP_X:
-            stoken.command(st_command::INC_zpx);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ABS_X:
-            stoken.command(st_command::INC_abx);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for INC");
+    if (element->kind() != pt_kind::NUMBER) {
+        add_error(diagnostic_code::NUMBER_EXPECTED, element->row(), element->column(),
+                  parser_token::pt_kind_to_string(element->kind()));
+        return;
     }
-    m_tokens.push_back(stoken);
-}
 
-void                    parser::
-o_rol(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
-{
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::ROL_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::A:
-        case adr_mode::STK_or_IMP:
-            stoken.command(st_command::ROL_a);
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::ROL_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ZP_X:
-            stoken.command(st_command::ROL_zpx);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ABS_X:
-            stoken.command(st_command::ROL_abx);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for ROL");
-    }
-    m_tokens.push_back(stoken);
-}
+    ast->v_number(element->v_number());
 
-void                    parser::
-o_dec(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
-{
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::DEC_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::A:
-        case adr_mode::STK_or_IMP:
-            stoken.command(st_command::DEC_a);
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::DEC_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ZP_X:
-            stoken.command(st_command::DEC_zpx);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ABS_X:
-            stoken.command(st_command::DEC_abx);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for DEC");
+    std::advance(element, 1);
+    if (element != ln_end) {
+        add_error(diagnostic_code::NEW_LINE_EXPECTED, element->row(), element->column(),
+                  parser_token::pt_kind_to_string(element->kind()));
+        return;
     }
-    m_tokens.push_back(stoken);
-}
 
-void                    parser::
-o_lsr(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
-{
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::LSR_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::A:
-        case adr_mode::STK_or_IMP:
-            stoken.command(st_command::LSR_a);
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::LSR_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ZP_X:
-            stoken.command(st_command::LSR_zpx);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ABS_X:
-            stoken.command(st_command::LSR_abx);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for LSR");
-    }
-    m_tokens.push_back(stoken);
+    // REMOVE "=$NUMBER"
+    line = line.first(std::distance(line.begin(), ast) + 1);
 }
 
-void                    parser::
-o_ror(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
-{
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::ROR_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::A:
-        case adr_mode::STK_or_IMP:
-            stoken.command(st_command::ROR_a);
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::ROR_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ZP_X:
-            stoken.command(st_command::ROR_zpx);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ABS_X:
-            stoken.command(st_command::ROR_abx);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for ROR");
-    }
-    m_tokens.push_back(stoken);
-}
+void                   parser::
+find_byte_line(token_line &line)
+{
+    auto element = std::find_if(line.begin(), line.end(), [](const auto &token) {
+        return token.kind() == pt_kind::DIRECTIVE and
+        (
+            token.v_directive() == parser_token::pt_directive::BYTE or
+            token.v_directive() == parser_token::pt_directive::WORD
+        );
+    });
 
-void                    parser::
-o_stx(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
-{
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::STX_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::STX_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ZP_Y:
-            stoken.command(st_command::STX_zpy);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for STX");
+    auto opc = element;
+    if (element == line.end()) return;
+
+    std::advance(element, 1);
+    if (element == line.end()) {
+        add_error(diagnostic_code::DATA_MISSING, opc->row(), 0);
+        return;
     }
-    m_tokens.push_back(stoken);
-}
 
-void                    parser::
-o_ldx(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
-{
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::LDX_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::LDX_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ZP_Y:
-            stoken.command(st_command::LDX_zpy);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ABS_Y:
-            stoken.command(st_command::LDX_aby);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::IMM:
-            stoken.command(st_command::LDX_imm);
-            std::advance(beg, 2);
-            if (beg->kind() == pt_kind::NUMBER) {
-                stoken.number(beg->v_number());
-            } else if (beg->kind() == pt_kind::LESS) {
-                stoken.number(std::next(beg)->v_number());
-                stoken.byteline({'<'});
-            } else if (beg->kind() == pt_kind::GREATER) {
-                stoken.number(std::next(beg)->v_number());
-                stoken.byteline({'>'});
+    std::vector<word_t> byte_line{};
+    do {
+        if (element->kind() != pt_kind::NUMBER and element->kind() != pt_kind::STRING) {
+            add_error(diagnostic_code::DATA_EXPECTED, element->row(), element->column(),
+                      parser_token::pt_kind_to_string(element->kind()));
+            goto _end;
+        }
+        if (element->kind() == pt_kind::STRING) {
+            for (const auto &c : element->v_lexeme()) {
+                byte_line.push_back(c);
             }
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for LDX");
-    }
-    m_tokens.push_back(stoken);
+        } else {
+            if (opc->v_directive() == parser_token::pt_directive::BYTE and element->v_number() > 0xFF) {
+                add_error(diagnostic_code::BYTE_TOO_BIG, element->row(), element->column());
+                goto _end;
+            } else if (opc->v_directive() == parser_token::pt_directive::WORD and element->v_number() > 0xFF'FF) {
+                add_error(diagnostic_code::WORD_TOO_BIG, element->row(), element->column());
+                goto _end;
+            }
+            byte_line.push_back(element->v_number());
+        }
+
+        std::advance(element, 1);
+        if (element == line.end()) {
+            goto _end;
+        }
+        if (element->kind() != pt_kind::COMMA) {
+            add_error(diagnostic_code::COMMA_EXPECTED, element->row(), element->column(),
+                      parser_token::pt_kind_to_string(element->kind()));
+            goto _end;
+        }
+
+        std::advance(element, 1);
+        if (element == line.end()) {
+            add_error(diagnostic_code::DATA_MISSING, opc->row(), 0);
+            goto _end;
+        }
+        if (element->kind() != pt_kind::NUMBER and element->kind() != pt_kind::STRING) {
+            add_error(diagnostic_code::DATA_EXPECTED, element->row(), element->column(),
+                      parser_token::pt_kind_to_string(element->kind()));
+            goto _end;
+        }
+
+    } while (element != line.end());
+_end:
+    opc->v_byteline(byte_line);
+    line = line.first(std::distance(line.begin(), opc) + 1);
 }
 
 void                    parser::
-o_tsb(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
+find_incbin(token_line &line)
 {
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::TSB_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::TSB_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for TSB");
+    // .incbin "file"[, offset[, length]]
+    auto element = std::find_if(line.begin(), line.end(), [](const auto &token) {
+        return token.kind() == pt_kind::DIRECTIVE and token.v_directive() == parser_token::pt_directive::INCBIN;
+    });
+
+    auto opc = element;
+    if (element == line.end()) return;
+
+    std::advance(element, 1);
+    if (element == line.end()) {
+        add_error(diagnostic_code::FILE_NAME_MISSING, opc->row(), 0);
+        return;
     }
-    m_tokens.push_back(stoken);
-}
+    if (element->kind() != pt_kind::STRING) {
+        add_error(diagnostic_code::FILE_NAME_EXPECTED, element->row(), element->column(),
+                  parser_token::pt_kind_to_string(element->kind()));
+        return;
+    }
+    opc->v_lexeme(element->v_lexeme());
 
-void                    parser::
-o_ora(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
-{
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::ORA_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::ORA_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ZP_X:
-            stoken.command(st_command::ORA_zpx);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ABS_X:
-            stoken.command(st_command::ORA_abx);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ABS_Y:
-            stoken.command(st_command::ORA_aby);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::IMM:
-            stoken.command(st_command::ORA_imm);
-            std::advance(beg, 2);
-            if (beg->kind() == pt_kind::NUMBER) {
-                stoken.number(beg->v_number());
-            } else if (beg->kind() == pt_kind::LESS) {
-                stoken.number(std::next(beg)->v_number());
-                stoken.byteline({'<'});
-            } else if (beg->kind() == pt_kind::GREATER) {
-                stoken.number(std::next(beg)->v_number());
-                stoken.byteline({'>'});
-            }
-            break;
-        case adr_mode::ZP_IND:
-            stoken.command(st_command::ORA_izp);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        case adr_mode::ZP_IND_Y:
-            stoken.command(st_command::ORA_izy);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        case adr_mode::ZP_X_IND:
-            stoken.command(st_command::ORA_izx);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for ORA");
+    std::vector<word_t> range {};
+    for (std::advance(element, 1); element != line.end() and range.size() < 2; std::advance(element, 1)) {
+        if (element->kind() != pt_kind::COMMA) {
+            add_error(diagnostic_code::COMMA_EXPECTED, element->row(), element->column(),
+                      parser_token::pt_kind_to_string(element->kind()));
+            return;
+        }
+        std::advance(element, 1);
+        if (element == line.end()) {
+            add_error(diagnostic_code::NUMBER_MISSING, opc->row(), 0);
+            return;
+        }
+        if (element->kind() != pt_kind::NUMBER) {
+            add_error(diagnostic_code::NUMBER_EXPECTED, element->row(), element->column(),
+                      parser_token::pt_kind_to_string(element->kind()));
+            return;
+        }
+        range.push_back(element->v_number());
     }
-    m_tokens.push_back(stoken);
+    if (element != line.end()) {
+        add_error(diagnostic_code::NEW_LINE_EXPECTED, element->row(), element->column(),
+                  parser_token::pt_kind_to_string(element->kind()));
+        return;
+    }
+
+    opc->v_byteline(range);
+    line = line.first(std::distance(line.begin(), opc) + 1);
 }
 
 void                    parser::
-o_trb(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
+validate_line_start(token_line line)
 {
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::TRB_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::TRB_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
+    // Rows can start from directive, opcode or label declaration
+    switch (line.begin()->kind()) {
+        case pt_kind::LABEL_DECLARATION:
+        case pt_kind::DIRECTIVE:
+            return;
+        case pt_kind::OPCODE:
+            if (line.begin()->v_opcode() == parser_token::pt_opcode::REGISTER_X or
+                line.begin()->v_opcode() == parser_token::pt_opcode::REGISTER_Y or
+                line.begin()->v_opcode() == parser_token::pt_opcode::REGISTER_A) {
+                add_error(diagnostic_code::LINE_START_EXPECTED, line.begin()->row(), 0,
+                          parser_token::pt_opcode_to_string(line.begin()->v_opcode()));
+            }
+            return;
         default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for TRB");
+            add_error(diagnostic_code::LINE_START_EXPECTED, line.begin()->row(), 0,
+                      parser_token::pt_kind_to_string(line.begin()->kind()));
+            return;
     }
-    m_tokens.push_back(stoken);
 }
 
-void                    parser::
-o_bit(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
+bool                    parser::
+declare_label(parser_token &token)
 {
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::BIT_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::BIT_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ZP_X:
-            stoken.command(st_command::BIT_zpx);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ABS_X:
-            stoken.command(st_command::BIT_abx);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::IMM:
-            stoken.command(st_command::BIT_imm);
-            std::advance(beg, 2);
-            if (beg->kind() == pt_kind::NUMBER) {
-                stoken.number(beg->v_number());
-            } else if (beg->kind() == pt_kind::LESS) {
-                stoken.number(std::next(beg)->v_number());
-                stoken.byteline({'<'});
-            } else if (beg->kind() == pt_kind::GREATER) {
-                stoken.number(std::next(beg)->v_number());
-                stoken.byteline({'>'});
-            }
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for BIT");
+    const std::size_t index = symbol_index(token.v_lexeme());
+    if (m_symbols[index].declaration and m_symbols[index].declaration != &token) {
+        add_error(diagnostic_code::REPEATED_LABEL, token.row(), 0, token.v_lexeme());
+        return false;
     }
-    m_tokens.push_back(stoken);
+    m_symbols[index].declaration = &token;
+    token.v_number(index);
+    return true;
 }
 
-void                    parser::
-o_and(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
+std::size_t             parser::
+symbol_index(const std::string_view name)
 {
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::AND_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::AND_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ZP_X:
-            stoken.command(st_command::AND_zpx);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ABS_X:
-            stoken.command(st_command::AND_abx);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ABS_Y:
-            stoken.command(st_command::AND_aby);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::IMM:
-            stoken.command(st_command::AND_imm);
-            std::advance(beg, 2);
-            if (beg->kind() == pt_kind::NUMBER) {
-                stoken.number(beg->v_number());
-            } else if (beg->kind() == pt_kind::LESS) {
-                stoken.number(std::next(beg)->v_number());
-                stoken.byteline({'<'});
-            } else if (beg->kind() == pt_kind::GREATER) {
-                stoken.number(std::next(beg)->v_number());
-                stoken.byteline({'>'});
-            }
-            break;
-        case adr_mode::ZP_IND:
-            stoken.command(st_command::AND_izp);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        case adr_mode::ZP_IND_Y:
-            stoken.command(st_command::AND_izy);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        case adr_mode::ZP_X_IND:
-            stoken.command(st_command::AND_izx);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for AND");
-    }
-    m_tokens.push_back(stoken);
+    const auto [iter, inserted] = m_symbol_indexes.try_emplace(name, m_symbols.size());
+    if (inserted) m_symbols.emplace_back();
+    return iter->second;
 }
 
+
 void                    parser::
-o_eor(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
+organize_lexer_tokens(const std::vector<lexer_token> &lexed_tokens)
 {
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::EOR_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::EOR_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ZP_X:
-            stoken.command(st_command::EOR_zpx);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ABS_X:
-            stoken.command(st_command::EOR_abx);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ABS_Y:
-            stoken.command(st_command::EOR_aby);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::IMM:
-            stoken.command(st_command::EOR_imm);
-            std::advance(beg, 2);
-            if (beg->kind() == pt_kind::NUMBER) {
-                stoken.number(beg->v_number());
-            } else if (beg->kind() == pt_kind::LESS) {
-                stoken.number(std::next(beg)->v_number());
-                stoken.byteline({'<'});
-            } else if (beg->kind() == pt_kind::GREATER) {
-                stoken.number(std::next(beg)->v_number());
-                stoken.byteline({'>'});
-            }
-            break;
-        case adr_mode::ZP_IND:
-            stoken.command(st_command::EOR_izp);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        case adr_mode::ZP_IND_Y:
-            stoken.command(st_command::EOR_izy);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        case adr_mode::ZP_X_IND:
-            stoken.command(st_command::EOR_izx);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for EOR");
+    m_lexer_tokens.reserve(lexed_tokens.size());
+    for (const auto &token : lexed_tokens) {
+        if (token.is(lt_kind::COMMENT)) continue;
+        m_lexer_tokens.push_back(token);
     }
-    m_tokens.push_back(stoken);
 }
 
 void                    parser::
-o_adc(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
+add_error(const diagnostic_code code, const std::size_t row, const std::size_t column, const std::string_view argument)
 {
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::ADC_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::ADC_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ZP_X:
-            stoken.command(st_command::ADC_zpx);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ABS_X:
-            stoken.command(st_command::ADC_abx);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ABS_Y:
-            stoken.command(st_command::ADC_aby);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::IMM:
-            stoken.command(st_command::ADC_imm);
-            std::advance(beg, 2);
-            if (beg->kind() == pt_kind::NUMBER) {
-                stoken.number(beg->v_number());
-            } else if (beg->kind() == pt_kind::LESS) {
-                stoken.number(std::next(beg)->v_number());
-                stoken.byteline({'<'});
-            } else if (beg->kind() == pt_kind::GREATER) {
-                stoken.number(std::next(beg)->v_number());
-                stoken.byteline({'>'});
-            }
-            break;
-        case adr_mode::ZP_IND:
-            stoken.command(st_command::ADC_izp);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        case adr_mode::ZP_IND_Y:
-            stoken.command(st_command::ADC_izy);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        case adr_mode::ZP_X_IND:
-            stoken.command(st_command::ADC_izx);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for ADC");
-    }
-    m_tokens.push_back(stoken);
+    if (m_stage == parse_stage::TOKENS) ++m_token_errors;
+    m_diagnostics.push_back({m_stage, m_line, m_converting,
+                             {code, static_cast<uint32_t>(row), static_cast<uint32_t>(column),
+                              static_cast<uint32_t>(m_error_arguments.size()), static_cast<uint32_t>(argument.size())}});
+    m_error_arguments += argument;
 }
 
+
 void                    parser::
-o_cpx(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
+line_to_serializable(token_line line)
 {
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::CPX_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::CPX_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::IMM:
-            stoken.command(st_command::CPX_imm);
-            std::advance(beg, 2);
-            if (beg->kind() == pt_kind::NUMBER) {
-                stoken.number(beg->v_number());
-            } else if (beg->kind() == pt_kind::LESS) {
-                stoken.number(std::next(beg)->v_number());
-                stoken.byteline({'<'});
-            } else if (beg->kind() == pt_kind::GREATER) {
-                stoken.number(std::next(beg)->v_number());
-                stoken.byteline({'>'});
-            }
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for CPX");
+    auto iter = line.begin();
+    auto iend = line.end();
+
+    if (iter->kind() == pt_kind::LABEL_DECLARATION) {
+        l_decl(iter, iend);
+        return;
     }
-    m_tokens.push_back(stoken);
-}
 
-void                    parser::
-o_sbc(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
-{
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::SBC_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::SBC_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ZP_X:
-            stoken.command(st_command::SBC_zpx);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ABS_X:
-            stoken.command(st_command::SBC_abx);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ABS_Y:
-            stoken.command(st_command::SBC_aby);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::IMM:
-            stoken.command(st_command::SBC_imm);
-            std::advance(beg, 2);
-            if (beg->kind() == pt_kind::NUMBER) {
-                stoken.number(beg->v_number());
-            } else if (beg->kind() == pt_kind::LESS) {
-                stoken.number(std::next(beg)->v_number());
-                stoken.byteline({'<'});
-            } else if (beg->kind() == pt_kind::GREATER) {
-                stoken.number(std::next(beg)->v_number());
-                stoken.byteline({'>'});
-            }
-            break;
-        case adr_mode::ZP_IND:
-            stoken.command(st_command::SBC_izp);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        case adr_mode::ZP_IND_Y:
-            stoken.command(st_command::SBC_izy);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        case adr_mode::ZP_X_IND:
-            stoken.command(st_command::SBC_izx);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for SBC");
+    if (iter->kind() == pt_kind::DIRECTIVE) {
+        switch (iter->v_directive()) {
+            case parser_token::pt_directive::CODE_POSITION: d_code_pos(iter, iend); break;
+            case parser_token::pt_directive::BYTE: d_byteline(iter, iend, st_kind::BYTE); break;
+            case parser_token::pt_directive::WORD: d_byteline(iter, iend, st_kind::WORD); break;
+            case parser_token::pt_directive::INCBIN: d_incbin(iter, iend); break;
+            case parser_token::pt_directive::MACRO:
+                // Only a whole line defines a macro, not a command behind a label
+                add_error(diagnostic_code::UNEXPECTED_TOKEN, iter->row(), iter->column(), iter->base_token().lexeme());
+                break;
+        }
+        return;
     }
-    m_tokens.push_back(stoken);
-}
 
-void                    parser::
-o_sty(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
-{
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::STY_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::STY_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ZP_X:
-            stoken.command(st_command::STY_zpx);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for STY");
+    if (iter->kind() == pt_kind::OPCODE) {
+        o_command(iter, iend);
+        return;
     }
-    m_tokens.push_back(stoken);
+
+    add_error(diagnostic_code::UNKNOWN_COMMAND_START, iter->row(), iter->column(),
+              parser_token::pt_kind_to_string(iter->kind()));
 }
 
 void                    parser::
-o_sta(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
+l_decl(token_line::iterator beg, token_line::iterator end)
 {
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::STA_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::STA_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ZP_X:
-            stoken.command(st_command::STA_zpx);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ABS_X:
-            stoken.command(st_command::STA_abx);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ABS_Y:
-            stoken.command(st_command::STA_aby);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ZP_IND:
-            stoken.command(st_command::STA_izp);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        case adr_mode::ZP_IND_Y:
-            stoken.command(st_command::STA_izy);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        case adr_mode::ZP_X_IND:
-            stoken.command(st_command::STA_izx);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for STA");
-    }
+    serializable_token stoken(st_kind::LABEL);
+    stoken.number(beg->v_number());
+    validate_end_of_command(beg, end);
     m_tokens.push_back(stoken);
 }
 
 void                    parser::
-o_stz(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
+d_code_pos(token_line::iterator beg, token_line::iterator end)
 {
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::STZ_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::STZ_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ZP_X:
-            stoken.command(st_command::STZ_zpx);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ABS_X:
-            stoken.command(st_command::STZ_abx);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for STZ");
-    }
+    serializable_token stoken(st_kind::CODE_POS);
+    stoken.number(beg->v_number());
+    validate_end_of_command(beg, end);
     m_tokens.push_back(stoken);
 }
 
 void                    parser::
-o_ldy(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
+d_byteline(token_line::iterator beg, token_line::iterator end,
+           serializable_token::st_kind dir_type)
 {
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::LDY_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::LDY_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ZP_X:
-            stoken.command(st_command::LDY_zpx);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ABS_X:
-            stoken.command(st_command::LDY_abx);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::IMM:
-            stoken.command(st_command::LDY_imm);
-            std::advance(beg, 2);
-            if (beg->kind() == pt_kind::NUMBER) {
-                stoken.number(beg->v_number());
-            } else if (beg->kind() == pt_kind::LESS) {
-                stoken.number(std::next(beg)->v_number());
-                stoken.byteline({'<'});
-            } else if (beg->kind() == pt_kind::GREATER) {
-                stoken.number(std::next(beg)->v_number());
-                stoken.byteline({'>'});
-            }
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for LDY");
-    }
+    serializable_token stoken(dir_type);
+    stoken.byteline(beg->v_byteline());
+    validate_end_of_command(beg, end);
     m_tokens.push_back(stoken);
 }
 
 void                    parser::
-o_lda(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
+d_incbin(token_line::iterator beg, token_line::iterator end)
 {
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::LDA_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::LDA_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ZP_X:
-            stoken.command(st_command::LDA_zpx);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ABS_X:
-            stoken.command(st_command::LDA_abx);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ABS_Y:
-            stoken.command(st_command::LDA_aby);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::IMM:
-            stoken.command(st_command::LDA_imm);
-            std::advance(beg, 2);
-            if (beg->kind() == pt_kind::NUMBER) {
-                stoken.number(beg->v_number());
-            } else if (beg->kind() == pt_kind::LESS) {
-                stoken.number(std::next(beg)->v_number());
-                stoken.byteline({'<'});
-            } else if (beg->kind() == pt_kind::GREATER) {
-                stoken.number(std::next(beg)->v_number());
-                stoken.byteline({'>'});
-            }
-            break;
-        case adr_mode::ZP_IND:
-            stoken.command(st_command::LDA_izp);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        case adr_mode::ZP_IND_Y:
-            stoken.command(st_command::LDA_izy);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        case adr_mode::ZP_X_IND:
-            stoken.command(st_command::LDA_izx);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for LDA");
+    const std::string name = '\'' + std::string(beg->v_lexeme()) + '\'';
+    if (m_asset_directory.empty()) {
+        add_error(diagnostic_code::FILE_NOT_ALLOWED, beg->row(), beg->column(), name);
+        return;
+    }
+    const auto file = asset(beg->v_lexeme());
+    if (not file) {
+        add_error(diagnostic_code::FILE_UNREADABLE, beg->row(), beg->column(), name);
+        return;
+    }
+
+    // The whole file by default, or from the offset up to the end
+    const auto &range  = beg->v_byteline();
+    const auto  bytes  = file->text();
+    const std::size_t offset = range.empty() ? 0 : range[0];
+    if (offset > bytes.size() or (range.size() > 1 and range[1] > bytes.size() - offset)) {
+        add_error(diagnostic_code::FILE_RANGE_INVALID, beg->row(), beg->column(),
+                  name + " of " + std::to_string(bytes.size()) + " bytes");
+        return;
     }
+    const std::size_t length = range.size() > 1 ? range[1] : bytes.size() - offset;
+    if (length > 0x1'00'00) {
+        add_error(diagnostic_code::FILE_TOO_BIG, beg->row(), beg->column(), name);
+        return;
+    }
+
+    serializable_token stoken(st_kind::BINARY);
+    stoken.binary(file, {reinterpret_cast<const byte_t *>(bytes.data()) + offset, length});
+    validate_end_of_command(beg, end);
     m_tokens.push_back(stoken);
 }
 
-void                    parser::
-o_cpy(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
+std::shared_ptr<const source_file>  parser::
+asset(const std::string_view name)
 {
-    serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::CPY_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::CPY_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::IMM:
-            stoken.command(st_command::CPY_imm);
-            std::advance(beg, 2);
-            if (beg->kind() == pt_kind::NUMBER) {
-                stoken.number(beg->v_number());
-            } else if (beg->kind() == pt_kind::LESS) {
-                stoken.number(std::next(beg)->v_number());
-                stoken.byteline({'<'});
-            } else if (beg->kind() == pt_kind::GREATER) {
-                stoken.number(std::next(beg)->v_number());
-                stoken.byteline({'>'});
-            }
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for CPY");
+    const std::string path = (std::filesystem::path(m_asset_directory) / name).string();
+    if (const auto found = m_assets.find(path); found != m_assets.end()) return found->second;
+
+    try {
+        auto file = std::make_shared<const source_file>(source_file::binary(path));
+        m_assets.emplace(path, file);
+        return file;
+    } catch (const mxasm_exception &) {
+        return nullptr;
+    } catch (const std::exception &) {
+        return nullptr;
     }
-    m_tokens.push_back(stoken);
 }
 
 void                    parser::
-o_cmp(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
+o_command(token_line::iterator beg, token_line::iterator end)
 {
     serializable_token stoken(st_kind::OPCODE);
-    switch (define_addr_mode(std::next(beg), end)) {
-        case adr_mode::ABS_or_REL:
-            stoken.command(st_command::CMP_abs);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ZP:
-            stoken.command(st_command::CMP_zpg);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ZP_X:
-            stoken.command(st_command::CMP_zpx);
-            stoken.number(std::next(beg)->v_number());
-            break;
-        case adr_mode::ABS_X:
-            stoken.command(st_command::CMP_abx);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::ABS_Y:
-            stoken.command(st_command::CMP_aby);
-            stoken.number(std::next(beg)->v_number());
-            if (std::next(beg)->kind() == pt_kind::LABEL_CALL) { stoken.labelable(true); }
-            else { stoken.labelable(false); }
-            break;
-        case adr_mode::IMM:
-            stoken.command(st_command::CMP_imm);
-            std::advance(beg, 2);
-            if (beg->kind() == pt_kind::NUMBER) {
-                stoken.number(beg->v_number());
-            } else if (beg->kind() == pt_kind::LESS) {
-                stoken.number(std::next(beg)->v_number());
+    const auto opcode = beg->v_opcode();
+
+    // Implied and stack commands take nothing after the mnemonic
+    const auto *in = instruction_encodings.find(opcode, adr_mode::STK_or_IMP);
+    if (in and in->mode != st_mode::ACC) {
+        stoken.command(in->command);
+        validate_end_of_command(beg, end);
+        m_tokens.push_back(stoken);
+        return;
+    }
+
+    const auto mode = define_addr_mode(std::next(beg), end);
+    in = instruction_encodings.find(opcode, mode);
+    // A label in parentheses is a pointer in the zero page for every command but JMP
+    if (in == nullptr and (mode == adr_mode::ABS_IND or mode == adr_mode::ABS_X_IND)
+                      and std::next(beg, 2)->kind() == pt_kind::LABEL_CALL) {
+        in = instruction_encodings.find(opcode, mode == adr_mode::ABS_IND ? adr_mode::ZP_IND : adr_mode::ZP_X_IND);
+    }
+    if (in == nullptr or (in->mode == st_mode::REL and std::next(beg)->kind() != pt_kind::LABEL_CALL)) {
+        add_error(diagnostic_code::UNAVAILABLE_ADDRESSING_MODE, beg->row(), 0, addressing_error_subject(beg));
+        m_tokens.push_back(stoken);
+        return;
+    }
+
+    stoken.command(in->command);
+    auto operand = std::next(beg);
+    switch (in->mode) {
+        case st_mode::IMP:
+        case st_mode::STK:
+        case st_mode::ACC:
+            break;
+        case st_mode::ZPG:
+        case st_mode::ZPX:
+        case st_mode::ZPY:
+        case st_mode::REL:
+            stoken.number(operand->v_number());
+            break;
+        case st_mode::ZPR:
+            stoken.number(operand->v_number());
+            std::advance(operand, 2);
+            stoken.byteline({word_t(operand->v_number())});
+            break;
+        case st_mode::ABS:
+        case st_mode::ABX:
+        case st_mode::ABY:
+            stoken.number(operand->v_number());
+            stoken.labelable(operand->kind() == pt_kind::LABEL_CALL);
+            break;
+        case st_mode::IND:
+        case st_mode::IAX:
+            std::advance(operand, 1);
+            stoken.number(operand->v_number());
+            stoken.labelable(operand->kind() == pt_kind::LABEL_CALL);
+            break;
+        case st_mode::IZP:
+        case st_mode::IZX:
+        case st_mode::IZY:
+            std::advance(operand, 1);
+            stoken.number(operand->v_number());
+            stoken.labelable(operand->kind() == pt_kind::LABEL_CALL);
+            break;
+        case st_mode::IMM:
+            std::advance(operand, 1);
+            if (operand->kind() == pt_kind::NUMBER) {
+                stoken.number(operand->v_number());
+            } else if (operand->kind() == pt_kind::LESS) {
+                stoken.number(std::next(operand)->v_number());
                 stoken.byteline({'<'});
-            } else if (beg->kind() == pt_kind::GREATER) {
-                stoken.number(std::next(beg)->v_number());
+            } else if (operand->kind() == pt_kind::GREATER) {
+                stoken.number(std::next(operand)->v_number());
                 stoken.byteline({'>'});
             }
             break;
-        case adr_mode::ZP_IND:
-            stoken.command(st_command::CMP_izp);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        case adr_mode::ZP_IND_Y:
-            stoken.command(st_command::CMP_izy);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        case adr_mode::ZP_X_IND:
-            stoken.command(st_command::CMP_izx);
-            std::advance(beg, 2);
-            stoken.number(beg->v_number());
-            break;
-        default:
-            add_exception("Error at line " + std::to_string(beg->row()) + ":\nUnavailable addressing mode for CMP");
     }
     m_tokens.push_back(stoken);
 }
 
-
-
-
-
-
-
-
-
-
-
-
-
+std::string             parser::
+addressing_error_subject(token_line::iterator beg) const
+{
+    // Branches and bit commands are reported by their group
+    const auto opcode = beg->v_opcode();
+    const auto *in = instruction_encodings.find(opcode, adr_mode::ABS_or_REL);
+    if (in and in->mode == st_mode::REL) return parser_token::pt_kind_to_string(beg->kind());
+    if (instruction_encodings.find(opcode, adr_mode::ZP_REL)) return "BBR or BBS";
+    if (not in and instruction_encodings.find(opcode, adr_mode::ZP)) return "RMB or SMB";
+    return parser_token::pt_opcode_to_string(opcode);
+}
 
 
 void                    parser::
-validate_end_of_command(const std::list<parser_token>::const_iterator &iter,
-                        const std::list<parser_token>::const_iterator &end)
+validate_end_of_command(const token_line::iterator &iter,
+                        const token_line::iterator &end)
 {
     auto nxt = std::next(iter);
     if (nxt == end) return;
-    add_exception("Error at line " + std::to_string(iter->row()) + ":\nA NEW LINE was expected, but "
-                  + parser_token::pt_kind_to_string(nxt->kind()) + " was found");
+    add_error(diagnostic_code::COMMAND_END_EXPECTED, iter->row(), 0, parser_token::pt_kind_to_string(nxt->kind()));
 }
 
 parser_token::adr_mode  parser::
-define_addr_mode(std::list<parser_token>::iterator beg, std::list<parser_token>::iterator end)
+define_addr_mode(token_line::iterator beg, token_line::iterator end)
 {
-    const auto tk = beg;
     if (beg == end) return adr_mode::STK_or_IMP;
     if (beg->kind() == pt_kind::OPCODE and beg->v_opcode() == pt_opcode::REGISTER_A) {
         std::advance(beg, 1);
@@ -1952,8 +952,20 @@ define_addr_mode(std::list<parser_token>::iterator beg, std::list<parser_token>:
             else if (beg->kind() == pt_kind::LABEL_CALL) {               // LABEL after (
                 std::advance(beg, 1);
                 if (beg != end) {
-                    if (beg->kind() == pt_kind::RIGHT_PARENTHESIS and std::next(beg) == end) {
-                        return adr_mode::ABS_IND;
+                    if (beg->kind() == pt_kind::RIGHT_PARENTHESIS) {
+                        if (std::next(beg) == end) {
+                            return adr_mode::ABS_IND;
+                        } else if (std::next(beg)->kind() == pt_kind::COMMA) {  // Only the zero page has (ptr),Y
+                            std::advance(beg, 1);
+                            if (std::next(beg) != end) {
+                                std::advance(beg, 1);
+                                if (beg->kind() == pt_kind::OPCODE and beg->v_opcode() == pt_opcode::REGISTER_Y) {
+                                    if (std::next(beg) == end) {
+                                        return parser_token::adr_mode::ZP_IND_Y;
+                                    }
+                                }
+                            }
+                        }
                     } else if (beg->kind() == pt_kind::COMMA) {
                         if (std::next(beg) != end) {
                             std::advance(beg, 1);
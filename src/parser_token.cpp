@@ -6,8 +6,63 @@
  *-------------------------------*/
 
 #include "../include/parser_token.hpp"
+#include "../include/perfect_hash.hpp"
 
 using namespace mxasm;
+using pt_opcode    = parser_token::pt_opcode;
+using pt_directive = parser_token::pt_directive;
+
+
+namespace
+{
+    constexpr std::size_t OPCODE_COUNT = static_cast<std::size_t>(pt_opcode::REGISTER_A) + 1;
+
+    // Listed in pt_opcode order, so the table also serves as the opcode name list
+    constexpr perfect_hash<pt_opcode, OPCODE_COUNT, 10> opcode_names
+    {{{
+        { "ADC",  pt_opcode::ADC  }, { "AND",  pt_opcode::AND  }, { "ASL",  pt_opcode::ASL  }, { "BBR0", pt_opcode::BBR0 },
+        { "BBR1", pt_opcode::BBR1 }, { "BBR2", pt_opcode::BBR2 }, { "BBR3", pt_opcode::BBR3 }, { "BBR4", pt_opcode::BBR4 },
+        { "BBR5", pt_opcode::BBR5 }, { "BBR6", pt_opcode::BBR6 }, { "BBR7", pt_opcode::BBR7 }, { "BBS0", pt_opcode::BBS0 },
+        { "BBS1", pt_opcode::BBS1 }, { "BBS2", pt_opcode::BBS2 }, { "BBS3", pt_opcode::BBS3 }, { "BBS4", pt_opcode::BBS4 },
+        { "BBS5", pt_opcode::BBS5 }, { "BBS6", pt_opcode::BBS6 }, { "BBS7", pt_opcode::BBS7 }, { "BCC",  pt_opcode::BCC  },
+        { "BCS",  pt_opcode::BCS  }, { "BEQ",  pt_opcode::BEQ  }, { "BIT",  pt_opcode::BIT  }, { "BMI",  pt_opcode::BMI  },
+        { "BNE",  pt_opcode::BNE  }, { "BPL",  pt_opcode::BPL  }, { "BRA",  pt_opcode::BRA  }, { "BRK",  pt_opcode::BRK  },
+        { "BVC",  pt_opcode::BVC  }, { "BVS",  pt_opcode::BVS  }, { "CLC",  pt_opcode::CLC  }, { "CLD",  pt_opcode::CLD  },
+        { "CLI",  pt_opcode::CLI  }, { "CLV",  pt_opcode::CLV  }, { "CMP",  pt_opcode::CMP  }, { "CPY",  pt_opcode::CPY  },
+        { "CPX",  pt_opcode::CPX  }, { "DEC",  pt_opcode::DEC  }, { "DEX",  pt_opcode::DEX  }, { "DEY",  pt_opcode::DEY  },
+        { "EOR",  pt_opcode::EOR  }, { "INC",  pt_opcode::INC  }, { "INX",  pt_opcode::INX  }, { "INY",  pt_opcode::INY  },
+        { "JMP",  pt_opcode::JMP  }, { "JSR",  pt_opcode::JSR  }, { "LDA",  pt_opcode::LDA  }, { "LDX",  pt_opcode::LDX  },
+        { "LDY",  pt_opcode::LDY  }, { "LSR",  pt_opcode::LSR  }, { "NOP",  pt_opcode::NOP  }, { "ORA",  pt_opcode::ORA  },
+        { "PHA",  pt_opcode::PHA  }, { "PHP",  pt_opcode::PHP  }, { "PHX",  pt_opcode::PHX  }, { "PHY",  pt_opcode::PHY  },
+        { "PLA",  pt_opcode::PLA  }, { "PLP",  pt_opcode::PLP  }, { "PLX",  pt_opcode::PLX  }, { "PLY",  pt_opcode::PLY  },
+        { "RMB0", pt_opcode::RMB0 }, { "RMB1", pt_opcode::RMB1 }, { "RMB2", pt_opcode::RMB2 }, { "RMB3", pt_opcode::RMB3 },
+        { "RMB4", pt_opcode::RMB4 }, { "RMB5", pt_opcode::RMB5 }, { "RMB6", pt_opcode::RMB6 }, { "RMB7", pt_opcode::RMB7 },
+        { "ROL",  pt_opcode::ROL  }, { "ROR",  pt_opcode::ROR  }, { "RTI",  pt_opcode::RTI  }, { "RTS",  pt_opcode::RTS  },
+        { "SBC",  pt_opcode::SBC  }, { "SEC",  pt_opcode::SEC  }, { "SED",  pt_opcode::SED  }, { "SEI",  pt_opcode::SEI  },
+        { "SMB0", pt_opcode::SMB0 }, { "SMB1", pt_opcode::SMB1 }, { "SMB2", pt_opcode::SMB2 }, { "SMB3", pt_opcode::SMB3 },
+        { "SMB4", pt_opcode::SMB4 }, { "SMB5", pt_opcode::SMB5 }, { "SMB6", pt_opcode::SMB6 }, { "SMB7", pt_opcode::SMB7 },
+        { "STA",  pt_opcode::STA  }, { "STP",  pt_opcode::STP  }, { "STX",  pt_opcode::STX  }, { "STY",  pt_opcode::STY  },
+        { "STZ",  pt_opcode::STZ  }, { "TAX",  pt_opcode::TAX  }, { "TAY",  pt_opcode::TAY  }, { "TRB",  pt_opcode::TRB  },
+        { "TSB",  pt_opcode::TSB  }, { "TSX",  pt_opcode::TSX  }, { "TXA",  pt_opcode::TXA  }, { "TXS",  pt_opcode::TXS  },
+        { "TYA",  pt_opcode::TYA  }, { "WAI",  pt_opcode::WAI  }, { "X",    pt_opcode::REGISTER_X }, { "Y",    pt_opcode::REGISTER_Y },
+        { "A",    pt_opcode::REGISTER_A }
+    }}};
+
+    constexpr perfect_hash<pt_directive, 4, 3> directive_names
+    {{{
+        { "DEFINE", pt_directive::MACRO }, { "BYTE", pt_directive::BYTE }, { "WORD", pt_directive::WORD },
+        { "INCBIN", pt_directive::INCBIN }
+    }}};
+
+    constexpr bool opcode_names_follow_enum() noexcept
+    {
+        for (std::size_t i = 0; i < OPCODE_COUNT; ++i) {
+            if (static_cast<std::size_t>(opcode_names.at(i).value) != i) return false;
+        }
+        return true;
+    }
+    static_assert(opcode_names_follow_enum(), "Opcode names must be listed in pt_opcode order");
+}
 
 
 parser_token::
@@ -31,7 +86,7 @@ std::size_t             parser_token::
 v_number() const noexcept
 { return m_v_number; }
 
-std::string             parser_token::
+std::string_view        parser_token::
 v_lexeme() const noexcept
 { return m_v_lexeme; }
 
@@ -69,7 +124,7 @@ v_number(const std::size_t number)
 { m_v_number = number; }
 
 void                    parser_token::
-v_lexeme(const std::string lexeme)
+v_lexeme(const std::string_view lexeme)
 { m_v_lexeme = lexeme; }
 
 void                    parser_token::
@@ -93,7 +148,7 @@ v_byteline(std::vector<word_t> &vc) noexcept
 { m_v_byteline = std::move(vc); }
 
 
-std::string             parser_token::
+const std::string&      parser_token::
 pt_kind_to_string(const pt_kind kind) noexcept
 { return pt_kind_string.at(kind); }
 
@@ -108,46 +163,35 @@ pt_opcode_to_string(const pt_opcode opcode) noexcept
         case pt_opcode::REGISTER_Y:
             return "REGISTER Y";
         default:
-            return pt_opcode_string.at(opcode);
+            return std::string(opcode_names.at(static_cast<std::size_t>(opcode)).name);
     }
 }
 
-std::string             parser_token::
+const std::string&      parser_token::
 pt_directive_to_string(const pt_directive directive) noexcept
 { return pt_directive_string.at(directive); }
 
 
 bool                    parser_token::
-is_opcode_or_register(const std::string lexeme) noexcept
-{
-    std::string new_lexeme = to_upper(lexeme);
-    for (const auto &e : pt_opcode_string) {
-        if (e.second == new_lexeme) return true;
-    }
-    return false;
-}
+is_opcode_or_register(const std::string_view lexeme) noexcept
+{ return opcode_names.contains(lexeme); }
+
+bool                    parser_token::
+is_directive(const std::string_view lexeme) noexcept
+{ return directive_names.contains(lexeme); }
 
 parser_token::pt_opcode parser_token::
-get_opcode_by_name(const std::string lexeme) noexcept
+get_opcode_by_name(const std::string_view lexeme) noexcept
 {
-    std::string new_str = to_upper(lexeme);
-    for (const auto &[opcode, str] : pt_opcode_string) {
-        if (new_str == str) {
-            return opcode;
-        }
-    }
-    return pt_opcode::NOP;
+    const auto *opcode = opcode_names.find(lexeme);
+    return opcode == nullptr ? pt_opcode::NOP : *opcode;
 }
 
 parser_token::pt_directive   parser_token::
-get_directive_by_name(const std::string lexeme) noexcept
+get_directive_by_name(const std::string_view lexeme) noexcept
 {
-    std::string new_str = to_upper(lexeme);
-    for (const auto &[opcode, str] : pt_directive_string) {
-        if (new_str == str) {
-            return opcode;
-        }
-    }
+    const auto *directive = directive_names.find(lexeme);
+    return directive == nullptr ? pt_directive::MACRO : *directive;
 }
 
 
@@ -170,44 +214,14 @@ pt_kind_string
     { pt_kind::LABEL_CALL,        "LABEL CALL"        }
 };
 
-const std::map<parser_token::pt_opcode, std::string>  parser_token::
-pt_opcode_string
-{
-    { pt_opcode::ADC,  "ADC"  }, { pt_opcode::AND,  "AND"  }, { pt_opcode::ASL,  "ASL"  }, { pt_opcode::BBR0, "BBR0" },
-    { pt_opcode::BBR1, "BBR1" }, { pt_opcode::BBR2, "BBR2" }, { pt_opcode::BBR3, "BBR3" }, { pt_opcode::BBR4, "BBR4" },
-    { pt_opcode::BBR5, "BBR5" }, { pt_opcode::BBR6, "BBR6" }, { pt_opcode::BBR7, "BBR7" }, { pt_opcode::BBS0, "BBS0" },
-    { pt_opcode::BBS1, "BBS1" }, { pt_opcode::BBS2, "BBS2" }, { pt_opcode::BBS3, "BBS3" }, { pt_opcode::BBS4, "BBS4" },
-    { pt_opcode::BBS5, "BBS5" }, { pt_opcode::BBS6, "BBS6" }, { pt_opcode::BBS7, "BBS7" }, { pt_opcode::BCC,  "BCC"  },
-    { pt_opcode::BCS,  "BCS"  }, { pt_opcode::BEQ,  "BEQ"  }, { pt_opcode::BIT,  "BIT"  }, { pt_opcode::BMI,  "BMI"  },
-    { pt_opcode::BNE,  "BNE"  }, { pt_opcode::BPL,  "BPL"  }, { pt_opcode::BRA,  "BRA"  }, { pt_opcode::BRK,  "BRK"  },
-    { pt_opcode::BVC,  "BVC"  }, { pt_opcode::BVS,  "BVS"  }, { pt_opcode::CLC,  "CLC"  }, { pt_opcode::CLD,  "CLD"  },
-    { pt_opcode::CLI,  "CLI"  }, { pt_opcode::CLV,  "CLV"  }, { pt_opcode::CMP,  "CMP"  }, { pt_opcode::CPY,  "CPY"  },
-    { pt_opcode::CPX,  "CPX"  }, { pt_opcode::DEC,  "DEC"  }, { pt_opcode::DEX,  "DEX"  }, { pt_opcode::DEY,  "DEY"  },
-    { pt_opcode::EOR,  "EOR"  }, { pt_opcode::INC,  "INC"  }, { pt_opcode::INX,  "INX"  }, { pt_opcode::INY,  "INY"  },
-    { pt_opcode::JMP,  "JMP"  }, { pt_opcode::JSR,  "JSR"  }, { pt_opcode::LDA,  "LDA"  }, { pt_opcode::LDX,  "LDX"  },
-    { pt_opcode::LDY,  "LDY"  }, { pt_opcode::LSR,  "LSR"  }, { pt_opcode::NOP,  "NOP"  }, { pt_opcode::ORA,  "ORA"  },
-    { pt_opcode::PHA,  "PHA"  }, { pt_opcode::PHP,  "PHP"  }, { pt_opcode::PHX,  "PHX"  }, { pt_opcode::PHY,  "PHY"  },
-    { pt_opcode::PLA,  "PLA"  }, { pt_opcode::PLP,  "PLP"  }, { pt_opcode::PLX,  "PLX"  }, { pt_opcode::PLY,  "PLY"  },
-    { pt_opcode::RMB0, "RMB0" }, { pt_opcode::RMB1, "RMB1" }, { pt_opcode::RMB2, "RMB2" }, { pt_opcode::RMB3, "RMB3" },
-    { pt_opcode::RMB4, "RMB4" }, { pt_opcode::RMB5, "RMB5" }, { pt_opcode::RMB6, "RMB6" }, { pt_opcode::RMB7, "RMB7" },
-    { pt_opcode::ROL,  "ROL"  }, { pt_opcode::ROR,  "ROR"  }, { pt_opcode::RTI,  "RTI"  }, { pt_opcode::RTS,  "RTS"  },
-    { pt_opcode::SBC,  "SBC"  }, { pt_opcode::SEC,  "SEC"  }, { pt_opcode::SED,  "SED"  }, { pt_opcode::SEI,  "SEI"  },
-    { pt_opcode::SMB0, "SMB0" }, { pt_opcode::SMB1, "SMB1" }, { pt_opcode::SMB2, "SMB2" }, { pt_opcode::SMB3, "SMB3" },
-    { pt_opcode::SMB4, "SMB4" }, { pt_opcode::SMB5, "SMB5" }, { pt_opcode::SMB6, "SMB6" }, { pt_opcode::SMB7, "SMB7" },
-    { pt_opcode::STA,  "STA"  }, { pt_opcode::STP,  "STP"  }, { pt_opcode::STX,  "STX"  }, { pt_opcode::STY,  "STY"  },
-    { pt_opcode::STZ,  "STZ"  }, { pt_opcode::TAX,  "TAX"  }, { pt_opcode::TAY,  "TAY"  }, { pt_opcode::TRB,  "TRB"  },
-    { pt_opcode::TSB,  "TSB"  }, { pt_opcode::TSX,  "TSX"  }, { pt_opcode::TXA,  "TXA"  }, { pt_opcode::TXS,  "TXS"  },
-    { pt_opcode::TYA,  "TYA"  }, { pt_opcode::WAI,  "WAI"  },
-    { pt_opcode::REGISTER_X, "X" }, { pt_opcode::REGISTER_Y, "Y"}, { pt_opcode::REGISTER_A, "A"}
-};
-
 const std::map<parser_token::pt_directive, std::string> parser_token::
 pt_directive_string
 {
     { pt_directive::CODE_POSITION, "CODE POSITION" },
     { pt_directive::MACRO,         "DEFINE"        },
     { pt_directive::BYTE,          "BYTE"          },
-    { pt_directive::WORD,          "WORD"          }
+    { pt_directive::WORD,          "WORD"          },
+    { pt_directive::INCBIN,        "INCBIN"        }
 };
 
 
@@ -0,0 +1,149 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |            Profiler           |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <algorithm>
+#include <iomanip>
+#include <set>
+
+#include "../include/profiler.hpp"
+#include "../include/serializable_token.hpp"
+
+using namespace mxasm;
+using st_command = serializable_token::st_command;
+
+
+namespace
+{
+    double percent(const std::uint64_t part, const std::uint64_t total)
+    { return total == 0 ? 0.0 : 100.0 * static_cast<double>(part) / static_cast<double>(total); }
+}
+
+
+profiler::
+profiler(const source_map &map)
+    : m_map {map}, m_label_at(0x1'00'00, NO_LABEL), m_addresses(0x1'00'00)
+{
+    const auto labels = m_map.labels_by_address();
+    for (std::size_t i = 0; i < labels.size(); ++i) {
+        const std::size_t end = i + 1 < labels.size() ? m_map.labels[labels[i + 1]].address : m_label_at.size();
+        std::fill(m_label_at.begin() + m_map.labels[labels[i]].address, m_label_at.begin() + end,
+                  static_cast<uint32_t>(labels[i]));
+    }
+}
+
+
+void                    profiler::
+record(const word_t address, const byte_t opcode, const std::size_t cycles)
+{
+    if (m_label_at[address] != m_current) {
+        flush_stack();
+        m_current = m_label_at[address];
+    }
+    m_pending += cycles;
+    m_total   += cycles;
+    ++m_commands;
+    m_addresses[address].cycles += cycles;
+    ++m_addresses[address].commands;
+
+    if (opcode == static_cast<byte_t>(st_command::JSR_abs)) {
+        flush_stack();
+        if (m_calls.size() == MAX_DEPTH) m_calls.erase(m_calls.begin());
+        m_calls.push_back(m_current);
+    } else if (opcode == static_cast<byte_t>(st_command::RTS_stk) and not m_calls.empty()) {
+        flush_stack();
+        m_calls.pop_back();
+    }
+}
+
+
+void                    profiler::
+write_flat_profile(std::ostream &out) const
+{
+    // Self cycles from the addresses, total cycles from the stacks a label is on
+    std::map<uint32_t, counter>       labels;
+    std::map<uint32_t, counter>       rows;
+    std::map<uint32_t, std::uint64_t> totals;
+    for (std::size_t address = 0; address < m_addresses.size(); ++address) {
+        const auto &count = m_addresses[address];
+        if (count.commands == 0) continue;
+        for (auto *sum : {&labels[m_label_at[address]], &rows[m_map.rows[address]]}) {
+            sum->cycles   += count.cycles;
+            sum->commands += count.commands;
+        }
+    }
+    auto stacks = m_stacks;
+    if (m_pending != 0) stacks[current_stack()] += m_pending;
+    for (const auto &[stack, cycles] : stacks) {
+        for (const uint32_t label : std::set<uint32_t>(stack.begin(), stack.end())) {
+            totals[label] += cycles;
+        }
+    }
+
+    const auto by_cycles = [](const std::map<uint32_t, counter> &counts) {
+        std::vector<std::pair<uint32_t, counter>> sorted(counts.begin(), counts.end());
+        std::stable_sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) {
+            return a.second.cycles > b.second.cycles;
+        });
+        return sorted;
+    };
+
+    out << "Flat profile: " << m_total << " cycles in " << m_commands << " commands\n\n";
+    out << std::fixed << std::setprecision(2);
+    out << "   self cycles       %  total cycles       %     commands  label\n";
+    for (const auto &[label, count] : by_cycles(labels)) {
+        out << std::setw(14) << count.cycles << std::setw(7) << percent(count.cycles, m_total) << '%'
+            << std::setw(14) << totals[label] << std::setw(7) << percent(totals[label], m_total) << '%'
+            << std::setw(13) << count.commands << "  " << label_name(label) << '\n';
+    }
+
+    out << "\n        cycles       %     commands    row  source\n";
+    for (const auto &[row, count] : by_cycles(rows)) {
+        out << std::setw(14) << count.cycles << std::setw(7) << percent(count.cycles, m_total) << '%'
+            << std::setw(13) << count.commands << std::setw(7);
+        if (row == source_map::NO_ROW) {
+            out << '-' << "  [no source]\n";
+        } else {
+            out << row << "  " << m_map.row_text(row) << '\n';
+        }
+    }
+    out.flush();
+}
+
+void                    profiler::
+write_collapsed_stacks(std::ostream &out) const
+{
+    auto stacks = m_stacks;
+    if (m_pending != 0) stacks[current_stack()] += m_pending;
+    for (const auto &[stack, cycles] : stacks) {
+        for (std::size_t i = 0; i < stack.size(); ++i) {
+            out << (i == 0 ? "" : ";") << label_name(stack[i]);
+        }
+        out << ' ' << cycles << '\n';
+    }
+    out.flush();
+}
+
+
+std::vector<uint32_t>   profiler::
+current_stack() const
+{
+    std::vector<uint32_t> stack = m_calls;
+    stack.push_back(m_current);
+    return stack;
+}
+
+void                    profiler::
+flush_stack()
+{
+    if (m_pending == 0) return;
+    m_stacks[current_stack()] += m_pending;
+    m_pending = 0;
+}
+
+std::string             profiler::
+label_name(const uint32_t id) const
+{ return id == NO_LABEL ? "[unlabeled]" : m_map.labels[id].name; }
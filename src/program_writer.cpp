@@ -0,0 +1,209 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |         Program Writer        |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#if defined(__unix__) or defined(__APPLE__)
+#define MXASM_HAS_POSIX_IO
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include "../include/program_writer.hpp"
+#include "../include/file_descriptor.hpp"
+#include "../include/exceptions/arguments_exception.hpp"
+
+using namespace mxasm;
+
+
+namespace
+{
+    constexpr std::size_t DIRECT_ALIGNMENT = 4096;
+
+    std::string temporary_name(const std::string &out_name)
+    {
+        // Unique per process and call, so parallel jobs never share a temporary file
+        static std::atomic<unsigned> counter {0};
+#ifdef MXASM_HAS_POSIX_IO
+        const auto pid = static_cast<long>(getpid());
+#else
+        const long pid = 0;
+#endif
+        return out_name + ".tmp." + std::to_string(pid) + "." + std::to_string(counter++);
+    }
+
+    std::size_t file_size(const std::vector<memory_image::segment> &segments)
+    {
+        if (segments.empty()) return 0;
+        return segments.back().address + segments.back().size - segments.front().address;
+    }
+
+    [[noreturn]] void write_error(const std::string &out_name)
+    { throw arguments_exception("Can't write program binary file '" + out_name + "'"); }
+
+
+#ifdef MXASM_HAS_POSIX_IO
+    int open_output(const std::string &path, const bool exclusive, const bool direct)
+    {
+        int flags = O_WRONLY | O_CREAT | (exclusive ? O_EXCL : O_TRUNC);
+#ifdef O_DIRECT
+        if (direct) flags |= O_DIRECT;
+#else
+        (void)direct;
+#endif
+        return ::open(path.c_str(), flags, 0666);
+    }
+
+    bool write_all(const int fd, const byte_t *data, std::size_t size, off_t offset)
+    {
+        while (size > 0) {
+            const ssize_t res = ::pwrite(fd, data, size, offset);
+            if (res < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            data += res;
+            size -= res;
+            offset += res;
+        }
+        return true;
+    }
+
+    // Every segment goes out with one pwritev() of its page views
+    bool write_segments(const int fd, const memory_image &program,
+                        const std::vector<memory_image::segment> &segments)
+    {
+        const std::size_t origin = segments.front().address;
+        std::vector<iovec> vectors;
+
+        for (const auto &segment : segments) {
+            const auto chunks = program.chunks(segment);
+            vectors.clear();
+            for (const auto &chunk : chunks) {
+                vectors.push_back({const_cast<byte_t*>(chunk.data()), chunk.size()});
+            }
+
+            off_t offset = segment.address - origin;
+            std::size_t first = 0;
+            while (first < vectors.size()) {
+                const int count = static_cast<int>(std::min<std::size_t>(vectors.size() - first, IOV_MAX));
+                const ssize_t res = ::pwritev(fd, vectors.data() + first, count, offset);
+                if (res < 0) {
+                    if (errno == EINTR) continue;
+                    return false;
+                }
+
+                // Skip what was written, a short write resumes inside a chunk
+                std::size_t written = res;
+                offset += res;
+                while (written > 0 and first < vectors.size()) {
+                    if (written >= vectors[first].iov_len) {
+                        written -= vectors[first].iov_len;
+                        ++first;
+                    } else {
+                        vectors[first].iov_base = static_cast<byte_t*>(vectors[first].iov_base) + written;
+                        vectors[first].iov_len -= written;
+                        written = 0;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    // O_DIRECT needs aligned memory, offsets and sizes, so the whole file is laid out in one buffer
+    bool write_direct(const int fd, const memory_image &program,
+                      const std::vector<memory_image::segment> &segments)
+    {
+        const std::size_t size = file_size(segments);
+        const std::size_t padded = (size + DIRECT_ALIGNMENT - 1) / DIRECT_ALIGNMENT * DIRECT_ALIGNMENT;
+        std::unique_ptr<byte_t, decltype(&std::free)> buffer(
+                static_cast<byte_t*>(std::aligned_alloc(DIRECT_ALIGNMENT, padded)), &std::free);
+        if (not buffer) return false;
+
+        std::memset(buffer.get(), 0, padded);
+        const std::size_t origin = segments.front().address;
+        for (const auto &segment : segments) {
+            program.copy(segment, {buffer.get() + segment.address - origin, segment.size});
+        }
+        return write_all(fd, buffer.get(), padded, 0) and ::ftruncate(fd, size) == 0;
+    }
+
+    void sync_directory(const std::string &path)
+    {
+        auto directory = std::filesystem::path(path).parent_path();
+        if (directory.empty()) directory = ".";
+        file_descriptor fd(::open(directory.c_str(), O_RDONLY));
+        if (fd.is_open()) ::fsync(fd.get());
+    }
+#endif
+}
+
+
+void                    mxasm::
+write_program_to_file(const memory_image &program, const std::string &out_name, const write_options &options)
+{
+    const auto segments = program.segments();
+    const std::string path = options.atomic ? temporary_name(out_name) : out_name;
+
+#ifdef MXASM_HAS_POSIX_IO
+    bool direct = options.sync == sync_policy::DIRECT and not segments.empty();
+    file_descriptor fd(open_output(path, options.atomic, direct));
+    if (not fd.is_open() and direct and errno == EINVAL) {
+        // File system without O_DIRECT support, fall back to a synced buffered write
+        direct = false;
+        fd.reset(open_output(path, options.atomic, false));
+    }
+    if (not fd.is_open()) {
+        throw arguments_exception("Can't create program binary file!");
+    }
+
+    bool ok = true;
+    if (not segments.empty()) {
+        ok = direct ? write_direct(fd.get(), program, segments) : write_segments(fd.get(), program, segments);
+    }
+    if (ok and options.sync != sync_policy::NONE) ok = ::fsync(fd.get()) == 0;
+    if (fd.close() != 0) ok = false;
+
+    if (ok and options.atomic) ok = std::rename(path.c_str(), out_name.c_str()) == 0;
+    if (not ok) {
+        if (options.atomic) ::unlink(path.c_str());
+        write_error(out_name);
+    }
+    if (options.atomic and options.sync != sync_policy::NONE) sync_directory(out_name);
+#else
+    {
+        std::ofstream file_writer(path, std::ios_base::binary);
+        if (not file_writer.is_open()) {
+            throw arguments_exception("Can't create program binary file!");
+        }
+        if (not segments.empty()) {
+            const std::size_t origin = segments.front().address;
+            for (const auto &segment : segments) {
+                const auto bytes = program.bytes(segment);
+                file_writer.seekp(segment.address - origin);
+                file_writer.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+            }
+        }
+        file_writer.close();
+        if (not file_writer) write_error(out_name);
+    }
+    if (options.atomic) {
+        std::error_code error;
+        std::filesystem::rename(path, out_name, error);
+        if (error) write_error(out_name);
+    }
+#endif
+}
@@ -0,0 +1,236 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |             Runner            |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#if defined(__unix__) or defined(__APPLE__)
+#define MXASM_HAS_TERMINAL
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+#include "../include/runner.hpp"
+#include "../include/emulator.hpp"
+#include "../include/profiler.hpp"
+#include "../include/exceptions/arguments_exception.hpp"
+
+using namespace mxasm;
+using stop_reason = emulator::stop_reason;
+
+
+namespace
+{
+    constexpr std::uint64_t FRAMES_PER_SECOND = 30;
+    constexpr std::uint64_t UNTHROTTLED_SLICE = 1'000'000;     // Cycles between checks for keys and Ctrl-C
+
+    // Colours of the 16 pixel values, as in the browser simulators
+    constexpr std::array<std::array<int, 3>, 16> PALETTE {{
+        {0x00, 0x00, 0x00}, {0xFF, 0xFF, 0xFF}, {0x88, 0x00, 0x00}, {0xAA, 0xFF, 0xEE},
+        {0xCC, 0x44, 0xCC}, {0x00, 0xCC, 0x55}, {0x00, 0x00, 0xAA}, {0xEE, 0xEE, 0x77},
+        {0xDD, 0x88, 0x55}, {0x66, 0x44, 0x00}, {0xFF, 0x77, 0x77}, {0x33, 0x33, 0x33},
+        {0x77, 0x77, 0x77}, {0xAA, 0xFF, 0x66}, {0x00, 0x88, 0xFF}, {0xBB, 0xBB, 0xBB}
+    }};
+
+    volatile std::sig_atomic_t interrupted = 0;
+
+    extern "C" void request_interrupt(int)
+    { interrupted = 1; }
+
+
+    // Keys without echo and line buffering while the program runs
+    class raw_terminal
+    {
+    public:
+        raw_terminal()
+        {
+#ifdef MXASM_HAS_TERMINAL
+            m_active = isatty(STDIN_FILENO) and tcgetattr(STDIN_FILENO, &m_saved) == 0;
+            if (not m_active) return;
+
+            termios raw = m_saved;
+            raw.c_lflag &= ~(ICANON | ECHO);        // ISIG stays, so Ctrl-C still stops the program
+            raw.c_cc[VMIN]  = 0;
+            raw.c_cc[VTIME] = 0;
+            tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+#endif
+        }
+
+        raw_terminal(const raw_terminal &) = delete;
+        raw_terminal &operator=(const raw_terminal &) = delete;
+
+        ~raw_terminal()
+        {
+#ifdef MXASM_HAS_TERMINAL
+            if (m_active) tcsetattr(STDIN_FILENO, TCSANOW, &m_saved);
+#endif
+        }
+
+        // Every key pressed since the last call, never waits
+        std::string read_keys()
+        {
+            std::string keys;
+#ifdef MXASM_HAS_TERMINAL
+            if (not m_active) return keys;
+            char buffer[64];
+            ssize_t count;
+            while ((count = read(STDIN_FILENO, buffer, sizeof(buffer))) > 0) {
+                keys.append(buffer, static_cast<std::size_t>(count));
+            }
+#endif
+            return keys;
+        }
+
+    private:
+        bool    m_active {false};
+#ifdef MXASM_HAS_TERMINAL
+        termios m_saved  {};
+#endif
+    };
+
+
+    bool is_terminal_output()
+    {
+#ifdef MXASM_HAS_TERMINAL
+        return isatty(STDOUT_FILENO);
+#else
+        return false;
+#endif
+    }
+
+    // Two pixel rows per text row: the upper half block takes the top colour, the background the bottom one
+    void draw_screen(const emulator &cpu)
+    {
+        const auto screen = cpu.screen();
+        std::string frame = "\x1b[H";
+        for (std::size_t y = 0; y < emulator::SCREEN_HEIGHT; y += 2) {
+            for (std::size_t x = 0; x < emulator::SCREEN_WIDTH; ++x) {
+                const auto &top    = PALETTE[screen[y * emulator::SCREEN_WIDTH + x] & 0x0F];
+                const auto &bottom = PALETTE[screen[(y + 1) * emulator::SCREEN_WIDTH + x] & 0x0F];
+                frame += "\x1b[38;2;" + std::to_string(top[0]) + ';' + std::to_string(top[1]) + ';'
+                       + std::to_string(top[2]) + ";48;2;" + std::to_string(bottom[0]) + ';'
+                       + std::to_string(bottom[1]) + ';' + std::to_string(bottom[2]) + "m▀";
+            }
+            frame += "\x1b[0m\n";
+        }
+        std::cout << frame << std::flush;
+    }
+
+    // Command by command when profiling, so that every one of them is recorded
+    stop_reason run_until(emulator &cpu, const std::uint64_t cycle_limit, profiler *profile)
+    {
+        if (profile == nullptr) return cpu.run(cycle_limit);
+
+        while (cpu.stopped() == stop_reason::RUNNING and cpu.cycles() < cycle_limit) {
+            const word_t address = cpu.state().pc;
+            const byte_t opcode  = cpu.peek(address);
+            const std::size_t cycles = cpu.step();
+            profile->record(address, opcode, cycles);
+        }
+        return cpu.stopped() == stop_reason::RUNNING ? stop_reason::CYCLE_LIMIT : cpu.stopped();
+    }
+
+    std::string hex(const unsigned value, const int digits)
+    {
+        std::ostringstream text;
+        text << '$' << std::uppercase << std::hex << std::setw(digits) << std::setfill('0') << value;
+        return text.str();
+    }
+
+    std::string stop_description(const stop_reason reason, const emulator &cpu)
+    {
+        const word_t command = static_cast<word_t>(cpu.state().pc - 1);
+        switch (reason) {
+            case stop_reason::BREAK:       return "BRK at " + hex(command, 4);
+            case stop_reason::STOP:        return "STP at " + hex(command, 4);
+            case stop_reason::WAIT:        return "WAI at " + hex(command, 4);
+            case stop_reason::CYCLE_LIMIT: return "cycle limit";
+            case stop_reason::RUNNING:     break;
+        }
+        return "interrupt";
+    }
+}
+
+
+int                     mxasm::
+run_program(const memory_image &image, const run_options &options, const source_map *map)
+{
+    std::unique_ptr<profiler> profile;
+    std::ofstream stacks_file;
+    if (options.profiling() and map != nullptr) {
+        profile = std::make_unique<profiler>(*map);
+    }
+    if (not options.stacks_path.empty()) {
+        stacks_file.open(options.stacks_path);
+        if (not stacks_file) throw arguments_exception("Can't create stacks file '" + options.stacks_path + "'");
+    }
+
+    std::uint64_t seed = options.seed;
+    if (seed == 0) {
+        std::random_device device;
+        seed = static_cast<std::uint64_t>(device()) << 32 | device();
+    }
+    emulator cpu(image, seed);
+
+    const bool show_screen = is_terminal_output();
+    const std::uint64_t clock = options.clock_hz.value_or(show_screen ? INTERACTIVE_CLOCK_HZ : 0);
+    const std::uint64_t limit = options.max_cycles == 0 ? UINT64_MAX : options.max_cycles;
+    const std::uint64_t slice = clock == 0 ? UNTHROTTLED_SLICE : std::max<std::uint64_t>(1, clock / FRAMES_PER_SECOND);
+    const auto slice_time = std::chrono::nanoseconds(clock == 0 ? 0 : slice * 1'000'000'000 / clock);
+
+    interrupted = 0;
+    const auto previous_handler = std::signal(SIGINT, request_interrupt);
+    stop_reason stopped = stop_reason::RUNNING;
+    {
+        raw_terminal terminal;
+        if (show_screen) std::cout << "\x1b[2J\x1b[?25l";
+
+        auto next_slice = std::chrono::steady_clock::now();
+        while (not interrupted) {
+            for (const char key : terminal.read_keys()) {
+                cpu.press_key(static_cast<byte_t>(key));
+            }
+            stopped = run_until(cpu, cpu.cycles() + std::min(slice, limit - cpu.cycles()), profile.get());
+            if (show_screen and cpu.take_screen_change()) draw_screen(cpu);
+            if (stopped != stop_reason::CYCLE_LIMIT or cpu.cycles() >= limit) break;
+
+            stopped = stop_reason::RUNNING;
+            if (slice_time.count() != 0) {
+                next_slice += slice_time;
+                std::this_thread::sleep_until(next_slice);
+            }
+        }
+        if (show_screen) std::cout << "\x1b[0m\x1b[?25h";
+    }
+    std::signal(SIGINT, previous_handler);
+
+    const auto &r = cpu.state();
+    std::cout << "Stopped by " << stop_description(stopped, cpu) << " after " << cpu.cycles() << " cycles\n"
+              << "A=" << hex(r.a, 2) << " X=" << hex(r.x, 2) << " Y=" << hex(r.y, 2)
+              << " SP=" << hex(r.sp, 2) << " P=" << hex(r.p, 2) << " PC=" << hex(r.pc, 4) << std::endl;
+
+    if (profile and options.profile) {
+        std::cout << '\n';
+        profile->write_flat_profile(std::cout);
+    }
+    if (profile and stacks_file.is_open()) {
+        profile->write_collapsed_stacks(stacks_file);
+    }
+
+    const bool finished = stopped == stop_reason::BREAK or stopped == stop_reason::STOP or stopped == stop_reason::WAIT;
+    return finished ? EXIT_SUCCESS : EXIT_FAILURE;
+}
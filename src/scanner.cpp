@@ -0,0 +1,190 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |            Scanner            |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <cstdint>
+
+#include "../include/scanner.hpp"
+
+#if defined(__GNUC__) and (defined(__x86_64__) or defined(__i386__))
+#define MXASM_HAS_X86_SIMD
+#include <immintrin.h>
+#endif
+
+using namespace mxasm;
+
+
+namespace
+{
+    typedef const char *(*scan_function)(const char *begin, const char *end) noexcept;
+
+    struct scan_functions
+    {
+        scan_function spaces;
+        scan_function identifier;
+        scan_function line_end;
+        const char   *instruction_set;
+    };
+
+
+    // ------------------------------------- SCALAR -------------------------------------
+    bool is_space(const char c) noexcept
+    { return c == ' ' or c == '\t' or c == '\r' or c == '\n'; }
+
+    bool is_identifier_char(const char c) noexcept
+    { return (c >= '0' and c <= '9') or (c >= 'a' and c <= 'z') or (c >= 'A' and c <= 'Z') or c == '_'; }
+
+    const char *scalar_spaces(const char *begin, const char *end) noexcept
+    {
+        while (begin != end and is_space(*begin)) ++begin;
+        return begin;
+    }
+
+    const char *scalar_identifier(const char *begin, const char *end) noexcept
+    {
+        while (begin != end and is_identifier_char(*begin)) ++begin;
+        return begin;
+    }
+
+    const char *scalar_line_end(const char *begin, const char *end) noexcept
+    {
+        while (begin != end and *begin != '\0') ++begin;
+        return begin;
+    }
+
+
+#ifdef MXASM_HAS_X86_SIMD
+    // Every mask below has a bit set for each byte that continues the run, so the run ends at the
+    // first zero bit. Bytes above 0x7F are negative for the signed compares and never match a range.
+
+    // ------------------------------------- SSE2 -------------------------------------
+    __attribute__((target("sse2")))
+    unsigned sse2_space_mask(const __m128i v) noexcept
+    {
+        const __m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                                                    _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+                                       _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\r')),
+                                                    _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))));
+        return static_cast<unsigned>(_mm_movemask_epi8(m));
+    }
+
+    __attribute__((target("sse2")))
+    unsigned sse2_identifier_mask(const __m128i v) noexcept
+    {
+        const __m128i lower  = _mm_or_si128(v, _mm_set1_epi8(0x20));
+        const __m128i digit  = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                                             _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+        const __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                             _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1)));
+        const __m128i under  = _mm_cmpeq_epi8(v, _mm_set1_epi8('_'));
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(digit, letter), under)));
+    }
+
+    __attribute__((target("sse2")))
+    unsigned sse2_not_zero_mask(const __m128i v) noexcept
+    { return ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128()))) & 0xFFFFu; }
+
+    template <unsigned (*Mask)(__m128i) noexcept, scan_function Tail>
+    __attribute__((target("sse2")))
+    const char *sse2_scan(const char *begin, const char *end) noexcept
+    {
+        while (end - begin >= 16) {
+            const unsigned mask = Mask(_mm_loadu_si128(reinterpret_cast<const __m128i *>(begin)));
+            if (mask != 0xFFFFu) return begin + __builtin_ctz(~mask);
+            begin += 16;
+        }
+        return Tail(begin, end);
+    }
+
+
+    // ------------------------------------- AVX2 -------------------------------------
+    __attribute__((target("avx2")))
+    uint32_t avx2_space_mask(const __m256i v) noexcept
+    {
+        const __m256i m = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+                                                          _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))),
+                                          _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r')),
+                                                          _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'))));
+        return static_cast<uint32_t>(_mm256_movemask_epi8(m));
+    }
+
+    __attribute__((target("avx2")))
+    uint32_t avx2_identifier_mask(const __m256i v) noexcept
+    {
+        const __m256i lower  = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+        const __m256i digit  = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('0' - 1)),
+                                                _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), v));
+        const __m256i letter = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+                                                _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), lower));
+        const __m256i under  = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_'));
+        return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(digit, letter), under)));
+    }
+
+    __attribute__((target("avx2")))
+    uint32_t avx2_not_zero_mask(const __m256i v) noexcept
+    { return ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_setzero_si256()))); }
+
+    template <uint32_t (*Mask)(__m256i) noexcept, scan_function Tail>
+    __attribute__((target("avx2")))
+    const char *avx2_scan(const char *begin, const char *end) noexcept
+    {
+        while (end - begin >= 32) {
+            const uint32_t mask = Mask(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin)));
+            if (mask != 0xFFFF'FFFFu) return begin + __builtin_ctz(~mask);
+            begin += 32;
+        }
+        return Tail(begin, end);
+    }
+#endif
+
+
+    scan_functions select_scan_functions() noexcept
+    {
+#ifdef MXASM_HAS_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return {
+                avx2_scan<avx2_space_mask,      sse2_scan<sse2_space_mask,      scalar_spaces>>,
+                avx2_scan<avx2_identifier_mask, sse2_scan<sse2_identifier_mask, scalar_identifier>>,
+                avx2_scan<avx2_not_zero_mask,   sse2_scan<sse2_not_zero_mask,   scalar_line_end>>,
+                "AVX2"
+            };
+        }
+        if (__builtin_cpu_supports("sse2")) {
+            return {
+                sse2_scan<sse2_space_mask,      scalar_spaces>,
+                sse2_scan<sse2_identifier_mask, scalar_identifier>,
+                sse2_scan<sse2_not_zero_mask,   scalar_line_end>,
+                "SSE2"
+            };
+        }
+#endif
+        return { scalar_spaces, scalar_identifier, scalar_line_end, "scalar" };
+    }
+
+    const scan_functions &active_scan_functions() noexcept
+    {
+        static const scan_functions functions = select_scan_functions();
+        return functions;
+    }
+}
+
+
+const char*             mxasm::
+scan_spaces(const char *begin, const char *end) noexcept
+{ return active_scan_functions().spaces(begin, end); }
+
+const char*             mxasm::
+scan_identifier(const char *begin, const char *end) noexcept
+{ return active_scan_functions().identifier(begin, end); }
+
+const char*             mxasm::
+scan_line_end(const char *begin, const char *end) noexcept
+{ return active_scan_functions().line_end(begin, end); }
+
+const char*             mxasm::
+scanner_instruction_set() noexcept
+{ return active_scan_functions().instruction_set; }
@@ -25,7 +25,7 @@ st_command              serializable_token::
 command() const noexcept
 { return m_command; }
 
-std::vector<word_t>     serializable_token::
+const std::vector<word_t>&  serializable_token::
 byteline() const noexcept
 { return m_byteline; }
 
@@ -37,6 +37,14 @@ bool                    serializable_token::
 labelable() const noexcept
 { return m_labelable; }
 
+std::span<const byte_t> serializable_token::
+binary() const noexcept
+{ return m_binary; }
+
+uint32_t                serializable_token::
+row() const noexcept
+{ return m_row; }
+
 
 void                    serializable_token::
 kind(const st_kind kind) noexcept
@@ -57,3 +65,14 @@ number(const word_t value) noexcept
 void                    serializable_token::
 labelable(const bool value) noexcept
 { m_labelable = value; }
+
+void                    serializable_token::
+binary(std::shared_ptr<const source_file> file, const std::span<const byte_t> bytes) noexcept
+{
+    m_binary_file = std::move(file);
+    m_binary      = bytes;
+}
+
+void                    serializable_token::
+row(const uint32_t value) noexcept
+{ m_row = value; }
@@ -10,35 +10,184 @@
 using namespace mxasm;
 using st_kind = serializable_token::st_kind;
 using st_command = serializable_token::st_command;
+using st_mode = serializable_token::st_mode;
 
 serializer::
-serializer(std::list<serializable_token> &tokens)
-    : m_tokens {std::move(tokens)}
+serializer(const std::vector<serializable_token> &tokens, const encoding_options &encoding)
+    : m_tokens {tokens}, m_encoding {encoding} {}
+
+
+memory_image            serializer::
+binary_program(source_map *map)
 {
-    m_program.reserve(0x10'00);
-    for (word_t i = 0; i < 0x10'00; ++i) m_program.push_back(0);
+    m_map = map;
+    if (m_map != nullptr) m_map->rows.assign(0x1'00'00, source_map::NO_ROW);
+    serialize();
+    return std::move(m_image);
 }
 
 
-std::vector<byte_t>     serializer::
-binary_program()
+std::size_t             serializer::
+command_size(const std::size_t token) const noexcept
 {
-    serialize();
-    return m_program;
+    if (m_forms[token] == command_form::LONG_BRANCH) {
+        return command_mode(m_commands[token]) == st_mode::ZPR ? 6 : 5;
+    }
+    return 1 + operand_size(command_mode(m_commands[token]));
+}
+
+// Addresses of the tokens and labels, with the commands as they are chosen so far
+void                    serializer::
+layout()
+{
+    word_t address = START_ADDRESS;
+    for (std::size_t i = 0; i < m_layout.size(); ++i) {
+        const auto &item = m_layout[i];
+        m_addresses[i] = address;
+        switch (item.kind) {
+            case st_kind::LABEL:    m_label_address[item.value] = address; break;
+            case st_kind::CODE_POS: address = item.value; break;
+            default:                address += item.value; break;
+        }
+    }
+}
+
+// Commands with a label operand take the shortest encoding that reaches the label: zero page forms
+// for labels under $100, a JMP or a branch over one for a branch out of reach, and when asked for,
+// BRA for a JMP within reach on the same page. Every change moves later labels, so the layout is
+// redone until nothing changes. A command that had to grow back is pinned, so none changes more
+// than twice
+void                    serializer::
+relax_commands()
+{
+    m_commands.resize(m_tokens.size());
+    m_forms.assign(m_tokens.size(), command_form::SHORT);
+    m_layout.resize(m_tokens.size());
+    m_addresses.resize(m_tokens.size());
+
+    std::vector<std::size_t> candidates;
+    for (std::size_t i = 0; i < m_tokens.size(); ++i) {
+        const auto &op = m_tokens[i];
+        switch (op.kind()) {
+            case st_kind::LABEL:
+                if (op.number() >= m_label_address.size()) m_label_address.resize(op.number() + 1);
+                m_layout[i] = {op.kind(), op.number()};
+                continue;
+            case st_kind::CODE_POS: m_layout[i] = {op.kind(), op.number()}; continue;
+            case st_kind::BYTE:     m_layout[i] = {op.kind(), uint32_t(op.byteline().size())}; continue;
+            case st_kind::WORD:     m_layout[i] = {op.kind(), uint32_t(op.byteline().size() * 2)}; continue;
+            case st_kind::BINARY:   m_layout[i] = {op.kind(), uint32_t(op.binary().size())}; continue;
+            case st_kind::OPCODE:   break;
+        }
+        const st_command command = op.command();
+        const st_mode    mode    = command_mode(command);
+        m_commands[i] = command;
+        m_layout[i]   = {op.kind(), uint32_t(1 + operand_size(mode))};
+
+        const bool promotable = op.labelable() and m_encoding.zero_page and zero_page_commands[static_cast<byte_t>(command)] != command;
+        const bool jump       = op.labelable() and m_encoding.shrink_jumps and command == st_command::JMP_abs;
+        const bool branch     = m_encoding.relax and (mode == st_mode::REL or mode == st_mode::ZPR);
+        if (promotable or jump or branch) candidates.push_back(i);
+    }
+
+    std::vector<bool> pinned(m_tokens.size());
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        layout();
+        for (const std::size_t i : candidates) {
+            if (pinned[i]) continue;
+            bool pin = false;
+            if (relax_command(i, pin)) {
+                m_layout[i].value = command_size(i);
+                changed = true;
+            }
+            pinned[i] = pin;
+        }
+    }
 }
 
+bool                    serializer::
+relax_command(const std::size_t token, bool &pinned)
+{
+    const auto &op            = m_tokens[token];
+    const auto &label_address = m_label_address;
+    const auto original = op.command();
+    auto &command       = m_commands[token];
+    const word_t next   = m_addresses[token] + 2;     // Behind the command as a two byte branch
+
+    const auto reaches = [](const word_t from, const word_t target) {
+        const int32_t distance = target - from;
+        return distance >= -128 and distance <= 127;
+    };
+
+    switch (command_mode(original)) {
+        case st_mode::REL:
+            if (reaches(next, label_address[op.number()])) return false;
+            if (original == st_command::BRA_rel) {
+                command = st_command::JMP_abs;
+            } else {
+                m_forms[token] = command_form::LONG_BRANCH;
+            }
+            pinned = true;
+            return true;
+
+        case st_mode::ZPR:
+            if (reaches(next + 1, label_address[op.byteline()[0]])) return false;
+            m_forms[token] = command_form::LONG_BRANCH;
+            pinned = true;
+            return true;
+
+        default:
+            break;
+    }
+
+    const word_t target = label_address[op.number()];
+    if (original == st_command::JMP_abs) {
+        // BRA is only as fast as JMP when it stays on the page
+        const bool fits = reaches(next, target) and ((next ^ target) & 0xFF'00) == 0;
+        if (command == st_command::JMP_abs and fits) {
+            command = st_command::BRA_rel;
+            return true;
+        }
+        if (command == st_command::BRA_rel and not fits) {
+            command = st_command::JMP_abs;
+            pinned = true;
+            return true;
+        }
+        return false;
+    }
+
+    const auto zero_page = zero_page_commands[static_cast<byte_t>(original)];
+    if (command == original and target <= 0xFF) {
+        command = zero_page;
+        return true;
+    }
+    if (command == zero_page and target > 0xFF) {
+        command = original;
+        pinned = true;
+        return true;
+    }
+    return false;
+}
 
 void                    serializer::
 serialize()
 {
-    std::map<word_t, word_t> label_address;
-    std::map<std::pair<word_t, word_t>, bool> labelable_commands; // Address - Label - two_bytes
-    std::map<word_t, word_t> relative_labels;                     // address - label
-    std::set<std::tuple<word_t, word_t, bool>> immediate_labels; // address - label - is_low
+    // Every label address is known once the commands are relaxed, so operands are written as they come
+    relax_commands();
+    const auto &label_address = m_label_address;
 
-    for (const auto &op : m_tokens) {
+    for (std::size_t i = 0; i < m_tokens.size(); ++i) {
+        const auto &op = m_tokens[i];
+        m_row = op.row();
         if (op.kind() == st_kind::LABEL) {
-            label_address.emplace(op.number(), m_write_address);
+            if (m_map != nullptr) {
+                if (op.number() >= m_map->labels.size()) m_map->labels.resize(op.number() + 1);
+                m_map->labels[op.number()].address = m_write_address;
+                m_map->labels[op.number()].row     = m_row;
+                m_map->labels[op.number()].placed  = true;
+            }
             continue;
         }
         if (op.kind() == st_kind::CODE_POS) {
@@ -57,316 +206,92 @@ serialize()
             }
             continue;
         }
+        if (op.kind() == st_kind::BINARY) {
+            m_image.write(m_write_address, op.binary());
+            if (m_map != nullptr) {
+                for (std::size_t i = 0; i < op.binary().size(); ++i) {
+                    m_map->rows[static_cast<word_t>(m_write_address + i)] = m_row;
+                }
+            }
+            m_write_address += op.binary().size();
+            continue;
+        }
 
         if (op.kind() == st_kind::OPCODE) {
-            byte_t code;
-            word_t data;
-            switch (op.command()) {
-                case st_command::BRK_stk:                                      // Implied and Stack
-                case st_command::CLC_imp:
-                case st_command::CLD_imp:
-                case st_command::CLI_imp:
-                case st_command::CLV_imp:
-                case st_command::DEX_imp:
-                case st_command::DEY_imp:
-                case st_command::INX_imp:
-                case st_command::INY_imp:
-                case st_command::NOP_imp:
-                case st_command::PHA_stk:
-                case st_command::PHP_stk:
-                case st_command::PHX_stk:
-                case st_command::PHY_stk:
-                case st_command::PLA_stk:
-                case st_command::PLP_stk:
-                case st_command::PLX_stk:
-                case st_command::PLY_stk:
-                case st_command::RTS_stk:
-                case st_command::RTI_stk:
-                case st_command::SEC_imp:
-                case st_command::SED_imp:
-                case st_command::SEI_imp:
-                case st_command::STP_imp:
-                case st_command::TAX_imp:
-                case st_command::TAY_imp:
-                case st_command::TSX_imp:
-                case st_command::TXA_imp:
-                case st_command::TXS_imp:
-                case st_command::TYA_imp:
-                case st_command::WAI_imp:
-
-                case st_command::ASL_a:
-                case st_command::INC_a:
-                case st_command::ROL_a:
-                case st_command::DEC_a:
-                case st_command::LSR_a:
-                case st_command::ROR_a:
-                    code = static_cast<byte_t>(op.command());
-                    write_byte_to_memory(code);
-                    break;
+            if (m_map != nullptr) m_map->commands.push_back(m_write_address);
+            if (m_forms[i] == command_form::LONG_BRANCH) {
+                const bool bit_branch = command_mode(m_commands[i]) == st_mode::ZPR;
+                write_byte_to_memory(static_cast<byte_t>(inverted_branch(m_commands[i])));
+                if (bit_branch) write_byte_to_memory(op.number());
+                write_byte_to_memory(3);                // Over the JMP
+                if (m_map != nullptr) m_map->commands.push_back(m_write_address);
+                write_byte_to_memory(static_cast<byte_t>(st_command::JMP_abs));
+                write_word_to_memory(label_address[bit_branch ? op.byteline()[0] : op.number()]);
+                continue;
+            }
 
-                case st_command::JMP_abs:
-                case st_command::JSR_abs:
-                case st_command::ASL_abs:
-                case st_command::INC_abs:
-                case st_command::ROL_abs:
-                case st_command::DEC_abs:
-                case st_command::LSR_abs:
-                case st_command::ROR_abs:
-                case st_command::STX_abs:
-                case st_command::LDX_abs:
-                case st_command::TSB_abs:
-                case st_command::ORA_abs:
-                case st_command::TRB_abs:
-                case st_command::BIT_abs:
-                case st_command::AND_abs:
-                case st_command::EOR_abs:
-                case st_command::ADC_abs:
-                case st_command::CPX_abs:
-                case st_command::SBC_abs:
-                case st_command::STY_abs:
-                case st_command::STA_abs:
-                case st_command::STZ_abs:
-                case st_command::LDY_abs:
-                case st_command::LDA_abs:
-                case st_command::CPY_abs:
-                case st_command::CMP_abs:
-
-                case st_command::ORA_abx:
-                case st_command::ORA_aby:
-                case st_command::AND_abx:
-                case st_command::AND_aby:
-                case st_command::EOR_abx:
-                case st_command::EOR_aby:
-                case st_command::ADC_abx:
-                case st_command::ADC_aby:
-                case st_command::STA_abx:
-                case st_command::STA_aby:
-                case st_command::LDA_abx:
-                case st_command::LDA_aby:
-                case st_command::CMP_abx:
-                case st_command::CMP_aby:
-                case st_command::SBC_abx:
-                case st_command::SBC_aby:
-                case st_command::BIT_abx:
-                case st_command::LDY_abx:
-                case st_command::STZ_abx:
-                case st_command::INC_abx:
-                case st_command::DEC_abx:
-                case st_command::ASL_abx:
-                case st_command::ROL_abx:
-                case st_command::ROR_abx:
-                case st_command::LSR_abx:
-                case st_command::LDX_aby:
-
-                case st_command::JMP_ind:
-                case st_command::JMP_iax:
-                    code = static_cast<byte_t>(op.command());
-                    write_byte_to_memory(code);
-                    if (op.labelable()) {
-                        labelable_commands.emplace(std::make_pair(m_write_address, op.number()), true);
-                        data = 0xFF'FF;
-                    } else {
-                        data = op.number();
-                    }
-                    write_word_to_memory(data);
+            // A BRA out of reach is a JMP now, still with its label
+            const bool label_operand = op.labelable() or command_mode(op.command()) == st_mode::REL;
+            write_byte_to_memory(static_cast<byte_t>(m_commands[i]));
+            switch (command_mode(m_commands[i])) {
+                case st_mode::IMP:
+                case st_mode::STK:
+                case st_mode::ACC:
                     break;
 
-                case st_command::BPL_rel:
-                case st_command::BMI_rel:
-                case st_command::BVC_rel:
-                case st_command::BVS_rel:
-                case st_command::BRA_rel:
-                case st_command::BCC_rel:
-                case st_command::BCS_rel:
-                case st_command::BNE_rel:
-                case st_command::BEQ_rel:
-                    code = static_cast<byte_t>(op.command()); // ELSE 00
-                    write_byte_to_memory(code);
-                    relative_labels.emplace(m_write_address, op.number());
-                    write_byte_to_memory(0);
+                case st_mode::ABS:
+                case st_mode::ABX:
+                case st_mode::ABY:
+                case st_mode::IND:
+                case st_mode::IAX:
+                    write_word_to_memory(label_operand ? label_address[op.number()] : op.number());
                     break;
 
-                case st_command::RMB0_zpg:
-                case st_command::RMB1_zpg:
-                case st_command::RMB2_zpg:
-                case st_command::RMB3_zpg:
-                case st_command::RMB4_zpg:
-                case st_command::RMB5_zpg:
-                case st_command::RMB6_zpg:
-                case st_command::RMB7_zpg:
-                case st_command::SMB0_zpg:
-                case st_command::SMB1_zpg:
-                case st_command::SMB2_zpg:
-                case st_command::SMB3_zpg:
-                case st_command::SMB4_zpg:
-                case st_command::SMB5_zpg:
-                case st_command::SMB6_zpg:
-                case st_command::SMB7_zpg:
-
-                case st_command::ORA_zpg:
-                case st_command::TSB_zpg:
-                case st_command::ASL_zpg:
-                case st_command::TRB_zpg:
-                case st_command::STZ_zpg:
-                case st_command::BIT_zpg:
-                case st_command::AND_zpg:
-                case st_command::ROL_zpg:
-                case st_command::EOR_zpg:
-                case st_command::LSR_zpg:
-                case st_command::ADC_zpg:
-                case st_command::ROR_zpg:
-                case st_command::STY_zpg:
-                case st_command::STA_zpg:
-                case st_command::STX_zpg:
-                case st_command::LDY_zpg:
-                case st_command::LDA_zpg:
-                case st_command::LDX_zpg:
-                case st_command::CMP_zpg:
-                case st_command::CPY_zpg:
-                case st_command::CPX_zpg:
-                case st_command::INC_zpg:
-                case st_command::DEC_zpg:
-                case st_command::SBC_zpg:
-
-                case st_command::ORA_zpx:
-                case st_command::BIT_zpx:
-                case st_command::STZ_zpx:
-                case st_command::ASL_zpx:
-                case st_command::STY_zpx:
-                case st_command::LDY_zpx:
-                case st_command::AND_zpx:
-                case st_command::ROL_zpx:
-                case st_command::EOR_zpx:
-                case st_command::LSR_zpx:
-                case st_command::ADC_zpx:
-                case st_command::ROR_zpx:
-                case st_command::STA_zpx:
-                case st_command::LDA_zpx:
-                case st_command::CMP_zpx:
-                case st_command::DEC_zpx:
-                case st_command::SBC_zpx:
-                case st_command::INC_zpx:
-                case st_command::STX_zpy:
-                case st_command::LDX_zpy:
-
-                case st_command::ORA_izp:
-                case st_command::AND_izp:
-                case st_command::EOR_izp:
-                case st_command::ADC_izp:
-                case st_command::STA_izp:
-                case st_command::LDA_izp:
-                case st_command::CMP_izp:
-                case st_command::SBC_izp:
-
-                case st_command::ORA_izy:
-                case st_command::AND_izy:
-                case st_command::EOR_izy:
-                case st_command::ADC_izy:
-                case st_command::STA_izy:
-                case st_command::LDA_izy:
-                case st_command::CMP_izy:
-                case st_command::SBC_izy:
-
-                case st_command::ORA_izx:
-                case st_command::AND_izx:
-                case st_command::EOR_izx:
-                case st_command::ADC_izx:
-                case st_command::STA_izx:
-                case st_command::LDA_izx:
-                case st_command::CMP_izx:
-                case st_command::SBC_izx:
-                    code = static_cast<byte_t>(op.command());
-                    write_byte_to_memory(code);
-                    write_byte_to_memory(op.number());
+                case st_mode::REL:
+                    write_relative(label_address[op.number()]);
                     break;
 
+                case st_mode::ZPG:
+                case st_mode::ZPX:
+                case st_mode::ZPY:
+                    write_byte_to_memory(op.labelable() ? label_address[op.number()] & 0x00'FF : op.number());
+                    break;
 
+                case st_mode::IZP:
+                case st_mode::IZX:
+                case st_mode::IZY:
+                    if (op.labelable()) {
+                        write_pointer(label_address[op.number()]);
+                    } else {
+                        write_byte_to_memory(op.number());
+                    }
+                    break;
 
-                case st_command::BBR0_zpr:
-                case st_command::BBR1_zpr:
-                case st_command::BBR2_zpr:
-                case st_command::BBR3_zpr:
-                case st_command::BBR4_zpr:
-                case st_command::BBR5_zpr:
-                case st_command::BBR6_zpr:
-                case st_command::BBR7_zpr:
-                case st_command::BBS0_zpr:
-                case st_command::BBS1_zpr:
-                case st_command::BBS2_zpr:
-                case st_command::BBS3_zpr:
-                case st_command::BBS4_zpr:
-                case st_command::BBS5_zpr:
-                case st_command::BBS6_zpr:
-                case st_command::BBS7_zpr:
-                    code = static_cast<byte_t>(op.command());
-                    write_byte_to_memory(code);
+                case st_mode::ZPR:
                     write_byte_to_memory(op.number());
-                    relative_labels.emplace(m_write_address, op.byteline()[0]);
-                    write_byte_to_memory(0xFF);
+                    write_relative(label_address[op.byteline()[0]]);
                     break;
 
-                case st_command::LDY_imm:
-                case st_command::CPY_imm:
-                case st_command::CPX_imm:
-                case st_command::LDX_imm:
-                case st_command::ORA_imm:
-                case st_command::AND_imm:
-                case st_command::EOR_imm:
-                case st_command::ADC_imm:
-                case st_command::BIT_imm:
-                case st_command::LDA_imm:
-                case st_command::CMP_imm:
-                case st_command::SBC_imm:
-                    code = static_cast<byte_t>(op.command());
-                    write_byte_to_memory(code);
+                case st_mode::IMM:
                     if (op.byteline().empty()) {
                         write_byte_to_memory(op.number());
                     } else {
-                        immediate_labels.emplace(m_write_address, op.number(), op.byteline()[0] == '<');
-                        write_byte_to_memory(0xFF);
+                        const word_t target = label_address[op.number()];
+                        write_byte_to_memory(op.byteline()[0] == '<' ? target & 0x00'FF : target / 0x100);
                     }
                     break;
             }
             continue;
         }
     }
-
-    // For labels
-    for (const auto &[address, two_bytes] : labelable_commands) {
-        m_write_address = address.first;
-        if (two_bytes) {
-            write_word_to_memory(label_address.at(address.second));
-        } else {
-            write_byte_to_memory(label_address.at(address.second));
-        }
-    }
-
-    // For relative
-    for (const auto &[address, lbl] : relative_labels) {
-        m_write_address = address;
-
-        int32_t distance = label_address.at(lbl) - (m_write_address + 1); // Standard offset from next instruction
-        if (distance < -128 or distance > 127) {
-            write_byte_to_memory(0x00);
-            continue;
-        }
-        write_byte_to_memory(distance);
-    }
-
-    // For immediate
-    for (const auto &[adr, lbl, low] : immediate_labels) {
-        m_write_address = adr;
-        write_byte_to_memory(low ? label_address.at(lbl) & 0x00'FF : label_address.at(lbl) / 0x100);
-    }
-    m_program.erase(m_program.begin() + m_end_of_program + 1, m_program.end());
+    if (not m_diagnostics.empty()) throw std::move(m_diagnostics);
 }
 
 void                    serializer::
 write_byte_to_memory(const byte_t value)
 {
-    if (m_write_address < 0x0600) return;
-    m_program[m_write_address - 0x06'00] = value;
-    m_end_of_program = std::max<word_t>(m_end_of_program, m_write_address - 0x06'00);
+    m_image.write(m_write_address, value);
+    if (m_map != nullptr) m_map->rows[m_write_address] = m_row;
     ++m_write_address;
 }
 
@@ -375,4 +300,28 @@ write_word_to_memory(const word_t value)
 {
     write_byte_to_memory(value & 0x00'FF);
     write_byte_to_memory((value >> 8) & 0x00'FF);
-}
\ No newline at end of file
+}
+
+// Offset from the next command, always within reach once the commands are relaxed
+void                    serializer::
+write_relative(const word_t target)
+{
+    const int32_t distance = target - (m_write_address + 1);
+    if (distance < -128 or distance > 127) {
+        m_diagnostics.add(diagnostic_code::BRANCH_OUT_OF_REACH, m_row, 0, std::to_string(distance));
+    }
+    write_byte_to_memory(static_cast<byte_t>(distance));
+}
+
+// A pointer label has no absolute form to fall back to, it has to end up in the zero page
+void                    serializer::
+write_pointer(const word_t target)
+{
+    if (target > 0xFF) {
+        constexpr std::string_view digits = "0123456789ABCDEF";
+        const char address[] {'$', digits[target >> 12], digits[(target >> 8) & 0xF],
+                              digits[(target >> 4) & 0xF], digits[target & 0xF]};
+        m_diagnostics.add(diagnostic_code::ZERO_PAGE_EXPECTED, m_row, 0, {address, sizeof(address)});
+    }
+    write_byte_to_memory(target & 0x00'FF);
+}
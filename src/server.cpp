@@ -0,0 +1,363 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |             Server            |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+
+#if defined(__unix__) or defined(__APPLE__)
+#define MXASM_HAS_UNIX_SOCKETS
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "../include/server.hpp"
+#include "../include/file_descriptor.hpp"
+#include "../include/exceptions/arguments_exception.hpp"
+
+using namespace mxasm;
+
+
+namespace
+{
+    constexpr std::size_t   CACHE_CAPACITY   = 64;
+    constexpr std::uint32_t MAX_MESSAGE_SIZE = 64u << 20;
+
+    // Results of the latest requests, the least recently used one goes first. Shared by all connections
+    class result_cache
+    {
+    public:
+        std::optional<assembly_result> find(const std::string_view key)
+        {
+            const std::lock_guard lock(m_mutex);
+            const auto found = m_index.find(key);
+            if (found == m_index.end()) return std::nullopt;
+            m_entries.splice(m_entries.begin(), m_entries, found->second);
+            return found->second->result;
+        }
+
+        void insert(std::string key, assembly_result result)
+        {
+            const std::lock_guard lock(m_mutex);
+            if (const auto found = m_index.find(key); found != m_index.end()) {
+                m_entries.erase(found->second);
+                m_index.erase(found);
+            }
+            m_entries.push_front({std::move(key), std::move(result)});
+            m_index.emplace(m_entries.front().key, m_entries.begin());
+
+            if (m_entries.size() > CACHE_CAPACITY) {
+                m_index.erase(m_entries.back().key);
+                m_entries.pop_back();
+            }
+        }
+
+    private:
+        struct entry
+        {
+            std::string     key;
+            assembly_result result;
+        };
+
+        // Index keys are views into the list nodes, which never move
+        std::mutex                                                       m_mutex;
+        std::list<entry>                                                 m_entries;
+        std::unordered_map<std::string_view, std::list<entry>::iterator> m_index;
+    };
+
+
+#ifdef MXASM_HAS_UNIX_SOCKETS
+    // Set by a signal or a 'Q' request, from any thread
+    std::atomic<bool> stop_requested {false};
+    static_assert(std::atomic<bool>::is_always_lock_free);
+
+    extern "C" void request_stop(int)
+    { stop_requested = true; }
+
+    // Every connection is served on a thread of its own, so an idle client blocks no other one
+    class server_state
+    {
+    public:
+        server_state(const pipeline_options &pipeline, const int listener)
+            : m_pipeline {pipeline}, m_listener {listener} {}
+
+        const pipeline_options &pipeline() const noexcept
+        { return m_pipeline; }
+
+        result_cache &cache() noexcept
+        { return m_cache; }
+
+        // Wakes the accept loop of the server
+        void stop() noexcept
+        {
+            stop_requested = true;
+            shutdown(m_listener, SHUT_RDWR);
+        }
+
+    private:
+        const pipeline_options &m_pipeline;
+        const int               m_listener;
+        result_cache            m_cache;
+    };
+
+    // A client and the thread serving it. The descriptor is closed once the thread is joined
+    struct connection
+    {
+        file_descriptor   client;
+        std::atomic<bool> served {false};
+        std::thread       thread {};
+
+        explicit connection(const int fd) : client {fd} {}
+    };
+
+    sockaddr_un socket_address(const std::string &socket_path)
+    {
+        sockaddr_un address {};
+        address.sun_family = AF_UNIX;
+        if (socket_path.empty() or socket_path.length() >= sizeof(address.sun_path)) {
+            throw arguments_exception("Wrong server socket path '" + socket_path + "'");
+        }
+        std::memcpy(address.sun_path, socket_path.c_str(), socket_path.length() + 1);
+        return address;
+    }
+
+    int connect_to(const std::string &socket_path)
+    {
+        const auto address = socket_address(socket_path);
+        const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return -1;
+        if (connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    // False on the end of the stream, or when the server is asked to stop
+    bool read_exact(const int fd, char *data, std::size_t size)
+    {
+        while (size > 0) {
+            const ssize_t count = read(fd, data, size);
+            if (count < 0 and errno == EINTR and not stop_requested) continue;
+            if (count <= 0) return false;
+            data += count;
+            size -= static_cast<std::size_t>(count);
+        }
+        return true;
+    }
+
+    bool write_all(const int fd, const char *data, std::size_t size)
+    {
+        while (size > 0) {
+            const ssize_t count = write(fd, data, size);
+            if (count < 0 and errno == EINTR) continue;
+            if (count <= 0) return false;
+            data += count;
+            size -= static_cast<std::size_t>(count);
+        }
+        return true;
+    }
+
+    bool receive_message(const int fd, std::string &payload)
+    {
+        char header[4];
+        if (not read_exact(fd, header, sizeof(header))) return false;
+        const std::uint32_t size = read_u32(header);
+        if (size > MAX_MESSAGE_SIZE) return false;
+
+        payload.resize(size);
+        return read_exact(fd, payload.data(), size);
+    }
+
+    bool send_message(const int fd, const std::string_view payload)
+    {
+        std::string header;
+        append_u32(header, static_cast<std::uint32_t>(payload.size()));
+        return write_all(fd, header.data(), header.size()) and write_all(fd, payload.data(), payload.size());
+    }
+
+    // Files are looked up by path, size and modification time, texts by their whole contents
+    assembly_result assemble_request(const std::string_view body, const bool is_text,
+                                     const pipeline_options &pipeline, result_cache &cache)
+    {
+        std::string key(1, is_text ? 'T' : 'P');
+        key += body;
+
+        if (not is_text) {
+            std::error_code error;
+            const std::string path(body);
+            const auto size = std::filesystem::file_size(path, error);
+            const auto time = std::filesystem::last_write_time(path, error);
+            if (error) return assemble_file(path, pipeline);
+
+            key += '\0' + std::to_string(size) + '\0' + std::to_string(time.time_since_epoch().count());
+        }
+
+        if (auto cached = cache.find(key)) return std::move(*cached);
+
+        auto result = is_text ? assemble(body, pipeline) : assemble_file(std::string(body), pipeline);
+        if (result.is_reproducible()) cache.insert(std::move(key), result);    // Assets may change under the key
+        return result;
+    }
+
+    void serve_connection(const int client, server_state &state)
+    {
+        std::string request;
+        while (not stop_requested and receive_message(client, request)) {
+            if (request.empty()) return;
+            const std::string_view body = std::string_view(request).substr(1);
+
+            assembly_result result;
+            switch (request.front()) {
+                case 'P': result = assemble_request(body, false, state.pipeline(), state.cache()); break;
+                case 'T': result = assemble_request(body, true, state.pipeline(), state.cache()); break;
+                case 'Q': state.stop(); break;
+                default:
+                    result = {EXIT_FAILURE, {diagnostic_code::SYSTEM_ERROR, "Unknown server request '" + std::string(1, request.front()) + "'"}, {}};
+            }
+            if (not send_message(client, encode_result(result))) return;
+        }
+    }
+
+    void install_signal_handlers()
+    {
+        struct sigaction action {};
+        action.sa_handler = request_stop;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = 0;                    // No SA_RESTART, so accept and read return on a signal
+        sigaction(SIGINT, &action, nullptr);
+        sigaction(SIGTERM, &action, nullptr);
+        std::signal(SIGPIPE, SIG_IGN);
+    }
+#endif
+}
+
+
+int                     mxasm::
+run_server(const std::string &socket_path, const pipeline_options &pipeline)
+{
+#ifdef MXASM_HAS_UNIX_SOCKETS
+    const auto address = socket_address(socket_path);
+
+    // A socket left behind by a server that died is removed, a live one is not
+    struct stat path_stat {};
+    if (lstat(socket_path.c_str(), &path_stat) == 0) {
+        const file_descriptor running(S_ISSOCK(path_stat.st_mode) ? connect_to(socket_path) : -1);
+        if (running.is_open() or not S_ISSOCK(path_stat.st_mode)) {
+            throw arguments_exception("Server socket path '" + socket_path + "' is already in use");
+        }
+        unlink(socket_path.c_str());
+    }
+
+    const file_descriptor listener(socket(AF_UNIX, SOCK_STREAM, 0));
+    if (not listener.is_open()
+        or bind(listener.get(), reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0) {
+        throw arguments_exception("Can't create server socket '" + socket_path + "'");
+    }
+    chmod(socket_path.c_str(), S_IRUSR | S_IWUSR);
+    if (listen(listener.get(), SOMAXCONN) != 0) {
+        unlink(socket_path.c_str());
+        throw arguments_exception("Can't listen on server socket '" + socket_path + "'");
+    }
+
+    stop_requested = false;
+    install_signal_handlers();
+    server_state state(pipeline, listener.get());
+
+    // Signals stay with this thread, where they interrupt accept
+    sigset_t signals, previous;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+
+    std::list<connection> connections;
+    while (not stop_requested) {
+        const int client = accept(listener.get(), nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR or errno == ECONNABORTED) continue;
+            break;
+        }
+        std::erase_if(connections, [](connection &done) {
+            if (not done.served) return false;
+            done.thread.join();
+            return true;
+        });
+
+        auto &served = connections.emplace_back(client);
+        pthread_sigmask(SIG_BLOCK, &signals, &previous);
+        served.thread = std::thread([&served, &state] {
+            serve_connection(served.client.get(), state);
+            served.served = true;
+        });
+        pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+    }
+
+    // Clients still waiting for a request get the end of the stream
+    for (auto &open : connections) {
+        shutdown(open.client.get(), SHUT_RDWR);
+        open.thread.join();
+    }
+    unlink(socket_path.c_str());
+    return EXIT_SUCCESS;
+#else
+    throw arguments_exception("Server mode needs Unix domain sockets");
+#endif
+}
+
+std::vector<assembly_result>    mxasm::
+request_assembly(const std::string &socket_path, const std::vector<std::string> &source_paths)
+{
+#ifdef MXASM_HAS_UNIX_SOCKETS
+    std::signal(SIGPIPE, SIG_IGN);
+    const file_descriptor server(connect_to(socket_path));
+    if (not server.is_open()) {
+        throw arguments_exception("Can't connect to server socket '" + socket_path + "'");
+    }
+
+    std::vector<assembly_result> results;
+    std::string response;
+    for (const auto &path : source_paths) {
+        const auto request = 'P' + std::filesystem::absolute(path).string();
+        if (not send_message(server.get(), request) or not receive_message(server.get(), response)) {
+            throw arguments_exception("Lost connection to server socket '" + socket_path + "'");
+        }
+        auto result = decode_result(response);
+        if (not result) {
+            throw arguments_exception("Malformed response from server socket '" + socket_path + "'");
+        }
+        results.push_back(std::move(*result));
+    }
+    return results;
+#else
+    throw arguments_exception("Server mode needs Unix domain sockets");
+#endif
+}
+
+std::string             mxasm::
+default_socket_path()
+{
+    if (const char *runtime_dir = std::getenv("XDG_RUNTIME_DIR"); runtime_dir != nullptr and *runtime_dir != '\0') {
+        return std::string(runtime_dir) + "/mxasm.sock";
+    }
+#ifdef MXASM_HAS_UNIX_SOCKETS
+    return "/tmp/mxasm-" + std::to_string(getuid()) + ".sock";
+#else
+    return "mxasm.sock";
+#endif
+}
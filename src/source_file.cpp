@@ -0,0 +1,241 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |          Source File          |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <cerrno>
+#include <cstring>
+
+#if defined(__unix__) or defined(__APPLE__)
+#define MXASM_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "../include/source_file.hpp"
+
+using namespace mxasm;
+
+
+source_file::
+source_file(const std::string &file_path)
+{
+#ifdef MXASM_HAS_MMAP
+    map_file(file_path);
+#else
+    read_file(file_path);
+#endif
+    index_lines();
+}
+
+source_file             source_file::
+from_text(std::string text)
+{
+    source_file source;
+    source.m_buffer = std::move(text);
+    source.m_data   = source.m_buffer.data();
+    source.m_size   = source.m_buffer.size();
+    source.index_lines();
+    return source;
+}
+
+source_file             source_file::
+from_view(const std::string_view text)
+{
+    source_file source;
+    source.m_data    = text.data();
+    source.m_size    = text.size();
+    source.m_is_view = true;
+    source.index_lines();
+    return source;
+}
+
+source_file             source_file::
+binary(const std::string &file_path)
+{
+    source_file file;
+#ifdef MXASM_HAS_MMAP
+    file.map_file(file_path);
+#else
+    file.read_file(file_path);
+#endif
+    return file;
+}
+
+source_file::
+source_file(source_file &&other) noexcept
+{ *this = std::move(other); }
+
+source_file::
+~source_file()
+{ release(); }
+
+source_file&            source_file::
+operator=(source_file &&other) noexcept
+{
+    if (this == &other) return *this;
+    release();
+
+    const bool owns_buffer = not other.m_is_mapped and not other.m_is_view;
+    m_buffer       = std::move(other.m_buffer);
+    m_data         = owns_buffer ? m_buffer.data() : other.m_data;
+    m_size         = other.m_size;
+    m_is_mapped    = other.m_is_mapped;
+    m_is_view      = other.m_is_view;
+    m_lines        = std::move(other.m_lines);
+    m_line_offsets = std::move(other.m_line_offsets);
+
+    // Small buffers may live inside the string object itself, so the views must follow the move
+    for (auto &line : m_lines) {
+        line.text = {m_data + (line.text.data() - other.m_data), line.text.length()};
+    }
+
+    other.m_data      = nullptr;
+    other.m_size      = 0;
+    other.m_is_mapped = false;
+    other.m_is_view   = false;
+    return *this;
+}
+
+
+std::string_view        source_file::
+text() const noexcept
+{ return {m_data, m_size}; }
+
+const source_listing&   source_file::
+lines() const noexcept
+{ return m_lines; }
+
+const std::vector<std::size_t>&   source_file::
+line_offsets() const noexcept
+{ return m_line_offsets; }
+
+
+void                    source_file::
+map_file(const std::string &file_path)
+{
+#ifdef MXASM_HAS_MMAP
+    const int descriptor = open(file_path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw arguments_exception("Can't open source code file \'" + file_path + '\'');
+    }
+
+    struct stat file_stat {};
+    if (fstat(descriptor, &file_stat) != 0 or not S_ISREG(file_stat.st_mode)) {
+        // Read from the open descriptor: a pipe opened again may have lost its writer already
+        read_descriptor(descriptor, file_path);
+        close(descriptor);
+        return;
+    }
+
+    m_size = file_stat.st_size;
+    if (m_size == 0) {
+        close(descriptor);
+        m_data = m_buffer.data();
+        return;
+    }
+
+    void *mapping = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (mapping == MAP_FAILED) {
+        m_size = 0;
+        read_file(file_path);
+        return;
+    }
+    madvise(mapping, m_size, MADV_SEQUENTIAL);
+
+    m_data      = static_cast<const char *>(mapping);
+    m_is_mapped = true;
+#else
+    read_file(file_path);
+#endif
+}
+
+void                    source_file::
+read_file(const std::string &file_path)
+{
+    std::ifstream file_reader(file_path, std::ios_base::binary);
+
+    if (not file_reader.is_open()) {
+        throw arguments_exception("Can't open source code file \'" + file_path + '\'');
+    }
+
+    file_reader.seekg(0, std::ios_base::end);
+    const auto file_size = file_reader.tellg();
+    file_reader.seekg(0, std::ios_base::beg);
+
+    if (file_size > 0) {
+        m_buffer.resize(static_cast<std::size_t>(file_size));
+        file_reader.read(m_buffer.data(), file_size);
+        m_buffer.resize(static_cast<std::size_t>(file_reader.gcount()));
+    } else {
+        m_buffer.assign(std::istreambuf_iterator<char>(file_reader), std::istreambuf_iterator<char>());
+    }
+    file_reader.close();
+
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+}
+
+#ifdef MXASM_HAS_MMAP
+void                    source_file::
+read_descriptor(const int descriptor, const std::string &file_path)
+{
+    std::size_t size = 0;
+    m_buffer.resize(4096);
+    while (true) {
+        if (size == m_buffer.size()) m_buffer.resize(size * 2);
+        const auto count = read(descriptor, m_buffer.data() + size, m_buffer.size() - size);
+        if (count == 0) break;
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            close(descriptor);
+            throw arguments_exception("Can't read source code file \'" + file_path + '\'');
+        }
+        size += static_cast<std::size_t>(count);
+    }
+    m_buffer.resize(size);
+
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+}
+#endif
+
+void                    source_file::
+index_lines()
+{
+    const char *iter = m_data;
+    const char *end  = m_data + m_size;
+
+    while (iter != end) {
+        m_line_offsets.push_back(iter - m_data);
+
+        const char *line_end = static_cast<const char *>(std::memchr(iter, '\n', end - iter));
+        if (line_end == nullptr) line_end = end;
+
+        const std::string_view line(iter, line_end - iter);
+        if (line.find_first_not_of(' ') != std::string_view::npos) {
+            m_lines.push_back({m_line_offsets.size(), line});
+        }
+
+        iter = line_end == end ? end : line_end + 1;
+    }
+}
+
+void                    source_file::
+release() noexcept
+{
+#ifdef MXASM_HAS_MMAP
+    if (m_is_mapped) {
+        munmap(const_cast<char *>(m_data), m_size);
+    }
+#endif
+    m_data      = nullptr;
+    m_size      = 0;
+    m_is_mapped = false;
+    m_is_view   = false;
+}
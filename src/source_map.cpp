@@ -0,0 +1,45 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |           Source Map          |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <algorithm>
+
+#include "../include/source_map.hpp"
+
+using namespace mxasm;
+
+
+void                    source_map::
+add_lines(const source_file &source)
+{
+    const std::string_view text = source.text();
+    const auto &offsets = source.line_offsets();
+    lines.reserve(offsets.size());
+    for (std::size_t i = 0; i < offsets.size(); ++i) {
+        const std::size_t end = i + 1 < offsets.size() ? offsets[i + 1] : text.size();
+        std::string_view line = text.substr(offsets[i], end - offsets[i]);
+        if (line.ends_with('\n')) line.remove_suffix(1);
+        if (line.ends_with('\r')) line.remove_suffix(1);
+        lines.emplace_back(line);
+    }
+}
+
+std::string_view        source_map::
+row_text(const uint32_t row) const noexcept
+{ return row == NO_ROW or row > lines.size() ? std::string_view() : std::string_view(lines[row - 1]); }
+
+std::vector<std::size_t>    source_map::
+labels_by_address() const
+{
+    std::vector<std::size_t> ids;
+    for (std::size_t id = 0; id < labels.size(); ++id) {
+        if (labels[id].placed) ids.push_back(id);
+    }
+    std::stable_sort(ids.begin(), ids.end(), [this](const std::size_t a, const std::size_t b) {
+        return labels[a].address < labels[b].address;
+    });
+    return ids;
+}
@@ -0,0 +1,151 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |           Statistics          |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <iomanip>
+#include <sstream>
+
+#include "../include/stats.hpp"
+
+using namespace mxasm;
+
+
+namespace
+{
+    thread_local allocation_count current_allocations {};
+
+    std::string json_string(const std::string_view str)
+    {
+        std::ostringstream out;
+        out << '"';
+        for (const char c : str) {
+            switch (c) {
+                case '"':  out << "\\\""; break;
+                case '\\': out << "\\\\"; break;
+                case '\n': out << "\\n";  break;
+                case '\t': out << "\\t";  break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+                            << std::dec << std::setfill(' ');
+                    } else {
+                        out << c;
+                    }
+            }
+        }
+        out << '"';
+        return out.str();
+    }
+
+    void phase_to_text(std::ostringstream &out, const assembly_stats::phase &ph)
+    {
+        out << "  " << std::left << std::setw(36) << ph.name << std::right
+            << std::setw(12) << std::fixed << std::setprecision(3) << ph.milliseconds
+            << std::setw(12) << ph.tokens
+            << std::setw(12) << ph.allocations
+            << std::setw(14) << ph.bytes << '\n';
+    }
+
+    void phase_to_json(std::ostringstream &out, const assembly_stats::phase &ph)
+    {
+        out << "{\"name\": " << json_string(ph.name)
+            << ", \"ms\": " << std::fixed << std::setprecision(6) << ph.milliseconds
+            << ", \"tokens\": " << ph.tokens
+            << ", \"allocations\": " << ph.allocations
+            << ", \"allocated_bytes\": " << ph.bytes << '}';
+    }
+}
+
+
+allocation_count        mxasm::
+thread_allocations() noexcept
+{ return current_allocations; }
+
+void                    mxasm::
+count_allocation(const std::size_t bytes) noexcept
+{
+    ++current_allocations.allocations;
+    current_allocations.bytes += bytes;
+}
+
+
+assembly_stats::timer::
+timer(assembly_stats *stats, const std::string_view name) noexcept
+    : m_stats {stats},
+      m_name  {name}
+{
+    if (m_stats == nullptr) return;
+    m_start_allocations = thread_allocations();
+    m_start             = std::chrono::steady_clock::now();
+}
+
+assembly_stats::timer::
+~timer()
+{
+    if (m_stats == nullptr) return;
+    const auto elapsed     = std::chrono::steady_clock::now() - m_start;
+    const auto allocations = thread_allocations();
+    m_stats->m_phases.push_back({std::string(m_name),
+                                 std::chrono::duration<double, std::milli>(elapsed).count(),
+                                 m_tokens,
+                                 allocations.allocations - m_start_allocations.allocations,
+                                 allocations.bytes - m_start_allocations.bytes});
+}
+
+
+const std::vector<assembly_stats::phase>&   assembly_stats::
+phases() const noexcept
+{ return m_phases; }
+
+assembly_stats::phase   assembly_stats::
+total() const noexcept
+{
+    // Tokens of different phases count different things, so they are not summed
+    phase sum {"total"};
+    for (const auto &ph : m_phases) {
+        sum.milliseconds += ph.milliseconds;
+        sum.allocations  += ph.allocations;
+        sum.bytes        += ph.bytes;
+    }
+    return sum;
+}
+
+
+std::string             mxasm::
+stats_to_text(const std::vector<std::string> &paths, const std::vector<assembly_stats> &stats)
+{
+    std::ostringstream out;
+    for (std::size_t i = 0; i < stats.size(); ++i) {
+        out << paths[i] << ":\n";
+        out << "  " << std::left << std::setw(36) << "phase" << std::right
+            << std::setw(12) << "ms" << std::setw(12) << "tokens"
+            << std::setw(12) << "allocs" << std::setw(14) << "bytes" << '\n';
+        for (const auto &ph : stats[i].phases()) {
+            phase_to_text(out, ph);
+        }
+        phase_to_text(out, stats[i].total());
+    }
+    return out.str();
+}
+
+std::string             mxasm::
+stats_to_json(const std::vector<std::string> &paths, const std::vector<assembly_stats> &stats)
+{
+    std::ostringstream out;
+    out << "{\"files\": [";
+    for (std::size_t i = 0; i < stats.size(); ++i) {
+        out << (i == 0 ? "\n" : ",\n") << "  {\"path\": " << json_string(paths[i]) << ", \"phases\": [";
+        for (std::size_t j = 0; j < stats[i].phases().size(); ++j) {
+            out << (j == 0 ? "\n    " : ",\n    ");
+            phase_to_json(out, stats[i].phases()[j]);
+        }
+        out << "],\n   \"total\": ";
+        phase_to_json(out, stats[i].total());
+        out << '}';
+    }
+    out << "\n]}\n";
+    return out.str();
+}
@@ -0,0 +1,102 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |          Thread Pool          |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+
+#include "../include/thread_pool.hpp"
+
+using namespace mxasm;
+
+
+thread_pool::
+thread_pool(const std::size_t thread_count)
+    : m_thread_count {std::max<std::size_t>(thread_count, 1)} {}
+
+
+void                    thread_pool::
+run(const std::size_t job_count, const std::function<void(std::size_t)> &job)
+{
+    // A failed job doesn't stop the others, the first failure is rethrown once all of them ran
+    std::exception_ptr failure;
+    std::mutex failure_lock;
+
+    const std::size_t workers = std::min(m_thread_count, job_count);
+    if (workers <= 1) {
+        for (std::size_t i = 0; i < job_count; ++i) {
+            try {
+                job(i);
+            } catch (...) {
+                if (not failure) failure = std::current_exception();
+            }
+        }
+        if (failure) std::rethrow_exception(failure);
+        return;
+    }
+
+    // Jobs are dealt in contiguous blocks, so neighbouring jobs start on the same worker
+    std::vector<job_queue> queues(workers);
+    for (std::size_t i = 0; i < job_count; ++i) {
+        queues[i * workers / job_count].jobs.push_back(i);
+    }
+
+    auto worker = [&](const std::size_t self) {
+        std::size_t current;
+        while (true) {
+            bool found = take_own(queues[self], current);
+            for (std::size_t i = 1; not found and i < workers; ++i) {
+                found = steal(queues[(self + i) % workers], current);
+            }
+            if (not found) return;
+
+            try {
+                job(current);
+            } catch (...) {
+                std::lock_guard guard(failure_lock);
+                if (not failure) failure = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (std::size_t i = 1; i < workers; ++i) {
+        threads.emplace_back(worker, i);
+    }
+    worker(0);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    if (failure) std::rethrow_exception(failure);
+}
+
+std::size_t             thread_pool::
+thread_count() const noexcept
+{ return m_thread_count; }
+
+
+bool                    thread_pool::
+take_own(job_queue &queue, std::size_t &job)
+{
+    std::lock_guard guard(queue.lock);
+    if (queue.jobs.empty()) return false;
+    job = queue.jobs.back();
+    queue.jobs.pop_back();
+    return true;
+}
+
+bool                    thread_pool::
+steal(job_queue &queue, std::size_t &job)
+{
+    std::lock_guard guard(queue.lock);
+    if (queue.jobs.empty()) return false;
+    job = queue.jobs.front();
+    queue.jobs.pop_front();
+    return true;
+}
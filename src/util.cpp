@@ -7,84 +7,117 @@
 
 
 
+#include <bit>
+#include <cstring>
+#include <limits>
+
 #include "../include/util.hpp"
 
 using namespace mxasm;
 
 
 std::string             mxasm::
-get_source_file_path_from_cmd(const std::vector<std::string> &arguments)
+to_lower(const std::string &default_string)
 {
-    if (arguments.size() == 1) {
-        throw arguments_exception("No input file");
-    }
-    if (arguments.size() > 2) {
-        throw arguments_exception("Too many arguments");
-    }
+    std::string res = default_string;
+    std::for_each(res.begin(), res.end(), [](auto &c) { c = std::tolower(c); });
+    return res;
+}
 
-    std::string path_to_file = arguments.at(1);
+std::string             mxasm::
+to_upper(const std::string &default_string)
+{
+    std::string res = default_string;
+    std::for_each(res.begin(), res.end(), [](auto &c) { c = std::toupper(c); });
+    return res;
+}
 
-    if (path_to_file.length() < 5 or path_to_file.substr(path_to_file.length() - 4, 4) != ".asm") {
-        throw arguments_exception("Wrong source code file name or extension: \'" + path_to_file
-                                  + "\'. Should be [name].asm");
+std::size_t             case_insensitive_hash::
+operator()(const std::string_view str) const noexcept
+{
+    // FNV-1a over lower-cased symbols
+    std::size_t hash {14695981039346656037ull};
+    for (const auto c : str) {
+        hash ^= static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(c)));
+        hash *= 1099511628211ull;
     }
-
-    return path_to_file;
+    return hash;
 }
 
-source_listing          mxasm::
-open_source_code(const std::string file_path)
+bool                    case_insensitive_equal::
+operator()(const std::string_view lhs, const std::string_view rhs) const noexcept
 {
-    std::ifstream file_reader(file_path);
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](const char a, const char b) {
+        return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+    });
+}
 
-    if (not file_reader.is_open()) {
-        throw arguments_exception("Can't open source code file \'" + file_path + '\'');
+namespace
+{
+    template<typename T>
+    void append_le(std::string &out, const T value)
+    {
+        for (std::size_t shift = 0; shift < sizeof(T) * 8; shift += 8) {
+            out.push_back(static_cast<char>((value >> shift) & 0xFF));
+        }
     }
 
-    source_listing source_code;
-    std::string    buffer;
-    std::size_t    line_number {0};
+    template<typename T>
+    T read_le(const char *data) noexcept
+    {
+        T value {0};
+        for (std::size_t i = sizeof(T); i-- > 0;) {
+            value = static_cast<T>(value << 8 | static_cast<uint8_t>(data[i]));
+        }
+        return value;
+    }
 
-    while (std::getline(file_reader, buffer)) {
-        ++line_number;
-        if (buffer.empty() or buffer.length() == std::count(buffer.begin(), buffer.end(), ' ')) {
-            continue;
+    // Up to 8 hex digits at once: one load, then the nibbles are merged pair by pair
+    uint64_t hex_to_number(const std::string_view digits) noexcept
+    {
+        if constexpr (std::endian::native != std::endian::little) {
+            uint64_t result {0};
+            for (const char c : digits) result = result << 4 | get_char_digit_value(c);
+            return result;
         }
-        source_code.emplace_back(line_number, buffer);
+
+        char padded[8] {'0', '0', '0', '0', '0', '0', '0', '0'};
+        std::memcpy(padded + 8 - digits.length(), digits.data(), digits.length());
+        uint64_t chunk;
+        std::memcpy(&chunk, padded, sizeof(chunk));
+
+        // '0'-'9' keep their low nibble, letters have bit 6 set and get 9 more
+        chunk = (chunk & 0x0F0F0F0F0F0F0F0Full) + ((chunk >> 6) & 0x0101010101010101ull) * 9;
+        chunk = (chunk << 4 | chunk >> 8)  & 0x00FF00FF00FF00FFull;
+        chunk = (chunk << 8 | chunk >> 16) & 0x0000FFFF0000FFFFull;
+        chunk = (chunk << 16 | chunk >> 32) & 0x00000000FFFFFFFFull;
+        return chunk;
     }
-    file_reader.close();
-    return source_code;
 }
 
 void                    mxasm::
-write_program_to_file(const std::vector<byte_t> &program, const std::string out_name)
-{
-    std::ofstream file_writer(out_name, std::ios_base::binary);
-    if (not file_writer.is_open()) {
-        throw arguments_exception("Can't create program binary file!");
-    }
-    for (const auto byte : program) {
-        file_writer << byte;
-    }
-    file_writer.close();
-}
+append_u16(std::string &out, const uint16_t value)
+{ append_le(out, value); }
 
+void                    mxasm::
+append_u32(std::string &out, const uint32_t value)
+{ append_le(out, value); }
 
-std::string             mxasm::
-to_lower(const std::string &default_string)
-{
-    std::string res = default_string;
-    std::for_each(res.begin(), res.end(), [](auto &c) { c = std::tolower(c); });
-    return res;
-}
+void                    mxasm::
+append_u64(std::string &out, const uint64_t value)
+{ append_le(out, value); }
 
-std::string             mxasm::
-to_upper(const std::string &default_string)
-{
-    std::string res = default_string;
-    std::for_each(res.begin(), res.end(), [](auto &c) { c = std::toupper(c); });
-    return res;
-}
+uint16_t                mxasm::
+read_u16(const char *data) noexcept
+{ return read_le<uint16_t>(data); }
+
+uint32_t                mxasm::
+read_u32(const char *data) noexcept
+{ return read_le<uint32_t>(data); }
+
+uint64_t                mxasm::
+read_u64(const char *data) noexcept
+{ return read_le<uint64_t>(data); }
 
 uint8_t                 mxasm::
 get_char_digit_value(const char c) noexcept
@@ -96,12 +129,34 @@ get_char_digit_value(const char c) noexcept
 }
 
 uint64_t                mxasm::
-string_to_number(const std::string str, const uint8_t base) noexcept
+string_to_number(std::string_view str, const uint8_t base) noexcept
 {
-    uint64_t result {0};
+    constexpr uint64_t TOO_BIG = std::numeric_limits<uint64_t>::max();
+
+    str.remove_prefix(std::min(str.find_first_not_of('0'), str.length()));
+    if (base == 16 and str.length() <= 8) return hex_to_number(str);
 
-    for (std::size_t i = 0; i < str.length(); ++i) {
-        result += get_char_digit_value(str.at(str.length() - 1 - i)) * std::pow(base, i);
+    if (std::has_single_bit(base)) {
+        const auto digit_bits = static_cast<std::size_t>(std::countr_zero(base));
+        // The leading digit may use fewer bits than the others, as in 22 octal digits of 64 bits
+        if (not str.empty()) {
+            const auto leading_bits = static_cast<std::size_t>(std::bit_width(get_char_digit_value(str.front())));
+            if ((str.length() - 1) * digit_bits + leading_bits > 64) return TOO_BIG;
+        }
+
+        uint64_t result {0};
+        for (const char c : str) {
+            result = result << digit_bits | get_char_digit_value(c);
+        }
+        return result;
+    }
+
+    uint64_t result {0};
+    for (const char c : str) {
+        if (__builtin_mul_overflow(result, base, &result)
+            or __builtin_add_overflow(result, get_char_digit_value(c), &result)) {
+            return TOO_BIG;
+        }
     }
     return result;
 }
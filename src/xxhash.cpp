@@ -0,0 +1,99 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |             xxHash            |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <bit>
+#include <cstring>
+
+#include "../include/xxhash.hpp"
+
+using namespace mxasm;
+
+
+namespace
+{
+    constexpr std::uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;
+    constexpr std::uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+    constexpr std::uint64_t PRIME_3 = 0x165667B19E3779F9ULL;
+    constexpr std::uint64_t PRIME_4 = 0x85EBCA77C2B2AE63ULL;
+    constexpr std::uint64_t PRIME_5 = 0x27D4EB2F165667C5ULL;
+
+    template<typename T>
+    T read_le(const char *data) noexcept
+    {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        if constexpr (std::endian::native == std::endian::big) value = std::byteswap(value);
+        return value;
+    }
+
+    std::uint64_t round(std::uint64_t acc, const std::uint64_t input) noexcept
+    {
+        acc += input * PRIME_2;
+        return std::rotl(acc, 31) * PRIME_1;
+    }
+
+    std::uint64_t merge_round(std::uint64_t acc, const std::uint64_t value) noexcept
+    {
+        acc ^= round(0, value);
+        return acc * PRIME_1 + PRIME_4;
+    }
+}
+
+
+std::uint64_t           mxasm::
+xxhash64(const std::string_view data, const std::uint64_t seed) noexcept
+{
+    const char *iter = data.data();
+    const char *end  = iter + data.size();
+    std::uint64_t hash;
+
+    // 32-byte stripes over four independent lanes
+    if (data.size() >= 32) {
+        std::uint64_t v1 = seed + PRIME_1 + PRIME_2;
+        std::uint64_t v2 = seed + PRIME_2;
+        std::uint64_t v3 = seed;
+        std::uint64_t v4 = seed - PRIME_1;
+        const char *last_stripe = end - 32;
+        do {
+            v1 = round(v1, read_le<std::uint64_t>(iter));
+            v2 = round(v2, read_le<std::uint64_t>(iter + 8));
+            v3 = round(v3, read_le<std::uint64_t>(iter + 16));
+            v4 = round(v4, read_le<std::uint64_t>(iter + 24));
+            iter += 32;
+        } while (iter <= last_stripe);
+
+        hash = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+        hash = merge_round(hash, v1);
+        hash = merge_round(hash, v2);
+        hash = merge_round(hash, v3);
+        hash = merge_round(hash, v4);
+    } else {
+        hash = seed + PRIME_5;
+    }
+    hash += data.size();
+
+    for (; end - iter >= 8; iter += 8) {
+        hash ^= round(0, read_le<std::uint64_t>(iter));
+        hash  = std::rotl(hash, 27) * PRIME_1 + PRIME_4;
+    }
+    if (end - iter >= 4) {
+        hash ^= read_le<std::uint32_t>(iter) * PRIME_1;
+        hash  = std::rotl(hash, 23) * PRIME_2 + PRIME_3;
+        iter += 4;
+    }
+    for (; iter != end; ++iter) {
+        hash ^= static_cast<unsigned char>(*iter) * PRIME_5;
+        hash  = std::rotl(hash, 11) * PRIME_1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME_2;
+    hash ^= hash >> 29;
+    hash *= PRIME_3;
+    hash ^= hash >> 32;
+    return hash;
+}
@@ -0,0 +1,81 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |        Assembler Tests        |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <gtest/gtest.h>
+
+#include "../include/assembler.hpp"
+#include "../include/stats.hpp"
+
+using namespace mxasm;
+
+
+TEST(assemble, reads_only_the_view_it_is_given)
+{
+    // Neither view ends in a terminator, what follows them is not valid source
+    const std::string buffer = "NOP\nBRK\n^^^";
+    const auto whole_lines = assemble(std::string_view(buffer).substr(0, 8));
+    ASSERT_EQ(whole_lines.exit_code, EXIT_SUCCESS) << whole_lines.report();
+    EXPECT_EQ(whole_lines.image.bytes({0x0600, 2}), (std::vector<byte_t>{0xEA, 0x00}));
+
+    const auto cut_line = assemble(std::string_view(buffer).substr(0, 7));
+    ASSERT_EQ(cut_line.exit_code, EXIT_SUCCESS) << cut_line.report();
+    EXPECT_EQ(cut_line.image.segments().size(), 1u);
+    EXPECT_EQ(cut_line.image.segments().front().size, 2u);
+}
+
+TEST(assemble, returns_a_clean_result_on_success)
+{
+    const auto result = assemble("LDA #$01\nBRK\n");
+    EXPECT_EQ(result.exit_code, EXIT_SUCCESS);
+    EXPECT_TRUE(result.diagnostics.empty());
+    EXPECT_TRUE(result.assets.empty());
+    EXPECT_TRUE(result.report().empty());
+    EXPECT_TRUE(result.is_reproducible());
+}
+
+TEST(assemble, formats_the_report_only_from_the_diagnostics)
+{
+    const auto result = assemble("NOP\nJMP nowhere\n");
+    ASSERT_EQ(result.exit_code, EXIT_FAILURE);
+    ASSERT_EQ(result.diagnostics.size(), 1u);
+    const auto &error = *result.diagnostics.begin();
+    EXPECT_EQ(result.report(), "ERROR!\n" + error.type() + ": " + result.diagnostics.message(error) + '\n');
+    // A mistake in the source is reproducible, the same text fails the same way
+    EXPECT_TRUE(result.is_reproducible());
+}
+
+TEST(assemble, leaves_the_allocator_of_the_program_alone)
+{
+    // The test program doesn't link the allocation hooks, so no allocation may be counted
+    const auto before = thread_allocations();
+    ASSERT_EQ(assemble("LDA #$01\nBRK\n").exit_code, EXIT_SUCCESS);
+    EXPECT_EQ(thread_allocations().allocations, before.allocations);
+}
+
+
+TEST(result_encoding, keeps_every_segment)
+{
+    const auto result = assemble("LDA #$01\n*=$0900\n.byte $AA, $BB\n*=$FFFE\n.word $1234\n");
+    ASSERT_EQ(result.exit_code, EXIT_SUCCESS) << result.report();
+
+    const auto decoded = decode_result(encode_result(result));
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->exit_code, EXIT_SUCCESS);
+    const auto segments = result.image.segments();
+    ASSERT_EQ(decoded->image.segments().size(), segments.size());
+    for (const auto &range : segments) {
+        EXPECT_EQ(decoded->image.bytes(range), result.image.bytes(range));
+    }
+}
+
+TEST(result_encoding, rejects_a_cut_encoding)
+{
+    const auto encoded = encode_result(assemble("LDA #$01\nJMP nowhere\n"));
+    for (std::size_t size = 0; size < encoded.size(); ++size) {
+        EXPECT_FALSE(decode_result(std::string_view(encoded).substr(0, size)).has_value()) << size;
+    }
+}
@@ -0,0 +1,50 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |        Diagnostic Tests       |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <gtest/gtest.h>
+
+#include "../include/assembler.hpp"
+
+using namespace mxasm;
+
+
+TEST(diagnostic_list, keeps_every_argument_in_one_text)
+{
+    diagnostic_list errors;
+    errors.add(diagnostic_code::LEXER_UNEXPECTED_TOKEN, 3, 7, "$1G");
+    errors.add(diagnostic_code::REGISTER_AFTER_COMMAND, 4, 2);
+    errors.add(diagnostic_code::UNDECLARED_LABEL, 5, 9, "loop");
+
+    ASSERT_EQ(errors.size(), 3u);
+    const auto first = *errors.begin();
+    EXPECT_EQ(errors.argument(first), "$1G");
+    EXPECT_EQ(errors.message(first), "Unexpected token at [3, 7]:\n$1G");
+    EXPECT_EQ(errors.argument(*std::next(errors.begin())), "");
+    EXPECT_EQ(errors.message(*std::next(errors.begin(), 2)), "Error at [5, 9]: Non-existed label call\nloop");
+}
+
+TEST(diagnostic_list, survives_the_result_encoding)
+{
+    const auto result = assemble("LDA $1G\nJMP nowhere\n");
+    ASSERT_EQ(result.exit_code, EXIT_FAILURE);
+    ASSERT_FALSE(result.diagnostics.empty());
+
+    const auto decoded = decode_result(encode_result(result));
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->report(), result.report());
+}
+
+TEST(diagnostic_list, stops_at_max_errors)
+{
+    pipeline_options pipeline;
+    pipeline.max_errors = 2;
+    const auto result = assemble("LDA $1G\nLDA $2G\nLDA $3G\n", pipeline);
+    ASSERT_EQ(result.diagnostics.size(), 3u);
+    const auto last = *std::next(result.diagnostics.begin(), 2);
+    EXPECT_EQ(last.code, diagnostic_code::TOO_MANY_ERRORS);
+    EXPECT_EQ(result.diagnostics.argument(last), "2");
+}
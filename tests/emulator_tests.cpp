@@ -0,0 +1,208 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |         Emulator Tests        |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <gtest/gtest.h>
+
+#include "../include/assembler.hpp"
+#include "../include/emulator.hpp"
+#include "../include/runner.hpp"
+
+#ifndef MXASM_SAMPLES_DIR
+#define MXASM_SAMPLES_DIR "cmake-build-debug"
+#endif
+
+using namespace mxasm;
+using stop_reason = emulator::stop_reason;
+
+
+namespace
+{
+    constexpr byte_t CARRY = 0x01, ZERO = 0x02, OVERFLOW = 0x40, NEGATIVE = 0x80;
+
+    memory_image program(const std::string_view source)
+    {
+        auto result = assemble(source);
+        EXPECT_EQ(result.exit_code, EXIT_SUCCESS) << result.report();
+        return std::move(result.image);
+    }
+
+    // Registers once the program stopped
+    emulator run_to_end(const std::string_view source)
+    {
+        emulator cpu(program(source), 1);
+        EXPECT_EQ(cpu.run(100'000), stop_reason::BREAK);
+        return cpu;
+    }
+
+    // Cycles of every command up to the end of the program
+    std::vector<std::size_t> step_cycles(const std::string_view source)
+    {
+        emulator cpu(program(source), 1);
+        std::vector<std::size_t> cycles;
+        while (cpu.stopped() == stop_reason::RUNNING and cycles.size() < 1000) {
+            cycles.push_back(cpu.step());
+        }
+        return cycles;
+    }
+
+    byte_t flags(const emulator &cpu, const byte_t mask)
+    { return cpu.state().p & mask; }
+}
+
+
+TEST(emulator, adc_sets_carry_overflow_and_zero)
+{
+    auto cpu = run_to_end("CLC\nLDA #$50\nADC #$50\nBRK\n");
+    EXPECT_EQ(cpu.state().a, 0xA0);
+    EXPECT_EQ(flags(cpu, CARRY | ZERO | OVERFLOW | NEGATIVE), OVERFLOW | NEGATIVE);
+
+    cpu = run_to_end("CLC\nLDA #$FF\nADC #$01\nBRK\n");
+    EXPECT_EQ(cpu.state().a, 0x00);
+    EXPECT_EQ(flags(cpu, CARRY | ZERO | OVERFLOW | NEGATIVE), CARRY | ZERO);
+
+    cpu = run_to_end("SEC\nLDA #$10\nADC #$20\nBRK\n");
+    EXPECT_EQ(cpu.state().a, 0x31);
+}
+
+TEST(emulator, sbc_borrows_through_carry)
+{
+    auto cpu = run_to_end("SEC\nLDA #$50\nSBC #$F0\nBRK\n");
+    EXPECT_EQ(cpu.state().a, 0x60);
+    EXPECT_EQ(flags(cpu, CARRY | OVERFLOW), 0);
+
+    cpu = run_to_end("SEC\nLDA #$D0\nSBC #$70\nBRK\n");
+    EXPECT_EQ(cpu.state().a, 0x60);
+    EXPECT_EQ(flags(cpu, CARRY | OVERFLOW), CARRY | OVERFLOW);
+
+    cpu = run_to_end("CLC\nLDA #$05\nSBC #$05\nBRK\n");
+    EXPECT_EQ(cpu.state().a, 0xFF);
+    EXPECT_EQ(flags(cpu, CARRY | NEGATIVE), NEGATIVE);
+}
+
+TEST(emulator, decimal_mode_adds_and_subtracts_bcd)
+{
+    auto cpu = run_to_end("SED\nSEC\nLDA #$58\nADC #$46\nBRK\n");
+    EXPECT_EQ(cpu.state().a, 0x05);
+    EXPECT_EQ(flags(cpu, CARRY), CARRY);
+
+    cpu = run_to_end("SED\nCLC\nLDA #$99\nADC #$01\nBRK\n");
+    EXPECT_EQ(cpu.state().a, 0x00);
+    EXPECT_EQ(flags(cpu, CARRY | ZERO), CARRY | ZERO);      // Z is valid in decimal mode on the 65C02
+
+    cpu = run_to_end("SED\nSEC\nLDA #$40\nSBC #$13\nBRK\n");
+    EXPECT_EQ(cpu.state().a, 0x27);
+    EXPECT_EQ(flags(cpu, CARRY), CARRY);
+
+    cpu = run_to_end("SED\nSEC\nLDA #$00\nSBC #$01\nBRK\n");
+    EXPECT_EQ(cpu.state().a, 0x99);
+    EXPECT_EQ(flags(cpu, CARRY | NEGATIVE), NEGATIVE);
+}
+
+TEST(emulator, decimal_mode_costs_a_cycle)
+{
+    const auto binary  = step_cycles("CLC\nADC #$01\nSBC #$01\nBRK\n");
+    const auto decimal = step_cycles("SED\nADC #$01\nSBC #$01\nBRK\n");
+    ASSERT_EQ(binary.size(), 4u);
+    ASSERT_EQ(decimal.size(), 4u);
+    EXPECT_EQ(binary[1], 2u);
+    EXPECT_EQ(binary[2], 2u);
+    EXPECT_EQ(decimal[1], 3u);
+    EXPECT_EQ(decimal[2], 3u);
+}
+
+TEST(emulator, branches_pay_for_taken_and_page_crossed)
+{
+    const auto cycles = step_cycles(
+        "LDX #$00\n"
+        "BNE never\n"           // Not taken
+        "BEQ same\n"            // Taken on the same page
+        "never:\n"
+        "BRK\n"
+        "same:\n"
+        "JMP far\n"
+        "*=$06FA\n"
+        "far:\n"
+        "BEQ over\n"            // Taken from $06FC to $0702
+        "*=$0702\n"
+        "over:\n"
+        "BRA next\n"            // BRA pays for the page only
+        "next:\n"
+        "JMP page_end\n"
+        "*=$07FC\n"
+        "page_end:\n"
+        "BRA cross\n"           // From $07FE to $0800
+        "*=$0800\n"
+        "cross:\n"
+        "BRK\n");
+    const std::vector<std::size_t> expected {2, 2, 3, 3, 4, 3, 3, 4, 7};
+    EXPECT_EQ(cycles, expected);
+}
+
+TEST(emulator, stack_wraps_inside_page_one)
+{
+    auto cpu = run_to_end("LDX #$00\nTXS\nLDA #$42\nPHA\nBRK\n");
+    EXPECT_EQ(cpu.state().sp, 0xFF);
+    EXPECT_EQ(cpu.peek(0x0100), 0x42);
+
+    cpu = run_to_end("LDX #$00\nTXS\nLDA #$42\nPHA\nLDA #$00\nPLA\nBRK\n");
+    EXPECT_EQ(cpu.state().sp, 0x00);
+    EXPECT_EQ(cpu.state().a, 0x42);
+
+    cpu = run_to_end("LDX #$FF\nTXS\nLDA #$99\nSTA $0100\nPLA\nBRK\n");
+    EXPECT_EQ(cpu.state().sp, 0x00);        // From $FF up to $00, reading $0100
+    EXPECT_EQ(cpu.state().a, 0x99);
+}
+
+TEST(emulator, jsr_and_rts_return_behind_the_call)
+{
+    const auto cpu = run_to_end("JSR sub\nLDY #$07\nBRK\nsub:\nLDX #$05\nRTS\n");
+    EXPECT_EQ(cpu.state().x, 0x05);
+    EXPECT_EQ(cpu.state().y, 0x07);
+    EXPECT_EQ(cpu.state().sp, 0xFF);
+}
+
+TEST(emulator, snake_sample_ends_in_a_known_state)
+{
+    const auto result = assemble_file(MXASM_SAMPLES_DIR "/s_snake.asm", pipeline_options{});
+    ASSERT_EQ(result.exit_code, EXIT_SUCCESS) << result.report();
+
+    // Without keys the snake runs into the wall, the same way for every seed
+    emulator cpu(result.image, 1);
+    EXPECT_EQ(cpu.run(1'000'000), stop_reason::BREAK);
+    EXPECT_EQ(cpu.cycles(), 36'246u);
+    EXPECT_EQ(cpu.state().pc, 0x0736);
+    EXPECT_EQ(cpu.state().a, 0x1F);
+    EXPECT_EQ(cpu.state().x, 0xFF);
+    EXPECT_EQ(cpu.state().sp, 0xFB);
+}
+
+TEST(runner, prints_the_end_state)
+{
+    run_options options;
+    options.clock_hz = 0;
+    options.seed     = 1;
+
+    testing::internal::CaptureStdout();
+    const int exit_code = run_program(program("LDA #$2A\nTAX\nBRK\n"), options);
+    const auto output = testing::internal::GetCapturedStdout();
+    EXPECT_EQ(exit_code, EXIT_SUCCESS);
+    EXPECT_EQ(output, "Stopped by BRK at $0603 after 11 cycles\n"
+                      "A=$2A X=$2A Y=$00 SP=$FF P=$30 PC=$0604\n");
+}
+
+TEST(runner, fails_at_the_cycle_limit)
+{
+    run_options options;
+    options.clock_hz   = 0;
+    options.max_cycles = 100;
+
+    testing::internal::CaptureStdout();
+    const int exit_code = run_program(program("loop:\nJMP loop\n"), options);
+    const auto output = testing::internal::GetCapturedStdout();
+    EXPECT_EQ(exit_code, EXIT_FAILURE);
+    EXPECT_TRUE(output.starts_with("Stopped by cycle limit after 102 cycles\n")) << output;
+}
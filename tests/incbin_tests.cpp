@@ -0,0 +1,122 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |          Incbin Tests         |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <gtest/gtest.h>
+
+#include "../include/assembler.hpp"
+#include "test_support.hpp"
+
+using namespace mxasm;
+
+
+namespace
+{
+    constexpr std::string_view ASSET = "\x01\x02\x03\x04\x05";
+
+    std::vector<byte_t> image_bytes(const memory_image &image, const word_t address, const std::size_t size)
+    { return image.bytes({address, size}); }
+}
+
+
+TEST(incbin, reads_the_file_next_to_the_source)
+{
+    const test::temporary_directory directory;
+    directory.write("data.bin", ASSET);
+    const auto source = directory.write("main.asm", ".incbin \"data.bin\"\n");
+
+    const auto result = assemble_file(source, pipeline_options{});
+    ASSERT_EQ(result.exit_code, EXIT_SUCCESS) << result.report();
+    EXPECT_EQ(image_bytes(result.image, 0x0600, 5), (std::vector<byte_t>{1, 2, 3, 4, 5}));
+    ASSERT_EQ(result.assets.size(), 1u);
+}
+
+TEST(incbin, takes_an_offset_and_a_length)
+{
+    const test::temporary_directory directory;
+    directory.write("data.bin", ASSET);
+    const auto source = directory.write("main.asm", ".incbin \"data.bin\", 1, 3\n");
+
+    const auto result = assemble_file(source, pipeline_options{});
+    ASSERT_EQ(result.exit_code, EXIT_SUCCESS) << result.report();
+    EXPECT_EQ(image_bytes(result.image, 0x0600, 3), (std::vector<byte_t>{2, 3, 4}));
+    EXPECT_FALSE(result.image.is_written(0x0603));
+}
+
+TEST(incbin, places_the_bytes_at_the_current_origin)
+{
+    const test::temporary_directory directory;
+    directory.write("data.bin", ASSET);
+    const auto source = directory.write("main.asm", "BRK\n*=$1234\n.incbin \"data.bin\"\nNOP\n");
+
+    const auto result = assemble_file(source, pipeline_options{});
+    ASSERT_EQ(result.exit_code, EXIT_SUCCESS) << result.report();
+    EXPECT_EQ(result.image.read(0x0600), 0x00);
+    EXPECT_EQ(image_bytes(result.image, 0x1234, 5), (std::vector<byte_t>{1, 2, 3, 4, 5}));
+    EXPECT_EQ(result.image.read(0x1239), 0xEA);        // NOP right behind the asset
+    EXPECT_FALSE(result.image.is_written(0x0601));
+}
+
+TEST(incbin, reports_a_missing_file)
+{
+    const test::temporary_directory directory;
+    const auto source = directory.write("main.asm", "NOP\n.incbin \"missing.bin\"\n");
+
+    const auto result = assemble_file(source, pipeline_options{});
+    ASSERT_EQ(result.exit_code, EXIT_FAILURE);
+    ASSERT_EQ(result.diagnostics.size(), 1u);
+    const auto error = *result.diagnostics.begin();
+    EXPECT_EQ(error.code, diagnostic_code::FILE_UNREADABLE);
+    EXPECT_EQ(error.row, 2u);
+    EXPECT_EQ(result.diagnostics.argument(error), "'missing.bin'");
+}
+
+TEST(incbin, reports_a_range_out_of_the_file)
+{
+    const test::temporary_directory directory;
+    directory.write("data.bin", ASSET);
+    const auto source = directory.write("main.asm", ".incbin \"data.bin\", 4, 2\n");
+
+    const auto result = assemble_file(source, pipeline_options{});
+    ASSERT_EQ(result.exit_code, EXIT_FAILURE);
+    EXPECT_EQ(result.diagnostics.begin()->code, diagnostic_code::FILE_RANGE_INVALID);
+}
+
+TEST(incbin, is_an_error_in_memory_without_an_asset_directory)
+{
+    // Relative to the working directory, where a file of the same name is
+    const test::temporary_directory directory;
+    directory.write("data.bin", ASSET);
+    const auto previous = std::filesystem::current_path();
+    std::filesystem::current_path(directory.path());
+    const auto result = assemble(".incbin \"data.bin\"\n");
+    std::filesystem::current_path(previous);
+
+    ASSERT_EQ(result.exit_code, EXIT_FAILURE);
+    ASSERT_EQ(result.diagnostics.size(), 1u);
+    EXPECT_EQ(result.diagnostics.begin()->code, diagnostic_code::FILE_NOT_ALLOWED);
+    EXPECT_TRUE(result.assets.empty());
+}
+
+TEST(incbin, reads_files_in_memory_from_the_asset_directory)
+{
+    const test::temporary_directory directory;
+    directory.write("data.bin", ASSET);
+    pipeline_options pipeline;
+    pipeline.asset_directory = directory.path().string();
+
+    const auto result = assemble(".incbin \"data.bin\", 3\n", pipeline);
+    ASSERT_EQ(result.exit_code, EXIT_SUCCESS) << result.report();
+    EXPECT_EQ(image_bytes(result.image, 0x0600, 2), (std::vector<byte_t>{4, 5}));
+}
+
+TEST(directive, define_behind_a_label_is_an_error)
+{
+    const auto result = assemble("start: .define X $10\nBRK\n");
+    ASSERT_EQ(result.exit_code, EXIT_FAILURE);
+    EXPECT_EQ(result.diagnostics.begin()->code, diagnostic_code::UNEXPECTED_TOKEN);
+    EXPECT_EQ(result.diagnostics.argument(*result.diagnostics.begin()), ".define");
+}
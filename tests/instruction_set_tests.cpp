@@ -0,0 +1,81 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |     Instruction Set Tests     |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "../include/instruction_set.hpp"
+#include "../include/assembler.hpp"
+
+using namespace mxasm;
+using st_mode = serializable_token::st_mode;
+
+
+namespace
+{
+    // Operand written the way the mode is, and its bytes. The branches go back to their own row at $0600
+    std::pair<std::string, std::vector<byte_t>> operand_of(const st_mode mode)
+    {
+        switch (mode) {
+            case st_mode::IMP:
+            case st_mode::STK: return {"",            {}};
+            case st_mode::ACC: return {"A",           {}};
+            case st_mode::IMM: return {"#$12",        {0x12}};
+            case st_mode::ZPG: return {"$12",         {0x12}};
+            case st_mode::ZPX: return {"$12,X",       {0x12}};
+            case st_mode::ZPY: return {"$12,Y",       {0x12}};
+            case st_mode::ZPR: return {"$12,here",    {0x12, 0xFD}};
+            case st_mode::IZP: return {"($12)",       {0x12}};
+            case st_mode::IZX: return {"($12,X)",     {0x12}};
+            case st_mode::IZY: return {"($12),Y",     {0x12}};
+            case st_mode::ABS: return {"$1234",       {0x34, 0x12}};
+            case st_mode::ABX: return {"$1234,X",     {0x34, 0x12}};
+            case st_mode::ABY: return {"$1234,Y",     {0x34, 0x12}};
+            case st_mode::IND: return {"($1234)",     {0x34, 0x12}};
+            case st_mode::IAX: return {"($1234,X)",   {0x34, 0x12}};
+            case st_mode::REL: return {"here",        {0xFE}};
+        }
+        return {};
+    }
+}
+
+
+TEST(instruction_set, holds_every_opcode_once)
+{
+    std::set<byte_t> commands;
+    for (const auto &in : instruction_set) {
+        EXPECT_TRUE(commands.insert(static_cast<byte_t>(in.command)).second) << static_cast<int>(in.command);
+    }
+    EXPECT_EQ(commands.size(), 212u);
+}
+
+TEST(instruction_set, looks_up_every_row_both_ways)
+{
+    for (const auto &in : instruction_set) {
+        EXPECT_EQ(instruction_encodings.find(in.mnemonic, command_adr_mode(in.mode)), &in)
+            << parser_token::pt_opcode_to_string(in.mnemonic);
+        EXPECT_EQ(command_mode(in.command), in.mode) << static_cast<int>(in.command);
+        EXPECT_EQ(operand_of(in.mode).second.size(), operand_size(in.mode));
+    }
+    EXPECT_EQ(instruction_encodings.find(parser_token::pt_opcode::LDX, parser_token::adr_mode::ABS_X), nullptr);
+    EXPECT_EQ(instruction_encodings.find(parser_token::pt_opcode::REGISTER_A, parser_token::adr_mode::A), nullptr);
+}
+
+TEST(instruction_set, assembles_every_row)
+{
+    for (const auto &in : instruction_set) {
+        const auto [operand, operand_bytes] = operand_of(in.mode);
+        const auto text = "here: " + parser_token::pt_opcode_to_string(in.mnemonic) + ' ' + operand + '\n';
+
+        const auto result = assemble(text);
+        ASSERT_EQ(result.exit_code, EXIT_SUCCESS) << text << result.report();
+        std::vector<byte_t> expected {static_cast<byte_t>(in.command)};
+        expected.insert(expected.end(), operand_bytes.begin(), operand_bytes.end());
+        EXPECT_EQ(result.image.bytes({0x0600, expected.size()}), expected) << text;
+    }
+}
@@ -0,0 +1,126 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |          Lexer Tests          |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <gtest/gtest.h>
+
+#include "../include/lexer.hpp"
+#include "../include/source_file.hpp"
+
+using namespace mxasm;
+
+
+namespace
+{
+    // "KIND lexeme" of every token
+    std::vector<std::string> lexed(const std::string_view text)
+    {
+        const auto source = source_file::from_view(text);
+        lexer tokenizer(source.lines());
+        std::vector<std::string> tokens;
+        for (const auto &token : tokenizer.tokens()) {
+            tokens.push_back(lexer_token::lt_kind_to_string(token.kind()) + ' ' + std::string(token.lexeme()));
+        }
+        return tokens;
+    }
+
+    // The diagnostics thrown for the text, empty when there are none
+    diagnostic_list lexer_errors(const std::string_view text)
+    {
+        const auto source = source_file::from_view(text);
+        lexer tokenizer(source.lines());
+        try {
+            tokenizer.tokens();
+        } catch (diagnostic_list &errors) {
+            return std::move(errors);
+        }
+        return {};
+    }
+}
+
+
+TEST(lexer, points_lexemes_into_the_source)
+{
+    const std::string text = "loop: LDA ($10),Y ; next\n  .byte \"hi\"\n";
+    const auto source = source_file::from_view(text);
+    lexer tokenizer(source.lines());
+    const auto &tokens = tokenizer.tokens();
+
+    ASSERT_FALSE(tokens.empty());
+    for (const auto &token : tokens) {
+        EXPECT_GE(token.lexeme().data(), text.data());
+        EXPECT_LE(token.lexeme().data() + token.lexeme().size(), text.data() + text.size());
+        EXPECT_EQ(text.substr(token.lexeme().data() - text.data(), token.lexeme().size()), token.lexeme());
+    }
+}
+
+TEST(lexer, splits_a_line_into_tokens)
+{
+    EXPECT_EQ(lexed("loop: LDA ($10),Y ; next\n"), (std::vector<std::string>{
+        "LABEL DECLARATION loop:", "IDENTIFIER LDA", "LEFT PARENTHESIS (", "HEXADECIMAL CONSTANT $10",
+        "RIGHT PARENTHESIS )", "COMMA ,", "IDENTIFIER Y", "COMMENT ; next"}));
+    EXPECT_EQ(lexed(".byte \"hi\", <label, >label\n*=$0600\n"), (std::vector<std::string>{
+        "DIRECTIVE .byte", "STRING \"hi\"", "COMMA ,", "LESS <", "IDENTIFIER label", "COMMA ,",
+        "GREATER >", "IDENTIFIER label", "ASTERISK *", "EQUALS =", "HEXADECIMAL CONSTANT $0600"}));
+}
+
+TEST(lexer, numbers_tokens_by_row_and_column)
+{
+    const std::string text = "NOP\n\n  LDA #1\n";
+    const auto source = source_file::from_view(text);
+    lexer tokenizer(source.lines());
+    const auto &tokens = tokenizer.tokens();
+
+    ASSERT_EQ(tokens.size(), 4u);
+    EXPECT_EQ(tokens[0].row(), 1u);
+    EXPECT_EQ(tokens[1].row(), 3u);
+    EXPECT_EQ(tokens[1].column(), 3u);
+    EXPECT_EQ(tokens[2].column(), 7u);
+    EXPECT_EQ(tokens[3].lexeme(), "1");
+}
+
+TEST(lexer, reports_unexpected_symbols_with_their_position)
+{
+    const auto errors = lexer_errors("NOP\nLDA ^\n");
+    ASSERT_EQ(errors.size(), 1u);
+    const auto &error = *errors.begin();
+    EXPECT_EQ(error.code, diagnostic_code::LEXER_UNEXPECTED_TOKEN);
+    EXPECT_EQ(error.row, 2u);
+    EXPECT_EQ(errors.argument(error), "^");
+}
+
+TEST(lexer, stops_after_max_errors)
+{
+    const auto source = source_file::from_view("^\n^\n^\n^\n");
+    lexer tokenizer(source.lines(), 2);
+    try {
+        tokenizer.tokens();
+        FAIL() << "no diagnostics were thrown";
+    } catch (diagnostic_list &errors) {
+        ASSERT_EQ(errors.size(), 3u);
+        EXPECT_EQ(std::prev(errors.end())->code, diagnostic_code::TOO_MANY_ERRORS);
+    }
+}
+
+TEST(lexer, tells_numbers_by_their_start_symbol)
+{
+    EXPECT_EQ(lexed("$1F %101 017 0 255\n"), (std::vector<std::string>{
+        "HEXADECIMAL CONSTANT $1F", "BINARY CONSTANT %101", "OCTAL CONSTANT 017",
+        "OCTAL CONSTANT 0", "DECIMAL CONSTANT 255"}));
+    EXPECT_EQ(lexed("$ab,%0)\n"), (std::vector<std::string>{
+        "HEXADECIMAL CONSTANT $ab", "COMMA ,", "BINARY CONSTANT %0", "RIGHT PARENTHESIS )"}));
+}
+
+TEST(lexer, rejects_malformed_numbers)
+{
+    // A prefix alone, and digits the base doesn't have
+    for (const std::string_view text : {"$\n", "% \n", "$1G\n", "%102\n", "018\n", "12A\n"}) {
+        const auto errors = lexer_errors(text);
+        ASSERT_EQ(errors.size(), 1u) << text;
+        EXPECT_EQ(errors.begin()->code, diagnostic_code::LEXER_UNEXPECTED_TOKEN) << text;
+        EXPECT_EQ(errors.begin()->column, 1u) << text;
+    }
+}
@@ -0,0 +1,109 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |         Listing Tests         |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <fstream>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "../include/assembler.hpp"
+#include "test_support.hpp"
+
+using namespace mxasm;
+
+
+namespace
+{
+    // Assembles the source next to its listing and returns the listing
+    std::string listing_of(const std::string_view source)
+    {
+        const test::temporary_directory directory;
+        const auto path = directory.write("main.asm", source);
+        write_options output;
+        output.listing = true;
+        const auto result = assemble_file(path, pipeline_options{}, output);
+        EXPECT_EQ(result.exit_code, EXIT_SUCCESS) << result.report();
+
+        std::ifstream listing(directory.path() / "main.lst");
+        std::stringstream text;
+        text << listing.rdbuf();
+        return text.str();
+    }
+}
+
+
+TEST(listing, annotates_penalties_and_loops)
+{
+    const auto listing = listing_of(
+        "start:\n"
+        "    LDX #$00\n"
+        "    LDA $0280,X\n"
+        "    SED\n"
+        "    ADC #$01\n"
+        "    CLD\n"
+        "    JMP loop\n"
+        "*=$06F8\n"
+        "loop:\n"
+        "    DEX\n"
+        "    BNE loop\n"
+        "    BEQ far\n"
+        "    BRK\n"
+        "*=$0704\n"
+        "far:\n"
+        "    BRA done\n"
+        "done:\n"
+        "    BRK\n"
+        "*=$07FC\n"
+        "    BRA over\n"
+        "*=$0800\n"
+        "over:\n"
+        "    .byte 1, 2, 3, 4, 5, 6, 7, 8, 9, 10\n");
+
+    EXPECT_EQ(listing,
+              "Addr  Bytes                   Cycles    Row  Source\n"
+              "0600                                      1  start:\n"
+              "0600  A2 00                   2           2      LDX #$00\n"
+              "0602  BD 80 02                4-5         3      LDA $0280,X\n"        // Page crossed by X
+              "0605  F8                      2           4      SED\n"
+              "0606  69 01                   2-3         5      ADC #$01\n"           // Decimal mode
+              "0608  D8                      2           6      CLD\n"
+              "0609  4C F8 06                3           7      JMP loop\n"
+              "                                          8  *=$06F8\n"
+              "06F8                                      9  loop:\n"
+              "06F8  CA                      2          10      DEX\n"
+              "06F9  D0 FD                   2-3        11      BNE loop\n"           // Taken on the page
+              "06FB  F0 07                   2-4        12      BEQ far\n"            // Taken to the next page
+              "06FD  00                      7          13      BRK\n"
+              "                                         14  *=$0704\n"
+              "0704                                     15  far:\n"
+              "0704  80 00                   3          16      BRA done\n"
+              "0706                                     17  done:\n"
+              "0706  00                      7          18      BRK\n"
+              "                                         19  *=$07FC\n"
+              "07FC  80 02                   4          20      BRA over\n"           // Always across the page
+              "                                         21  *=$0800\n"
+              "0800                                     22  over:\n"
+              "0800  01 02 03 04 05 06 07 08            23      .byte 1, 2, 3, 4, 5, 6, 7, 8, 9, 10\n"
+              "0808  09 0A \n"
+              "\n"
+              "Loops, cycles of one pass with the closing branch taken. Inner loops count once, calls as their JSR\n"
+              "06F8-06FA  5        loop\n");
+}
+
+TEST(listing, counts_calls_as_their_jsr_in_loops)
+{
+    const auto listing = listing_of(
+        "    LDY #$04\n"
+        "again:\n"
+        "    JSR work\n"
+        "    DEY\n"
+        "    BNE again\n"
+        "    BRK\n"
+        "work:\n"
+        "    RTS\n");
+    EXPECT_NE(listing.find("\n0602-0607  11       again\n"), std::string::npos) << listing;
+}
@@ -0,0 +1,105 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |       Memory Image Tests      |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "../include/memory_image.hpp"
+
+using namespace mxasm;
+using segment = memory_image::segment;
+
+
+namespace
+{
+    std::vector<std::pair<word_t, std::size_t>> runs(const memory_image &image)
+    {
+        std::vector<std::pair<word_t, std::size_t>> result;
+        for (const auto &range : image.segments()) result.emplace_back(range.address, range.size);
+        return result;
+    }
+}
+
+
+TEST(memory_image, starts_empty)
+{
+    const memory_image image;
+    EXPECT_TRUE(image.empty());
+    EXPECT_TRUE(image.segments().empty());
+    EXPECT_EQ(image.read(0x1234), 0x00);
+    EXPECT_FALSE(image.is_written(0x1234));
+}
+
+TEST(memory_image, keeps_sparse_bytes_apart)
+{
+    memory_image image;
+    image.write(0x0010, 0xAA);
+    image.write(0x0012, 0xBB);
+    image.write(0xC000, 0xCC);
+
+    EXPECT_FALSE(image.empty());
+    EXPECT_EQ(runs(image), (std::vector<std::pair<word_t, std::size_t>>{{0x0010, 1}, {0x0012, 1}, {0xC000, 1}}));
+    EXPECT_TRUE(image.is_written(0x0012));
+    EXPECT_FALSE(image.is_written(0x0011));
+    // A zero that was written still counts as written
+    image.write(0x0011, 0x00);
+    EXPECT_EQ(runs(image).front(), (std::pair<word_t, std::size_t>{0x0010, 3}));
+}
+
+TEST(memory_image, joins_a_run_across_pages)
+{
+    std::vector<byte_t> values(0x300);
+    for (std::size_t i = 0; i < values.size(); ++i) values[i] = static_cast<byte_t>(i * 7);
+    memory_image image;
+    image.write(0x06F0, values);
+
+    EXPECT_EQ(runs(image), (std::vector<std::pair<word_t, std::size_t>>{{0x06F0, 0x300}}));
+    EXPECT_EQ(image.bytes({0x06F0, 0x300}), values);
+    // One view per page the run touches
+    const auto chunks = image.chunks({0x06F0, 0x300});
+    ASSERT_EQ(chunks.size(), 4u);
+    EXPECT_EQ(chunks.front().size(), 0x10u);
+    EXPECT_EQ(chunks.back().size(), 0xF0u);
+}
+
+TEST(memory_image, wraps_at_the_end_of_the_address_space)
+{
+    memory_image image;
+    const std::vector<byte_t> values {0x01, 0x02, 0x03, 0x04};
+    image.write(0xFFFE, values);
+
+    EXPECT_EQ(runs(image), (std::vector<std::pair<word_t, std::size_t>>{{0x0000, 2}, {0xFFFE, 2}}));
+    EXPECT_EQ(image.read(0xFFFF), 0x02);
+    EXPECT_EQ(image.read(0x0000), 0x03);
+    EXPECT_EQ(image.read(0x0001), 0x04);
+}
+
+TEST(memory_image, reads_gaps_as_zero)
+{
+    memory_image image;
+    image.write(0x0600, 0x11);
+    image.write(0x0900, 0x22);
+    const auto bytes = image.bytes({0x0600, 0x301});
+    EXPECT_EQ(bytes.front(), 0x11);
+    EXPECT_EQ(bytes.back(), 0x22);
+    EXPECT_EQ(std::count(bytes.begin(), bytes.end(), 0x00), 0x2FF);
+}
+
+TEST(memory_image, copies_its_pages)
+{
+    memory_image image;
+    image.write(0x0200, 0x42);
+    memory_image copy(image);
+    image.write(0x0200, 0x43);
+    EXPECT_EQ(copy.read(0x0200), 0x42);
+
+    copy = image;
+    EXPECT_EQ(copy.read(0x0200), 0x43);
+    const memory_image moved(std::move(copy));
+    EXPECT_EQ(moved.read(0x0200), 0x43);
+}
@@ -0,0 +1,112 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |         Options Tests         |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <gtest/gtest.h>
+
+#include "../include/options.hpp"
+#include "../include/assembly_cache.hpp"
+#include "../include/exceptions/arguments_exception.hpp"
+#include "test_support.hpp"
+
+using namespace mxasm;
+
+
+namespace
+{
+    assembler_options options_from(std::vector<std::string> arguments)
+    {
+        arguments.insert(arguments.begin(), "mxasm");
+        return get_options_from_cmd(arguments);
+    }
+}
+
+
+TEST(assembly_fingerprint, names_the_pipeline_revision)
+{
+    const auto fingerprint = assembly_fingerprint(options_from({"a.asm"}));
+    EXPECT_NE(fingerprint.find("pipeline=" + std::to_string(PIPELINE_REVISION)), std::string::npos);
+}
+
+TEST(assembly_fingerprint, changes_with_every_output_option)
+{
+    const auto plain = assembly_fingerprint(options_from({"a.asm"}));
+    EXPECT_EQ(plain, assembly_fingerprint(options_from({"a.asm", "--jobs=3", "--atomic"})));
+    EXPECT_NE(plain, assembly_fingerprint(options_from({"a.asm", "--max-errors=5"})));
+    EXPECT_NE(plain, assembly_fingerprint(options_from({"a.asm", "--no-zero-page"})));
+    EXPECT_NE(plain, assembly_fingerprint(options_from({"a.asm", "--no-relax"})));
+    EXPECT_EQ(plain, assembly_fingerprint(options_from({"a.asm", "--relax"})));
+    EXPECT_NE(plain, assembly_fingerprint(options_from({"a.asm", "--shrink-jumps"})));
+}
+
+TEST(get_options_from_cmd, rejects_encoding_options_for_a_client)
+{
+    for (const std::string option : {"--no-zero-page", "--relax", "--no-relax", "--shrink-jumps"}) {
+        EXPECT_THROW(options_from({"--connect", option, "a.asm"}), arguments_exception) << option;
+        EXPECT_THROW(options_from({option, "--connect=/tmp/mxasm.sock", "a.asm"}), arguments_exception) << option;
+        EXPECT_NO_THROW(options_from({"--server", option})) << option;
+    }
+}
+
+TEST(get_options_from_cmd, rejects_options_a_client_would_ignore)
+{
+    EXPECT_THROW(options_from({"--connect", "--max-errors=5", "a.asm"}), arguments_exception);
+    EXPECT_NO_THROW(options_from({"--server", "--max-errors=5"}));
+    for (const std::string option : {"--cache", "--cache=/tmp/c", "--cache-size=1M", "--cache-stats",
+                                     "--stats", "--stats=json", "--listing"}) {
+        EXPECT_THROW(options_from({"--connect", option, "a.asm"}), arguments_exception) << option;
+        EXPECT_THROW(options_from({"--server", option}), arguments_exception) << option;
+        EXPECT_THROW(options_from({"run", option, "a.asm"}), arguments_exception) << option;
+        EXPECT_NO_THROW(options_from({option, "a.asm"})) << option;
+    }
+}
+
+TEST(assembly_cache, misses_once_an_option_changes)
+{
+    const test::temporary_directory directory;
+    const std::string source = "LDA #$01\nBRK\n";
+    const auto result = assemble(source);
+    ASSERT_EQ(result.exit_code, EXIT_SUCCESS);
+
+    assembly_cache before(directory.path(), 1u << 20, assembly_fingerprint(options_from({"a.asm"})));
+    before.store(before.key(source), source, result);
+    ASSERT_TRUE(before.find(before.key(source), source).has_value());
+
+    assembly_cache after(directory.path(), 1u << 20, assembly_fingerprint(options_from({"a.asm", "--max-errors=5"})));
+    EXPECT_FALSE(after.find(after.key(source), source).has_value());
+    EXPECT_EQ(after.stats().misses, 1u);
+}
+
+TEST(assembly_cache, keeps_no_failure_from_outside_the_assembler)
+{
+    const test::temporary_directory directory;
+    const std::string source = "LDA #$01\nBRK\n";
+    assembly_cache cache(directory.path(), 1u << 20, assembly_fingerprint(options_from({"a.asm"})));
+
+    const assembly_result failed {EXIT_FAILURE, {diagnostic_code::SYSTEM_ERROR, "std::bad_alloc"}, {}};
+    cache.store(cache.key(source), source, failed);
+    EXPECT_FALSE(cache.find(cache.key(source), source).has_value());
+
+    // A diagnostic of the source itself is as good as a binary
+    const std::string wrong = "LDA\n";
+    cache.store(cache.key(wrong), wrong, assemble(wrong));
+    const auto cached = cache.find(cache.key(wrong), wrong);
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_EQ(cached->exit_code, EXIT_FAILURE);
+}
+
+TEST(assembly_cache, misses_on_a_colliding_key)
+{
+    const test::temporary_directory directory;
+    const std::string source = "LDA #$01\nBRK\n";
+    assembly_cache cache(directory.path(), 1u << 20, assembly_fingerprint(options_from({"a.asm"})));
+    cache.store(cache.key(source), source, assemble(source));
+
+    // Another source under the same key, of the same length and of another one
+    EXPECT_FALSE(cache.find(cache.key(source), "LDA #$02\nBRK\n").has_value());
+    EXPECT_FALSE(cache.find(cache.key(source), "NOP\n").has_value());
+    EXPECT_TRUE(cache.find(cache.key(source), source).has_value());
+}
@@ -0,0 +1,128 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |          Parser Tests         |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <gtest/gtest.h>
+
+#include "../include/lexer.hpp"
+#include "../include/parser.hpp"
+#include "../include/assembler.hpp"
+
+using namespace mxasm;
+using st_kind    = serializable_token::st_kind;
+using st_command = serializable_token::st_command;
+
+
+namespace
+{
+    std::vector<serializable_token> parsed(const std::string_view text)
+    {
+        const auto source = source_file::from_view(text);
+        lexer tokenizer(source.lines());
+        parser token_parser(tokenizer.tokens());
+        return token_parser.tokens();
+    }
+
+    std::vector<byte_t> assembled(const std::string_view source)
+    {
+        const auto result = assemble(source);
+        EXPECT_EQ(result.exit_code, EXIT_SUCCESS) << result.report();
+        return result.image.bytes({0x0600, 0x10});
+    }
+
+    // The one diagnostic of a source that fails
+    diagnostic only_error(const std::string_view source, std::string &argument)
+    {
+        const auto result = assemble(source);
+        EXPECT_EQ(result.exit_code, EXIT_FAILURE);
+        EXPECT_EQ(result.diagnostics.size(), 1u) << result.report();
+        if (result.diagnostics.empty()) return {};
+        argument = result.diagnostics.argument(*result.diagnostics.begin());
+        return *result.diagnostics.begin();
+    }
+}
+
+
+TEST(parser, keeps_the_tokens_in_source_order)
+{
+    const auto tokens = parsed("; header\nstart: LDA #$01 ; load\n  STA $0200\nend:\n");
+    ASSERT_EQ(tokens.size(), 4u);
+
+    // The label shares its row with the command after it
+    EXPECT_EQ(tokens[0].kind(), st_kind::LABEL);
+    EXPECT_EQ(tokens[0].row(), 2u);
+    EXPECT_EQ(tokens[1].kind(), st_kind::OPCODE);
+    EXPECT_EQ(tokens[1].command(), st_command::LDA_imm);
+    EXPECT_EQ(tokens[1].number(), 0x01);
+    EXPECT_EQ(tokens[1].row(), 2u);
+    EXPECT_EQ(tokens[2].command(), st_command::STA_abs);
+    EXPECT_EQ(tokens[2].number(), 0x0200);
+    EXPECT_EQ(tokens[2].row(), 3u);
+    EXPECT_EQ(tokens[3].kind(), st_kind::LABEL);
+    EXPECT_EQ(tokens[3].row(), 4u);
+}
+
+TEST(parser, reads_byte_lines_and_code_positions)
+{
+    const auto tokens = parsed("*=$0700\n.byte $01, \"AB\"\n.word $1234\n");
+    ASSERT_EQ(tokens.size(), 3u);
+    EXPECT_EQ(tokens[0].kind(), st_kind::CODE_POS);
+    EXPECT_EQ(tokens[0].number(), 0x0700);
+    EXPECT_EQ(tokens[1].kind(), st_kind::BYTE);
+    EXPECT_EQ(tokens[1].byteline(), (std::vector<word_t>{0x01, 'A', 'B'}));
+    EXPECT_EQ(tokens[2].kind(), st_kind::WORD);
+    EXPECT_EQ(tokens[2].byteline(), (std::vector<word_t>{0x1234}));
+}
+
+TEST(parser, keeps_the_rows_of_a_long_program)
+{
+    // Enough rows for every token vector to grow many times over
+    std::string text;
+    for (int i = 0; i < 5000; ++i) {
+        text.append("l").append(std::to_string(i)).append(": LDX #").append(std::to_string(i % 256)).append(" ; row\n");
+    }
+    const auto tokens = parsed(text);
+    ASSERT_EQ(tokens.size(), 10000u);
+    for (std::size_t i = 0; i < 5000; ++i) {
+        ASSERT_EQ(tokens[2 * i].kind(), st_kind::LABEL);
+        ASSERT_EQ(tokens[2 * i].row(), i + 1);
+        ASSERT_EQ(tokens[2 * i + 1].command(), st_command::LDX_imm);
+        ASSERT_EQ(tokens[2 * i + 1].number(), i % 256);
+        ASSERT_EQ(tokens[2 * i + 1].row(), i + 1);
+    }
+}
+
+TEST(parser, replaces_macros_defined_after_their_use)
+{
+    const auto bytes = assembled("LDA #value\nSTA pointer\nJMP target\n"
+                                 ".define value $2A\n.define pointer $10\n.define target $1234\n");
+    // The one-byte macro is a zero page address, the row is parsed again once it is known
+    EXPECT_EQ(std::vector<byte_t>(bytes.begin(), bytes.begin() + 7),
+              (std::vector<byte_t>{0xA9, 0x2A, 0x85, 0x10, 0x4C, 0x34, 0x12}));
+}
+
+TEST(parser, resolves_labels_declared_after_their_use)
+{
+    const auto bytes = assembled("JMP end\nBNE end\nNOP\nend:\nBRK\n");
+    EXPECT_EQ(std::vector<byte_t>(bytes.begin(), bytes.begin() + 7),
+              (std::vector<byte_t>{0x4C, 0x06, 0x06, 0xD0, 0x01, 0xEA, 0x00}));
+}
+
+TEST(parser, reports_a_label_that_is_never_declared)
+{
+    std::string argument;
+    const auto error = only_error("NOP\nJMP nowhere\n", argument);
+    EXPECT_EQ(error.code, diagnostic_code::UNDECLARED_LABEL);
+    EXPECT_EQ(error.row, 2u);
+    EXPECT_EQ(argument, "nowhere");
+}
+
+TEST(parser, reports_a_name_declared_twice)
+{
+    std::string argument;
+    EXPECT_EQ(only_error("twice:\nNOP\ntwice:\n", argument).code, diagnostic_code::REPEATED_LABEL);
+    EXPECT_EQ(only_error(".define twice $01\n.define TWICE $02\n", argument).code, diagnostic_code::REPEATED_MACRO);
+}
@@ -0,0 +1,100 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |       Perfect Hash Tests      |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <cctype>
+
+#include <gtest/gtest.h>
+
+#include "../include/perfect_hash.hpp"
+#include "../include/parser_token.hpp"
+
+using namespace mxasm;
+using pt_opcode    = parser_token::pt_opcode;
+using pt_directive = parser_token::pt_directive;
+
+
+namespace
+{
+    constexpr perfect_hash<int, 3, 3> colors
+    {{{
+        { "RED", 1 }, { "GREEN", 2 }, { "BLUE", 3 }
+    }}};
+
+    static_assert(*colors.find("green") == 2, "The table is built and searched at compile time");
+
+    // Every mix of upper and lower case letters of the name
+    std::vector<std::string> case_variants(const std::string &name)
+    {
+        std::vector<std::string> variants;
+        for (unsigned mask = 0; mask < (1u << name.length()); ++mask) {
+            std::string variant = name;
+            for (std::size_t i = 0; i < name.length(); ++i) {
+                if (mask & (1u << i)) variant[i] = static_cast<char>(std::tolower(variant[i]));
+            }
+            variants.push_back(variant);
+        }
+        return variants;
+    }
+}
+
+
+TEST(perfect_hash, packs_keywords_case_insensitively)
+{
+    EXPECT_EQ(pack_keyword("lda"), pack_keyword("LDA"));
+    EXPECT_EQ(pack_keyword("A"), 0x41u);
+    EXPECT_NE(pack_keyword("LDA"), pack_keyword("LDA_"));
+    // Too long or empty names are no keyword at all
+    EXPECT_EQ(pack_keyword(""), 0u);
+    EXPECT_EQ(pack_keyword("ABCDEFGHI"), 0u);
+}
+
+TEST(perfect_hash, finds_only_its_own_keywords)
+{
+    EXPECT_EQ(*colors.find("RED"), 1);
+    EXPECT_EQ(*colors.find("Blue"), 3);
+    EXPECT_EQ(colors.find("REDS"), nullptr);
+    EXPECT_EQ(colors.find("RE"), nullptr);
+    EXPECT_EQ(colors.find(""), nullptr);
+    EXPECT_EQ(colors.at(1).name, "GREEN");
+}
+
+TEST(perfect_hash, finds_every_mnemonic_and_register_in_any_case)
+{
+    std::vector<std::pair<std::string, pt_opcode>> keywords {
+        {"X", pt_opcode::REGISTER_X}, {"Y", pt_opcode::REGISTER_Y}, {"A", pt_opcode::REGISTER_A}};
+    for (std::size_t i = 0; i < static_cast<std::size_t>(pt_opcode::REGISTER_X); ++i) {
+        const auto opcode = static_cast<pt_opcode>(i);
+        keywords.emplace_back(parser_token::pt_opcode_to_string(opcode), opcode);
+    }
+
+    for (const auto &[name, opcode] : keywords) {
+        for (const auto &variant : case_variants(name)) {
+            ASSERT_TRUE(parser_token::is_opcode_or_register(variant)) << variant;
+            ASSERT_EQ(parser_token::get_opcode_by_name(variant), opcode) << variant;
+        }
+    }
+}
+
+TEST(perfect_hash, finds_every_directive_in_any_case)
+{
+    for (const auto directive : {pt_directive::MACRO, pt_directive::BYTE, pt_directive::WORD, pt_directive::INCBIN}) {
+        for (const auto &variant : case_variants(parser_token::pt_directive_to_string(directive))) {
+            ASSERT_TRUE(parser_token::is_directive(variant)) << variant;
+            ASSERT_EQ(parser_token::get_directive_by_name(variant), directive) << variant;
+        }
+    }
+}
+
+TEST(perfect_hash, rejects_names_next_to_the_keywords)
+{
+    for (const std::string_view name : {"", "LD", "LDAA", "BBR8", "SMB", "B", "ADC ", "JMPJMPJMP", "label", "_"}) {
+        EXPECT_FALSE(parser_token::is_opcode_or_register(name)) << name;
+    }
+    for (const std::string_view name : {"", "DEF", "BYTES", "WORDS", "INC", "CODE POSITION"}) {
+        EXPECT_FALSE(parser_token::is_directive(name)) << name;
+    }
+}
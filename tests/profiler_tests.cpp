@@ -0,0 +1,106 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |         Profiler Tests        |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <fstream>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "../include/assembler.hpp"
+#include "../include/runner.hpp"
+#include "test_support.hpp"
+
+using namespace mxasm;
+
+
+namespace
+{
+    // 2 + 3 * (6 + 2 + 3) - 1 + 7 cycles in the main code, 3 * (2 + 6) in the subroutine
+    constexpr std::string_view PROGRAM =
+        "start:\n"
+        "    LDX #$03\n"
+        "loop:\n"
+        "    JSR work\n"
+        "    DEX\n"
+        "    BNE loop\n"
+        "    BRK\n"
+        "work:\n"
+        "    NOP\n"
+        "    RTS\n";
+}
+
+
+TEST(profiler, counts_cycles_by_label_and_row)
+{
+    const test::temporary_directory directory;
+    const auto source = directory.write("main.asm", PROGRAM);
+    const auto stacks = (directory.path() / "stacks.txt").string();
+
+    source_map map;
+    const auto result = assemble_file(source, pipeline_options{}, nullptr, &map);
+    ASSERT_EQ(result.exit_code, EXIT_SUCCESS) << result.report();
+
+    run_options options;
+    options.clock_hz    = 0;
+    options.seed        = 1;
+    options.profile     = true;
+    options.stacks_path = stacks;
+    testing::internal::CaptureStdout();
+    EXPECT_EQ(run_program(result.image, options, &map), EXIT_SUCCESS);
+    const auto output = testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(output,
+              "Stopped by BRK at $0608 after 65 cycles\n"
+              "A=$00 X=$00 Y=$00 SP=$FF P=$32 PC=$0609\n"
+              "\n"
+              "Flat profile: 65 cycles in 17 commands\n"
+              "\n"
+              "   self cycles       %  total cycles       %     commands  label\n"
+              "            39  60.00%            63  96.92%           10  loop\n"
+              "            24  36.92%            24  36.92%            6  work\n"
+              "             2   3.08%             2   3.08%            1  start\n"
+              "\n"
+              "        cycles       %     commands    row  source\n"
+              "            18  27.69%            3      4      JSR work\n"
+              "            18  27.69%            3     10      RTS\n"
+              "             8  12.31%            3      6      BNE loop\n"
+              "             7  10.77%            1      7      BRK\n"
+              "             6   9.23%            3      5      DEX\n"
+              "             6   9.23%            3      9      NOP\n"
+              "             2   3.08%            1      2      LDX #$03\n");
+
+    std::ifstream collapsed(stacks);
+    std::stringstream text;
+    text << collapsed.rdbuf();
+    EXPECT_EQ(text.str(), "start 2\nloop 39\nloop;work 24\n");
+}
+
+TEST(profiler, nests_the_callers_of_a_subroutine)
+{
+    const test::temporary_directory directory;
+    const auto source = directory.write("main.asm",
+                                        "main:\n    JSR outer\n    BRK\n"
+                                        "outer:\n    JSR inner\n    RTS\n"
+                                        "inner:\n    RTS\n");
+    const auto stacks = (directory.path() / "stacks.txt").string();
+
+    source_map map;
+    const auto result = assemble_file(source, pipeline_options{}, nullptr, &map);
+    ASSERT_EQ(result.exit_code, EXIT_SUCCESS) << result.report();
+
+    run_options options;
+    options.clock_hz    = 0;
+    options.stacks_path = stacks;
+    testing::internal::CaptureStdout();
+    EXPECT_EQ(run_program(result.image, options, &map), EXIT_SUCCESS);
+    testing::internal::GetCapturedStdout();
+
+    std::ifstream collapsed(stacks);
+    std::stringstream text;
+    text << collapsed.rdbuf();
+    EXPECT_EQ(text.str(), "main 13\nmain;outer 12\nmain;outer;inner 6\n");
+}
@@ -0,0 +1,56 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |    Program Generator Tests    |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "../bench/program_generator.hpp"
+#include "../include/assembler.hpp"
+
+using namespace mxasm;
+using bench::program_mix;
+using bench::generate_program;
+
+
+TEST(program_generator, writes_the_lines_asked_for)
+{
+    for (const std::size_t lines : {1u, 2u, 100u, 5000u}) {
+        const auto program = generate_program(lines, program_mix{});
+        EXPECT_EQ(static_cast<std::size_t>(std::count(program.begin(), program.end(), '\n')), lines);
+    }
+    EXPECT_TRUE(generate_program(0, program_mix{}).empty());
+}
+
+TEST(program_generator, repeats_a_program_for_its_seed)
+{
+    program_mix mix;
+    EXPECT_EQ(generate_program(1000, mix), generate_program(1000, mix));
+    mix.seed = 2;
+    EXPECT_NE(generate_program(1000, mix), generate_program(1000, program_mix{}));
+}
+
+TEST(program_generator, writes_programs_that_assemble)
+{
+    std::vector<program_mix> mixes {program_mix{}, {0, 0, 0, 0, 3}, {40, 20, 20, 20, 4}, {5, 5, 5, 60, 5}};
+    for (const auto &mix : mixes) {
+        // Past one origin block, so the code position starts over
+        const auto result = assemble(generate_program(10'000, mix));
+        EXPECT_EQ(result.exit_code, EXIT_SUCCESS) << "seed " << mix.seed << '\n' << result.report();
+    }
+}
+
+TEST(program_generator, follows_the_mix)
+{
+    const auto plain = generate_program(1000, {0, 0, 0, 0, 1});
+    EXPECT_EQ(plain.find(':'), std::string::npos);
+    EXPECT_EQ(plain.find(".define"), std::string::npos);
+    EXPECT_EQ(plain.find(".byte"), std::string::npos);
+
+    const auto labels = generate_program(1000, {100, 0, 0, 0, 1});
+    EXPECT_EQ(std::count(labels.begin(), labels.end(), ':'), 999);
+}
@@ -0,0 +1,109 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |      Program Writer Tests     |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <filesystem>
+
+#include <gtest/gtest.h>
+
+#include "../include/program_writer.hpp"
+#include "../include/exceptions/mxasm_exception.hpp"
+#include "test_support.hpp"
+
+using namespace mxasm;
+
+
+namespace
+{
+    // A run across a page border, a gap of more than a page, then a single byte
+    memory_image gapped_program()
+    {
+        memory_image program;
+        const std::vector<byte_t> run {0x01, 0x02, 0x03, 0x04};
+        program.write(0x06FE, run);
+        program.write(0x0900, 0xFF);
+        return program;
+    }
+
+    std::string gapped_file()
+    {
+        std::string file(0x0900 - 0x06FE + 1, '\0');
+        file.replace(0, 4, "\x01\x02\x03\x04");
+        file.back() = '\xFF';
+        return file;
+    }
+
+    std::vector<write_options> every_write_mode()
+    {
+        std::vector<write_options> modes;
+        for (const bool atomic : {false, true}) {
+            for (const auto sync : {sync_policy::NONE, sync_policy::FSYNC, sync_policy::DIRECT}) {
+                modes.push_back({atomic, sync, false});
+            }
+        }
+        return modes;
+    }
+
+    std::string mode_name(const write_options &options)
+    {
+        return std::string(options.atomic ? "atomic" : "in place") + ", sync " +
+               std::to_string(static_cast<int>(options.sync));
+    }
+}
+
+
+TEST(program_writer, lays_out_segments_from_the_lowest_address)
+{
+    for (const auto &options : every_write_mode()) {
+        const test::temporary_directory directory;
+        const auto binary = (directory.path() / "program.bin").string();
+        write_program_to_file(gapped_program(), binary, options);
+        EXPECT_TRUE(test::read_file(binary) == gapped_file()) << mode_name(options);
+    }
+}
+
+TEST(program_writer, replaces_a_longer_file)
+{
+    for (const auto &options : every_write_mode()) {
+        const test::temporary_directory directory;
+        const auto binary = directory.write("program.bin", std::string(0x2000, 'x'));
+        write_program_to_file(gapped_program(), binary, options);
+        EXPECT_TRUE(test::read_file(binary) == gapped_file()) << mode_name(options);
+    }
+}
+
+TEST(program_writer, leaves_no_temporary_file_behind)
+{
+    const test::temporary_directory directory;
+    const auto binary = (directory.path() / "program.bin").string();
+    write_program_to_file(gapped_program(), binary, {true, sync_policy::FSYNC, false});
+
+    std::vector<std::string> names;
+    for (const auto &entry : std::filesystem::directory_iterator(directory.path())) {
+        names.push_back(entry.path().filename().string());
+    }
+    EXPECT_EQ(names, (std::vector<std::string>{"program.bin"}));
+}
+
+TEST(program_writer, writes_an_empty_program_as_an_empty_file)
+{
+    for (const auto &options : every_write_mode()) {
+        const test::temporary_directory directory;
+        const auto binary = directory.write("program.bin", "old");
+        write_program_to_file(memory_image{}, binary, options);
+        EXPECT_TRUE(std::filesystem::exists(binary)) << mode_name(options);
+        EXPECT_EQ(std::filesystem::file_size(binary), 0u) << mode_name(options);
+    }
+}
+
+TEST(program_writer, fails_in_a_missing_directory)
+{
+    const test::temporary_directory directory;
+    const auto binary = (directory.path() / "missing" / "program.bin").string();
+    for (const auto &options : every_write_mode()) {
+        EXPECT_THROW(write_program_to_file(gapped_program(), binary, options), mxasm_exception) << mode_name(options);
+    }
+}
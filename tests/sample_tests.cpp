@@ -0,0 +1,53 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |          Sample Tests         |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <gtest/gtest.h>
+
+#include "../include/assembler.hpp"
+#include "../include/program_writer.hpp"
+#include "test_support.hpp"
+
+#ifndef MXASM_SAMPLES_DIR
+#define MXASM_SAMPLES_DIR "cmake-build-debug"
+#endif
+
+using namespace mxasm;
+
+
+namespace
+{
+    // The reference binaries use absolute addressing for every label, as the
+    // assembler did before zero page promotion
+    void expect_reference_binary(const std::string &name)
+    {
+        pipeline_options pipeline;
+        pipeline.encoding.zero_page = false;
+        const auto result = assemble_file(MXASM_SAMPLES_DIR "/" + name + ".asm", pipeline);
+        ASSERT_EQ(result.exit_code, EXIT_SUCCESS) << result.report();
+
+        const test::temporary_directory directory;
+        const auto binary = (directory.path() / (name + ".bin")).string();
+        write_program_to_file(result.image, binary);
+
+        const auto reference = test::read_file(MXASM_SAMPLES_DIR "/" + name + ".bin");
+        ASSERT_FALSE(reference.empty());
+        EXPECT_TRUE(test::read_file(binary) == reference) << name;
+    }
+}
+
+
+TEST(samples, adventure_matches_its_reference_binary)
+{ expect_reference_binary("s_adventure"); }
+
+TEST(samples, sft_matches_its_reference_binary)
+{ expect_reference_binary("s_sft"); }
+
+TEST(samples, snake_matches_its_reference_binary)
+{ expect_reference_binary("s_snake"); }
+
+TEST(samples, software_matches_its_reference_binary)
+{ expect_reference_binary("s_software"); }
@@ -0,0 +1,84 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |         Scanner Tests         |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <functional>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "../include/scanner.hpp"
+
+using namespace mxasm;
+
+
+namespace
+{
+    typedef const char *(*scan_function)(const char *begin, const char *end) noexcept;
+
+    bool is_space(const char c)
+    { return c == ' ' or c == '\t' or c == '\r' or c == '\n'; }
+
+    bool is_identifier(const char c)
+    { return (c >= '0' and c <= '9') or (c >= 'a' and c <= 'z') or (c >= 'A' and c <= 'Z') or c == '_'; }
+
+    bool is_not_zero(const char c)
+    { return c != '\0'; }
+
+    // Runs of every length up to past two AVX2 blocks, at unaligned starts, ended by every byte value
+    // or by the end of the range. The scanner has to stop where the character test fails first
+    void expect_scan_matches(const scan_function scan, const std::function<bool(char)> &in_run, const char fill)
+    {
+        for (int stop = 0; stop < 0x100; ++stop) {
+            for (std::size_t offset = 0; offset < 4; ++offset) {
+                for (std::size_t length = 0; length <= 70; ++length) {
+                    std::string buffer(offset + length + 1, fill);
+                    buffer[offset + length] = static_cast<char>(stop);
+                    const char *begin = buffer.data() + offset;
+                    const char *end   = buffer.data() + buffer.size();
+
+                    const std::size_t expected = in_run(static_cast<char>(stop)) ? length + 1 : length;
+                    ASSERT_EQ(static_cast<std::size_t>(scan(begin, end) - begin), expected)
+                        << scanner_instruction_set() << ": stop " << stop << ", offset " << offset
+                        << ", length " << length;
+                    ASSERT_EQ(scan(begin, begin + length), begin + length);
+                }
+            }
+        }
+    }
+}
+
+
+TEST(scanner, names_its_instruction_set)
+{
+    const std::string instruction_set = scanner_instruction_set();
+    EXPECT_TRUE(instruction_set == "AVX2" or instruction_set == "SSE2" or instruction_set == "scalar")
+        << instruction_set;
+}
+
+TEST(scanner, scans_spaces_like_the_scalar_test)
+{
+    expect_scan_matches(scan_spaces, is_space, '\t');
+}
+
+TEST(scanner, scans_identifiers_like_the_scalar_test)
+{
+    expect_scan_matches(scan_identifier, is_identifier, 'z');
+    expect_scan_matches(scan_identifier, is_identifier, '_');
+}
+
+TEST(scanner, scans_line_ends_like_the_scalar_test)
+{
+    expect_scan_matches(scan_line_end, is_not_zero, '\xFF');
+}
+
+TEST(scanner, scans_an_empty_range)
+{
+    const char text[] = " ";
+    EXPECT_EQ(scan_spaces(text, text), text);
+    EXPECT_EQ(scan_identifier(text, text), text);
+    EXPECT_EQ(scan_line_end(text, text), text);
+}
@@ -0,0 +1,169 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |        Serializer Tests       |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <gtest/gtest.h>
+
+#include "../include/assembler.hpp"
+
+using namespace mxasm;
+
+
+namespace
+{
+    // Variables in the zero page, code at the usual start
+    constexpr std::string_view ZERO_PAGE_VARIABLES = "*=$10\nvar:\n*=$20\nptr:\n*=$0600\n";
+
+    pipeline_options shrinking_jumps()
+    {
+        pipeline_options pipeline;
+        pipeline.encoding.shrink_jumps = true;
+        return pipeline;
+    }
+
+    std::vector<byte_t> assembled(const std::string &source, const pipeline_options &pipeline = {})
+    {
+        const auto result = assemble(source, pipeline);
+        EXPECT_EQ(result.exit_code, EXIT_SUCCESS) << result.report();
+        const auto segments = result.image.segments();
+        return segments.empty() ? std::vector<byte_t>{} : result.image.bytes(segments.back());
+    }
+}
+
+
+TEST(zero_page, promotes_absolute_label_operands)
+{
+    const auto bytes = assembled(std::string(ZERO_PAGE_VARIABLES) + "LDA var\nBRK\n");
+    EXPECT_EQ(bytes, (std::vector<byte_t>{0xA5, 0x10, 0x00}));
+}
+
+TEST(zero_page, promotes_indexed_label_operands)
+{
+    const auto bytes = assembled(std::string(ZERO_PAGE_VARIABLES) + "STA var,X\nLDX var,Y\nLDA var,Y\nBRK\n");
+    // LDA has no zero page form indexed by Y
+    EXPECT_EQ(bytes, (std::vector<byte_t>{0x95, 0x10, 0xB6, 0x10, 0xB9, 0x10, 0x00, 0x00}));
+}
+
+TEST(zero_page, keeps_labels_past_the_zero_page_absolute)
+{
+    const auto bytes = assembled("LDA var\nBRK\nvar:\n");
+    EXPECT_EQ(bytes, (std::vector<byte_t>{0xAD, 0x04, 0x06, 0x00}));
+}
+
+TEST(zero_page, demotes_a_label_pushed_out_by_a_long_branch)
+{
+    // The first layout has var at $FF. The branch out of reach then grows by three bytes
+    // and the promoted LDA by one back, which puts var at $102
+    const auto result = assemble("*=$FA\nBNE far\nLDA var\nvar:\n*=$0300\nfar:\nBRK\n");
+    ASSERT_EQ(result.exit_code, EXIT_SUCCESS) << result.report();
+    EXPECT_EQ(result.image.bytes({0x00FA, 8}), (std::vector<byte_t>{0xF0, 0x03, 0x4C, 0x00, 0x03, 0xAD, 0x02, 0x01}));
+}
+
+TEST(zero_page, turns_label_pointers_into_zero_page_indirect_commands)
+{
+    const auto bytes = assembled(std::string(ZERO_PAGE_VARIABLES) + "LDA (ptr)\nLDA (ptr),Y\nLDA (ptr,X)\nJMP (ptr)\n");
+    // JMP has no zero page indirect form
+    EXPECT_EQ(bytes, (std::vector<byte_t>{0xB2, 0x20, 0xB1, 0x20, 0xA1, 0x20, 0x6C, 0x20, 0x00}));
+}
+
+TEST(zero_page, rejects_a_label_pointer_past_the_zero_page)
+{
+    const auto result = assemble("LDA (ptr),Y\nptr:\n");
+    ASSERT_EQ(result.exit_code, EXIT_FAILURE);
+    ASSERT_EQ(result.diagnostics.size(), 1u);
+    const auto &error = *result.diagnostics.begin();
+    EXPECT_EQ(error.code, diagnostic_code::ZERO_PAGE_EXPECTED);
+    EXPECT_EQ(error.row, 1u);
+    EXPECT_EQ(result.diagnostics.argument(error), "$0602");
+}
+
+TEST(zero_page, can_be_turned_off)
+{
+    pipeline_options pipeline;
+    pipeline.encoding.zero_page = false;
+    const auto bytes = assembled(std::string(ZERO_PAGE_VARIABLES) + "LDA var\nSTA var,X\nLDA (ptr),Y\n", pipeline);
+    // Pointers have no absolute form, they stay in the zero page
+    EXPECT_EQ(bytes, (std::vector<byte_t>{0xAD, 0x10, 0x00, 0x9D, 0x10, 0x00, 0xB1, 0x20}));
+}
+
+
+TEST(relax, keeps_jumps_as_written)
+{
+    const auto bytes = assembled("JMP next\nNOP\nnext:\nBRK\n");
+    EXPECT_EQ(bytes, (std::vector<byte_t>{0x4C, 0x04, 0x06, 0xEA, 0x00}));
+}
+
+TEST(relax, turns_a_jump_within_the_page_into_a_branch)
+{
+    const auto bytes = assembled("JMP next\nNOP\nnext:\nBRK\n", shrinking_jumps());
+    EXPECT_EQ(bytes, (std::vector<byte_t>{0x80, 0x01, 0xEA, 0x00}));
+}
+
+TEST(relax, keeps_a_jump_to_another_page)
+{
+    // Within reach, but a taken BRA across the page costs a cycle more than the JMP
+    const auto bytes = assembled("*=$06FC\nJMP next\nNOP\nnext:\nBRK\n", shrinking_jumps());
+    EXPECT_EQ(bytes, (std::vector<byte_t>{0x4C, 0x00, 0x07, 0xEA, 0x00}));
+}
+
+TEST(relax, grows_a_branch_back_into_a_jump)
+{
+    // The first layout has next at $06FE, on the page of the JMP. The long branch then moves it
+    // to the next page, and the BRA turns back into a JMP for good
+    std::string source = "*=$06F0\nJMP next\nBNE far\n";
+    for (int i = 0; i < 9; ++i) source += "NOP\n";
+    const auto result = assemble(source + "next:\nBRK\n*=$0300\nfar:\nBRK\n", shrinking_jumps());
+    ASSERT_EQ(result.exit_code, EXIT_SUCCESS) << result.report();
+    EXPECT_EQ(result.image.bytes({0x06F0, 8}), (std::vector<byte_t>{0x4C, 0x01, 0x07, 0xF0, 0x03, 0x4C, 0x00, 0x03}));
+    EXPECT_EQ(result.image.read(0x0701), 0x00);
+}
+
+TEST(relax, writes_a_long_branch_as_the_opposite_branch_over_a_jump)
+{
+    const auto result = assemble("BEQ far\nBBR0 $10, far\n*=$0700\nfar:\nBRK\n");
+    ASSERT_EQ(result.exit_code, EXIT_SUCCESS) << result.report();
+    EXPECT_EQ(result.image.bytes({0x0600, 11}), (std::vector<byte_t>{0xD0, 0x03, 0x4C, 0x00, 0x07,
+                                                                     0x8F, 0x10, 0x03, 0x4C, 0x00, 0x07}));
+}
+
+TEST(relax, turns_a_branch_always_out_of_reach_into_a_jump)
+{
+    const auto result = assemble("BRA far\n*=$0700\nfar:\nBRK\n");
+    ASSERT_EQ(result.exit_code, EXIT_SUCCESS) << result.report();
+    EXPECT_EQ(result.image.bytes({0x0600, 3}), (std::vector<byte_t>{0x4C, 0x00, 0x07}));
+}
+
+TEST(relax, can_be_turned_off)
+{
+    pipeline_options pipeline;
+    pipeline.encoding.relax = false;
+    const auto result = assemble("BEQ far\n*=$0700\nfar:\nBRK\n", pipeline);
+    ASSERT_EQ(result.exit_code, EXIT_FAILURE);
+    ASSERT_EQ(result.diagnostics.size(), 1u);
+    const auto &error = *result.diagnostics.begin();
+    EXPECT_EQ(error.code, diagnostic_code::BRANCH_OUT_OF_REACH);
+    EXPECT_EQ(result.diagnostics.argument(error), "254");
+}
+
+
+TEST(labels, patch_absolute_operands_before_and_after_their_declaration)
+{
+    const auto bytes = assembled("back:\nJMP ahead\nJSR back\nahead:\nBRK\n");
+    EXPECT_EQ(bytes, (std::vector<byte_t>{0x4C, 0x06, 0x06, 0x20, 0x00, 0x06, 0x00}));
+}
+
+TEST(labels, patch_branch_offsets_both_ways)
+{
+    const auto bytes = assembled("back:\nNOP\nBNE back\nBEQ ahead\nNOP\nahead:\nBRK\n");
+    EXPECT_EQ(bytes, (std::vector<byte_t>{0xEA, 0xD0, 0xFD, 0xF0, 0x01, 0xEA, 0x00}));
+}
+
+TEST(labels, patch_low_and_high_bytes_of_immediates)
+{
+    const auto result = assemble("LDA #<data\nLDX #>data\n*=$1234\ndata:\nBRK\n");
+    ASSERT_EQ(result.exit_code, EXIT_SUCCESS) << result.report();
+    EXPECT_EQ(result.image.bytes({0x0600, 4}), (std::vector<byte_t>{0xA9, 0x34, 0xA2, 0x12}));
+}
@@ -0,0 +1,143 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |          Server Tests         |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "../include/server.hpp"
+#include "../include/file_descriptor.hpp"
+#include "../include/util.hpp"
+#include "../include/exceptions/mxasm_exception.hpp"
+#include "test_support.hpp"
+
+using namespace mxasm;
+
+
+namespace
+{
+    // Raw connection to the server, for requests the client API doesn't send
+    class raw_client
+    {
+    public:
+        explicit raw_client(const std::string &socket_path)
+            : m_socket(socket(AF_UNIX, SOCK_STREAM, 0))
+        {
+            sockaddr_un address {};
+            address.sun_family = AF_UNIX;
+            std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+            m_connected = connect(m_socket.get(), reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == 0;
+        }
+
+        bool connected() const noexcept
+        { return m_connected; }
+
+        void send(const std::string_view payload) const
+        {
+            std::string message;
+            append_u32(message, static_cast<uint32_t>(payload.size()));
+            message += payload;
+            ASSERT_EQ(write(m_socket.get(), message.data(), message.size()), static_cast<ssize_t>(message.size()));
+        }
+
+        std::optional<assembly_result> receive() const
+        {
+            char header[4];
+            if (recv(m_socket.get(), header, sizeof(header), MSG_WAITALL) != sizeof(header)) return std::nullopt;
+            std::string payload(read_u32(header), '\0');
+            if (recv(m_socket.get(), payload.data(), payload.size(), MSG_WAITALL) != static_cast<ssize_t>(payload.size())) {
+                return std::nullopt;
+            }
+            return decode_result(payload);
+        }
+
+    private:
+        file_descriptor m_socket;
+        bool            m_connected {false};
+    };
+
+    // Server on a socket of its own, stopped with a 'Q' request
+    class test_server
+    {
+    public:
+        explicit test_server(const test::temporary_directory &directory)
+            : m_socket_path {(directory.path() / "mxasm.sock").string()},
+              m_thread {[this] { m_exit_code = run_server(m_socket_path, pipeline_options{}); }}
+        {
+            for (int i = 0; i < 500 and not raw_client(m_socket_path).connected(); ++i) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+
+        ~test_server()
+        {
+            raw_client(m_socket_path).send("Q");
+            m_thread.join();
+        }
+
+        const std::string &socket_path() const noexcept
+        { return m_socket_path; }
+
+    private:
+        std::string m_socket_path;
+        int         m_exit_code {EXIT_FAILURE};
+        std::thread m_thread;
+    };
+}
+
+
+TEST(server, assembles_files_for_a_client)
+{
+    const test::temporary_directory directory;
+    const auto good = directory.write("good.asm", "LDA #$01\nBRK\n");
+    const auto bad  = directory.write("bad.asm", "LDA #$01,\n");
+    const test_server server(directory);
+
+    const auto results = request_assembly(server.socket_path(), {good, bad, good});
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_EQ(results[0].exit_code, EXIT_SUCCESS);
+    EXPECT_EQ(results[0].image.bytes({0x0600, 3}), (std::vector<byte_t>{0xA9, 0x01, 0x00}));
+    EXPECT_EQ(results[1].exit_code, EXIT_FAILURE);
+    EXPECT_FALSE(results[1].diagnostics.empty());
+    EXPECT_EQ(results[2].image.bytes({0x0600, 3}), results[0].image.bytes({0x0600, 3}));
+}
+
+TEST(server, assembles_source_text)
+{
+    const test::temporary_directory directory;
+    const test_server server(directory);
+
+    const raw_client client(server.socket_path());
+    client.send("TNOP\nBRK\n");
+    const auto result = client.receive();
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->exit_code, EXIT_SUCCESS);
+    EXPECT_EQ(result->image.bytes({0x0600, 2}), (std::vector<byte_t>{0xEA, 0x00}));
+}
+
+TEST(server, serves_a_client_while_another_one_is_idle)
+{
+    const test::temporary_directory directory;
+    const auto source = directory.write("main.asm", "BRK\n");
+    const test_server server(directory);
+
+    const raw_client idle(server.socket_path());
+    ASSERT_TRUE(idle.connected());
+    const auto results = request_assembly(server.socket_path(), {source});
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].exit_code, EXIT_SUCCESS);
+}
+
+TEST(server, fails_without_a_server)
+{
+    const test::temporary_directory directory;
+    EXPECT_THROW(request_assembly((directory.path() / "none.sock").string(), {"a.asm"}), mxasm_exception);
+}
@@ -0,0 +1,105 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |       Source File Tests       |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <fstream>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+
+#include "../include/source_file.hpp"
+#include "../include/exceptions/mxasm_exception.hpp"
+#include "test_support.hpp"
+
+using namespace mxasm;
+
+
+namespace
+{
+    constexpr std::string_view PROGRAM = "start:\n\n  LDA #$01\n   \nBRK";
+
+    // Line numbers and texts, blank lines are left out
+    void expect_program_lines(const source_file &source)
+    {
+        const auto &lines = source.lines();
+        ASSERT_EQ(lines.size(), 3u);
+        EXPECT_EQ(lines[0].number, 1u);
+        EXPECT_EQ(lines[0].text, "start:");
+        EXPECT_EQ(lines[1].number, 3u);
+        EXPECT_EQ(lines[1].text, "  LDA #$01");
+        EXPECT_EQ(lines[2].number, 5u);
+        EXPECT_EQ(lines[2].text, "BRK");
+        EXPECT_EQ(source.line_offsets(), (std::vector<std::size_t>{0, 7, 8, 19, 23}));
+    }
+}
+
+
+TEST(source_file, maps_a_regular_file)
+{
+    const test::temporary_directory directory;
+    const source_file source(directory.write("main.asm", PROGRAM));
+    EXPECT_EQ(source.text(), PROGRAM);
+    expect_program_lines(source);
+}
+
+TEST(source_file, reads_an_empty_file)
+{
+    const test::temporary_directory directory;
+    const source_file source(directory.write("empty.asm", ""));
+    EXPECT_TRUE(source.text().empty());
+    EXPECT_TRUE(source.lines().empty());
+}
+
+TEST(source_file, reads_what_can_not_be_mapped)
+{
+    // A pipe has no size to map, it is read to its end instead
+    const test::temporary_directory directory;
+    const auto fifo = (directory.path() / "main.asm").string();
+    ASSERT_EQ(mkfifo(fifo.c_str(), 0600), 0);
+    std::thread writer([&fifo] { std::ofstream(fifo) << PROGRAM; });
+
+    const source_file source(fifo);
+    writer.join();
+    EXPECT_EQ(source.text(), PROGRAM);
+    expect_program_lines(source);
+}
+
+TEST(source_file, fails_on_a_missing_file)
+{
+    const test::temporary_directory directory;
+    EXPECT_THROW(source_file((directory.path() / "missing.asm").string()), mxasm_exception);
+}
+
+TEST(source_file, keeps_its_lines_through_a_move)
+{
+    // A short text lives inside the string object, so the views have to follow it
+    source_file moved = source_file::from_text(std::string(PROGRAM));
+    source_file target = std::move(moved);
+    EXPECT_EQ(target.text(), PROGRAM);
+    expect_program_lines(target);
+
+    const test::temporary_directory directory;
+    source_file mapped(directory.write("main.asm", PROGRAM));
+    target = std::move(mapped);
+    expect_program_lines(target);
+}
+
+TEST(source_file, views_text_of_the_caller)
+{
+    const std::string text(PROGRAM);
+    const auto source = source_file::from_view(text);
+    EXPECT_EQ(source.text().data(), text.data());
+    expect_program_lines(source);
+}
+
+TEST(source_file, leaves_binary_files_unsplit)
+{
+    const test::temporary_directory directory;
+    const auto source = source_file::binary(directory.write("data.bin", std::string("\x01\n\x00\n", 4)));
+    EXPECT_EQ(source.text().size(), 4u);
+    EXPECT_TRUE(source.lines().empty());
+}
@@ -0,0 +1,89 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |        Statistics Tests       |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <algorithm>
+#include <regex>
+
+#include <gtest/gtest.h>
+
+#include "../include/stats.hpp"
+#include "../include/assembler.hpp"
+
+using namespace mxasm;
+
+
+namespace
+{
+    // Stats with the phases given, each with a token count
+    assembly_stats measured(const std::vector<std::pair<std::string_view, std::size_t>> &phases)
+    {
+        assembly_stats stats;
+        for (const auto &[name, tokens] : phases) {
+            assembly_stats::timer timer(&stats, name);
+            timer.set_tokens(tokens);
+        }
+        return stats;
+    }
+
+    // Times and heap use differ from run to run, the rest of the document doesn't
+    std::string without_measurements(const std::string &json)
+    {
+        static const std::regex measurement(R"(("ms"|"allocations"|"allocated_bytes"): [0-9.]+)");
+        return std::regex_replace(json, measurement, "$1: _");
+    }
+}
+
+
+TEST(stats, writes_one_json_document_for_all_files)
+{
+    const std::vector<assembly_stats> stats {measured({{"lexer::tokenize", 12}, {"serializer::serialize", 4}}),
+                                             measured({})};
+    EXPECT_EQ(without_measurements(stats_to_json({"a.asm", "b.asm"}, stats)),
+              "{\"files\": [\n"
+              "  {\"path\": \"a.asm\", \"phases\": [\n"
+              "    {\"name\": \"lexer::tokenize\", \"ms\": _, \"tokens\": 12, \"allocations\": _, \"allocated_bytes\": _},\n"
+              "    {\"name\": \"serializer::serialize\", \"ms\": _, \"tokens\": 4, \"allocations\": _, \"allocated_bytes\": _}],\n"
+              "   \"total\": {\"name\": \"total\", \"ms\": _, \"tokens\": 0, \"allocations\": _, \"allocated_bytes\": _}},\n"
+              "  {\"path\": \"b.asm\", \"phases\": [],\n"
+              "   \"total\": {\"name\": \"total\", \"ms\": _, \"tokens\": 0, \"allocations\": _, \"allocated_bytes\": _}}\n"
+              "]}\n");
+}
+
+TEST(stats, writes_an_empty_file_list)
+{
+    EXPECT_EQ(stats_to_json({}, {}), "{\"files\": [\n]}\n");
+}
+
+TEST(stats, escapes_paths_for_json)
+{
+    const auto json = stats_to_json({"dir\\\"odd\"\n\x01.asm"}, {assembly_stats{}});
+    EXPECT_NE(json.find(R"("path": "dir\\\"odd\"\n\u0001.asm")"), std::string::npos) << json;
+}
+
+TEST(stats, sums_the_phases_into_the_total)
+{
+    const auto stats = measured({{"first", 1}, {"second", 2}});
+    double milliseconds = 0;
+    for (const auto &phase : stats.phases()) milliseconds += phase.milliseconds;
+    EXPECT_DOUBLE_EQ(stats.total().milliseconds, milliseconds);
+    EXPECT_EQ(stats.total().tokens, 0u);
+}
+
+TEST(stats, times_every_phase_of_an_assembly)
+{
+    assembly_stats stats;
+    ASSERT_EQ(assemble("LDA #$01\nBRK\n", {}, &stats).exit_code, EXIT_SUCCESS);
+
+    auto phase_named = [&stats](const std::string_view name) {
+        return std::find_if(stats.phases().begin(), stats.phases().end(),
+                            [name](const auto &phase) { return phase.name == name; });
+    };
+    const auto lexing = phase_named("lexer::tokenize");
+    ASSERT_NE(lexing, stats.phases().end());
+    EXPECT_EQ(lexing->tokens, 4u);
+    EXPECT_NE(phase_named("serializer::serialize"), stats.phases().end());
+}
@@ -0,0 +1,63 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |         Test Support          |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include <unistd.h>
+
+
+namespace mxasm::test
+{
+    // Fresh directory under the system temporary one, removed with everything in it
+    class temporary_directory
+    {
+    public:
+        temporary_directory()
+        {
+            static std::atomic<unsigned> counter {0};
+            m_path = std::filesystem::temp_directory_path()
+                   / ("mxasm_tests." + std::to_string(getpid()) + "." + std::to_string(counter++));
+            std::filesystem::create_directories(m_path);
+        }
+
+        temporary_directory(const temporary_directory &) = delete;
+        temporary_directory &operator=(const temporary_directory &) = delete;
+
+        ~temporary_directory()
+        {
+            std::error_code error;
+            std::filesystem::remove_all(m_path, error);
+        }
+
+        const std::filesystem::path &path() const noexcept
+        { return m_path; }
+
+        // Writes the file and returns its full path
+        std::string write(const std::string &name, const std::string_view contents) const
+        {
+            const auto file = m_path / name;
+            std::ofstream(file, std::ios_base::binary).write(contents.data(), static_cast<std::streamsize>(contents.size()));
+            return file.string();
+        }
+
+    private:
+        std::filesystem::path m_path;
+    };
+
+    // Whole file, empty when it can't be read
+    inline std::string read_file(const std::filesystem::path &file)
+    {
+        std::ifstream reader(file, std::ios_base::binary);
+        return {std::istreambuf_iterator<char>(reader), std::istreambuf_iterator<char>()};
+    }
+}
@@ -0,0 +1,70 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |       Thread Pool Tests       |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <atomic>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "../include/thread_pool.hpp"
+#include "../include/assembler.hpp"
+
+using namespace mxasm;
+
+
+TEST(thread_pool, runs_every_job_once)
+{
+    for (const std::size_t threads : {1u, 2u, 4u, 16u}) {
+        for (const std::size_t jobs : {0u, 1u, 3u, 100u}) {
+            std::vector<std::atomic<int>> runs(jobs);
+            thread_pool(threads).run(jobs, [&runs](const std::size_t job) { ++runs[job]; });
+            for (std::size_t i = 0; i < jobs; ++i) {
+                EXPECT_EQ(runs[i].load(), 1) << threads << " threads, job " << i << " of " << jobs;
+            }
+        }
+    }
+}
+
+TEST(thread_pool, has_at_least_one_thread)
+{
+    EXPECT_EQ(thread_pool(0).thread_count(), 1u);
+    EXPECT_EQ(thread_pool(8).thread_count(), 8u);
+}
+
+TEST(thread_pool, gives_the_same_results_as_one_thread)
+{
+    // Every job writes only its own slot, so the order the jobs ran in doesn't show
+    std::vector<std::string> sources;
+    for (int i = 0; i < 24; ++i) {
+        sources.push_back("LDA #" + std::to_string(i) + "\nloop:\nDEX\nBNE loop\nBRK\n");
+    }
+    auto assemble_all = [&sources](const std::size_t threads) {
+        std::vector<std::vector<byte_t>> binaries(sources.size());
+        thread_pool(threads).run(sources.size(), [&](const std::size_t job) {
+            binaries[job] = assemble(sources[job]).image.bytes({0x0600, 6});
+        });
+        return binaries;
+    };
+
+    const auto expected = assemble_all(1);
+    EXPECT_EQ(expected[5], (std::vector<byte_t>{0xA9, 0x05, 0xCA, 0xD0, 0xFD, 0x00}));
+    for (int round = 0; round < 10; ++round) {
+        EXPECT_EQ(assemble_all(4), expected);
+    }
+}
+
+TEST(thread_pool, rethrows_a_failed_job_after_the_others_ran)
+{
+    for (const std::size_t threads : {1u, 4u}) {
+        std::atomic<int> done {0};
+        EXPECT_THROW(thread_pool(threads).run(20, [&done](const std::size_t job) {
+            if (job == 7) throw std::runtime_error("job 7");
+            ++done;
+        }), std::runtime_error);
+        EXPECT_EQ(done.load(), 19) << threads << " threads";
+    }
+}
@@ -0,0 +1,77 @@
+/*-------------------------------*
+ |        MOlex Assembler        |
+ |          Utility Tests        |
+ |                               |
+ |       Author: MOlex-dev       |
+ *-------------------------------*/
+
+#include <charconv>
+#include <limits>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "../include/util.hpp"
+
+using namespace mxasm;
+
+
+namespace
+{
+    constexpr uint64_t TOO_BIG = std::numeric_limits<uint64_t>::max();
+
+    std::string digits_of(const uint64_t value, const int base)
+    {
+        char text[65];
+        const auto end = std::to_chars(text, text + sizeof(text), value, base).ptr;
+        return {text, end};
+    }
+}
+
+
+TEST(string_to_number, reads_hex_of_every_length)
+{
+    // Up to eight digits take the SWAR path, longer ones the loop
+    EXPECT_EQ(string_to_number("0", 16), 0u);
+    EXPECT_EQ(string_to_number("F", 16), 0xFu);
+    EXPECT_EQ(string_to_number("1234", 16), 0x1234u);
+    EXPECT_EQ(string_to_number("aBcDeF01", 16), 0xABCDEF01u);
+    EXPECT_EQ(string_to_number("123456789", 16), 0x123456789u);
+    EXPECT_EQ(string_to_number("FFFFFFFFFFFFFFFF", 16), TOO_BIG);
+}
+
+TEST(string_to_number, matches_from_chars_in_every_base)
+{
+    std::mt19937_64 random(7);
+    for (int i = 0; i < 10'000; ++i) {
+        // Every magnitude, not just the large values a uniform pick gives
+        const uint64_t value = random() >> (random() % 64);
+        for (const int base : {2, 8, 10, 16}) {
+            const auto text = digits_of(value, base);
+            ASSERT_EQ(string_to_number(text, static_cast<uint8_t>(base)), value) << text << " in base " << base;
+        }
+    }
+}
+
+TEST(string_to_number, skips_leading_zeros)
+{
+    EXPECT_EQ(string_to_number("00000000000000000000FF", 16), 0xFFu);
+    EXPECT_EQ(string_to_number("000000000000000000000000000000000000000000000000000000000000000000001", 2), 1u);
+    EXPECT_EQ(string_to_number("0000000000000000000000000017", 8), 017u);
+    EXPECT_EQ(string_to_number("000000000000000000000000255", 10), 255u);
+    EXPECT_EQ(string_to_number("0000", 16), 0u);
+    EXPECT_EQ(string_to_number("", 10), 0u);
+}
+
+TEST(string_to_number, saturates_past_64_bits)
+{
+    EXPECT_EQ(string_to_number("10000000000000000", 16), TOO_BIG);
+    EXPECT_EQ(string_to_number("1" + std::string(64, '0'), 2), TOO_BIG);
+    EXPECT_EQ(string_to_number("18446744073709551615", 10), TOO_BIG);
+    EXPECT_EQ(string_to_number("18446744073709551616", 10), TOO_BIG);
+    EXPECT_EQ(string_to_number("99999999999999999999999", 10), TOO_BIG);
+    EXPECT_EQ(string_to_number("18446744073709551614", 10), TOO_BIG - 1);
+    // The leading octal digit of a 64-bit value holds a single bit
+    EXPECT_EQ(string_to_number("1777777777777777777776", 8), TOO_BIG - 1);
+    EXPECT_EQ(string_to_number("2000000000000000000000", 8), TOO_BIG);
+}